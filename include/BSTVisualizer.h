@@ -21,7 +21,6 @@ private:
     };
 
     std::unique_ptr<TreeNode> m_root;
-    sf::Font m_font;
     Operation m_operation;
     std::string m_opName;
 
@@ -31,8 +30,6 @@ private:
     int m_targetValue;
     TreeNode* m_currentNode;
     TreeNode* m_parent;
-    sf::Clock m_clock;
-    float m_delay = 0.6f;
 
     // Helper methods
     void buildInitialTree();
@@ -45,12 +42,13 @@ private:
 
 
 public:
-    BSTVisualizer(sf::RenderWindow& window, Operation op, int value);
+    BSTVisualizer(sf::RenderWindow* window, Operation op, int value);
     ~BSTVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void drawTree(TreeNode* node);
     void draw() override;
     void reset() override;
+    void start() override;
 };
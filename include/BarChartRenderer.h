@@ -0,0 +1,72 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * @class BarChartRenderer
+ * @brief Draws a whole array as a bar chart with a single draw call.
+ *
+ * The bars live in one persistent quad buffer that is only resized when the
+ * number of columns changes. Highlight state is encoded in the per-vertex
+ * colors, so the sort visualizers never create per-bar shapes. When the array
+ * has more elements than the canvas has pixel columns, neighbouring elements
+ * are folded into one column (tallest value, highlighted color wins), which
+ * keeps the vertex count bounded by the canvas width.
+ */
+class BarChartRenderer {
+private:
+    sf::VertexArray m_vertices; // 4 vertices per column
+    sf::Color m_baseColor;      // Color of an element with no highlight
+
+    void resizeColumns(std::size_t columns);
+    void setColumn(std::size_t column, float x, float width, float height, float canvasHeight, sf::Color color);
+
+public:
+    BarChartRenderer();
+
+    // Elements drawn with this color are treated as "not highlighted" when folding.
+    void setBaseColor(sf::Color color) { m_baseColor = color; }
+
+    // Rebuilds the buffer from data; colorOf(k) returns the color of element k.
+    template <typename ColorFn>
+    void update(const std::vector<int>& data, sf::Vector2u canvasSize, ColorFn colorOf);
+
+    // Draws every bar in one call.
+    void draw(sf::RenderTarget& target) const;
+};
+
+template <typename ColorFn>
+void BarChartRenderer::update(const std::vector<int>& data, sf::Vector2u canvasSize, ColorFn colorOf) {
+    if (data.empty() || canvasSize.x == 0) {
+        resizeColumns(0);
+        return;
+    }
+
+    const std::size_t columns = std::min<std::size_t>(data.size(), canvasSize.x);
+    const float columnWidth = static_cast<float>(canvasSize.x) / columns;
+    const float canvasHeight = static_cast<float>(canvasSize.y);
+    resizeColumns(columns);
+
+    if (columns == data.size()) {
+        for (std::size_t k = 0; k < data.size(); ++k) {
+            setColumn(k, k * columnWidth, columnWidth, static_cast<float>(data[k]), canvasHeight, colorOf(k));
+        }
+        return;
+    }
+
+    // More elements than pixels: fold each run of elements into one column.
+    for (std::size_t c = 0; c < columns; ++c) {
+        std::size_t begin = c * data.size() / columns;
+        std::size_t end = (c + 1) * data.size() / columns;
+        int tallest = data[begin];
+        sf::Color color = colorOf(begin);
+        for (std::size_t k = begin + 1; k < end; ++k) {
+            tallest = std::max(tallest, data[k]);
+            sf::Color elementColor = colorOf(k);
+            if (elementColor != m_baseColor) color = elementColor;
+        }
+        setColumn(c, c * columnWidth, columnWidth, static_cast<float>(tallest), canvasHeight, color);
+    }
+}
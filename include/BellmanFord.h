@@ -0,0 +1,86 @@
+#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Bellman-Ford variants, all of which accept negative weights:
+ *   Passes    relax every arc in CSR order, pass after pass, until a pass
+ *             changes nothing (at most n passes)
+ *   Queue     SPFA: only nodes whose distance changed relax their arcs, in
+ *             FIFO order
+ *   Parallel  passes over all arcs spread over the thread pool, lowering
+ *             distances with an atomic compare-and-swap
+ */
+enum class BellmanFordMode { Passes, Queue, Parallel };
+
+const BellmanFordMode ALL_BELLMAN_FORD_MODES[] = { BellmanFordMode::Passes, BellmanFordMode::Queue, BellmanFordMode::Parallel };
+
+inline const char* bellmanFordModeName(BellmanFordMode mode) {
+    switch (mode) {
+        case BellmanFordMode::Passes:   return "passes";
+        case BellmanFordMode::Queue:    return "queue (SPFA)";
+        case BellmanFordMode::Parallel: return "parallel passes";
+    }
+    return "";
+}
+
+struct BellmanFordStats {
+    unsigned long long passes = 0;      // Full passes over the arcs
+    unsigned long long dequeues = 0;    // Queue mode: nodes taken from the queue
+    unsigned long long relaxations = 0; // Arcs examined
+    unsigned long long updates = 0;     // Distances lowered
+};
+
+/**
+ * @class BellmanFord
+ * @brief Single-source shortest paths with negative weights, reporting the
+ * actual negative cycle when one is reachable from the source.
+ *
+ * Every lowered distance records the arc it came through, and any cycle
+ * among these parent arcs is a negative cycle. The parent arcs are checked
+ * for one every few passes (or every n dequeues), which finds a cycle long
+ * before the n passes that prove it otherwise. If the search gets as far
+ * as that proof (a pass still lowering a distance after n - 1 passes, or a
+ * queue-mode path of n arcs), following the parent arcs n times from the
+ * lowered node lands on the cycle.
+ */
+class BellmanFord {
+private:
+    static constexpr std::size_t GRAIN = 1024; // Nodes per parallel task
+    static constexpr int CYCLE_CHECK_PASSES = 4; // Passes between parent cycle checks
+
+    const Graph& m_graph;
+    std::vector<std::int64_t> m_distances;
+    std::vector<std::size_t> m_parentArc;
+    std::vector<std::size_t> m_cycle;        // Arcs of the negative cycle, in order
+    BellmanFordStats m_stats;
+
+    // Each returns a node lowered after a negative cycle was proven, or -1;
+    // m_cycle is set if the parent check found the cycle first
+    int runPasses();
+    int runQueue(int source);
+    int runParallel(int source, unsigned threads);
+    void rebuildParents(int source);
+    bool findParentCycle();
+    bool readCycle(int node);
+
+public:
+    static constexpr std::int64_t UNREACHED = INT64_MAX;
+    static constexpr std::size_t NO_ARC = SIZE_MAX;
+
+    explicit BellmanFord(const Graph& graph);
+
+    // Returns false if a negative cycle is reachable from the source; its
+    // arcs are then in getNegativeCycle() and the distances are meaningless.
+    // `threads` limits the parallel mode (0 = all).
+    bool run(int source, BellmanFordMode mode, unsigned threads = 0);
+
+    const std::vector<std::int64_t>& getDistances() const { return m_distances; }
+    // A shortest-path tree (NO_ARC at the source and unreached nodes) when
+    // run() returned true, in every mode
+    const std::vector<std::size_t>& getParentArcs() const { return m_parentArc; }
+    const std::vector<std::size_t>& getNegativeCycle() const { return m_cycle; }
+    const BellmanFordStats& getStats() const { return m_stats; }
+};
@@ -1,43 +1,58 @@
 #pragma once
 #include "Visualizer.h"
+#include "BellmanFord.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include <deque>
+#include <memory>
 #include <vector>
 #include <map>
-#include <tuple>
 #include <string>
 #include <SFML/Graphics.hpp>
 
 class BellmanFordVisualizer : public Visualizer {
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-        sf::Text distLabel;
-    };
-
-    std::map<int, Node> m_nodes;
-    std::vector<std::tuple<int, int, int>> m_edges; // {u, v, weight}
-    std::map<std::pair<int, int>, sf::Text> m_edgeWeights;
-    sf::Font m_font;
+    Graph m_graph;                  // Edge ids double as renderer edge indices
+    GraphRenderer m_renderer;
+    std::vector<int> m_distLabels;  // Per node, the renderer label showing its distance
+    std::vector<int> m_highlightedEdges;
     
     std::vector<int> m_distances;
+
+    // The animation follows the mode step by step (M cycles it); the engine
+    // runs the same mode in full for the stats and the negative cycle
+    BellmanFordMode m_mode;
+    std::unique_ptr<BellmanFord> m_engine;
+    double m_engineMs;
+    std::vector<int> m_cycleEdges;  // Edge ids of the engine's negative cycle
     
     bool m_isVisualizing;
     bool m_isDone;
-    int m_iteration;
-    int m_edgeIndex;
+    int m_iteration;        // Passes completed
+    bool m_passChanged;     // Whether the current pass lowered a distance
+    std::size_t m_arc;      // Next arc to relax, in CSR order
+    int m_arcSource;        // The node m_arc leaves from; in queue mode -1 until one is dequeued
+    std::vector<int> m_passEdges; // Parallel mode: edges that lowered a distance in the last pass
+    std::deque<int> m_queue;      // Queue mode
+    std::vector<bool> m_queued;
+    std::vector<int> m_arcsOnPath;
     bool m_negativeCycle;
 
-    sf::Clock m_clock;
-    float m_delay = 0.3f;
 
     void buildGraph();
+    void runEngine();
+    void stepPasses();
+    void stepParallelPass();
+    void stepQueue();
+    void finish(bool negativeCycle);
 
 public:
-    BellmanFordVisualizer(sf::RenderWindow& window);
+    BellmanFordVisualizer(sf::RenderWindow* window);
     ~BellmanFordVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
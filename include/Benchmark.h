@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * Command-line benchmarks, run as `--bench <suite> [options]` without a
+ * window. Inputs come from the seeded DataGenerator, so every run of the same
+ * command measures the same workload.
+ *
+ * Suites:
+ *   sorts   every sort engine over every input distribution and size;
+ *           reports comparisons, swaps, writes and ns/element
+ *   sssp    delta-stepping shortest paths at each thread count against
+ *           sequential Dijkstra; reports time, speedup and relaxations
+ *   apsp    Johnson against blocked Floyd-Warshall on random graphs of
+ *           rising degree; reports both times and the crossover degree
+ *
+ * Options of sorts (args excludes the program name and "--bench"):
+ *   --algorithms <a,b>     sorts to run (bubble, selection, insertion, merge, quick, heap)
+ *   --distributions <a,b>  inputs to use (uniform, sorted, reversed, nearly-sorted,
+ *                          organ-pipe, few-unique, zipf)
+ *   --min-size <n>         smallest input, default 1e2
+ *   --max-size <n>         largest input, default 1e6 (sizes step by 10x)
+ *   --quadratic-max <n>    largest input for the O(n^2) sorts, default 1e4
+ *   --max-ops <n>          abandon a run after n comparisons, default 4e9
+ *   --repeat <n>           run each case n times and report the best time
+ *   --seed <n>             generator seed, default 1
+ *   --key-bits <n>         32 (default) or 64-bit keys over the full range
+ *   --format <f>           table (default), csv or json
+ *   --output <path>        write the report to a file instead of stdout
+ *
+ * Numbers are whole and non-negative, in digits or exponent form (see
+ * CommandLine.h); any other value is reported and the run exits with 1.
+ *
+ * Options of sssp:
+ *   --graph <path>         graph file to load (see GraphLoader.h); otherwise a
+ *                          random directed graph is generated from:
+ *   --nodes <n>            nodes, default 1e6
+ *   --degree <n>           arcs per node, default 8
+ *   --max-weight <n>       weights are uniform in [1, n], default 1000
+ *   --source <n>           node to search from, default 0
+ *   --delta <n>            bucket width, default DeltaStepping::suggestDelta
+ *   --threads <a,b>        thread counts, default 1, 2, 4, ... up to the hardware
+ *   --repeat, --seed, --format, --output   as for sorts
+ *
+ * Options of apsp:
+ *   --nodes <n>            nodes, default 1024 (at most 8192, two n x n matrices)
+ *   --degrees <a,b>        arcs per node, default 1, 2, 4, ... up to n
+ *   --max-weight <n>       weights are uniform in [1, n], default 1000
+ *   --threads <n>          threads for both engines, default all
+ *   --repeat, --seed, --format, --output   as for sorts
+ *
+ * Returns the process exit code.
+ */
+int runBenchmark(const std::vector<std::string>& args);
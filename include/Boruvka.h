@@ -0,0 +1,58 @@
+#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One contraction round, as recorded for the visualizer
+struct BoruvkaRound {
+    std::vector<int> edges;   // Tree edges added this round
+    int componentsBefore;
+    int componentsAfter;
+    std::size_t liveEdges;    // Edges between different components at the start of the round
+};
+
+struct BoruvkaStats {
+    int rounds = 0;
+    unsigned long long scanned = 0; // Edge visits summed over all rounds
+    std::int64_t treeWeight = 0;
+};
+
+/**
+ * @class Boruvka
+ * @brief Minimum spanning forest of an edge list by parallel Borůvka.
+ *
+ * Each round every component picks its cheapest outgoing edge, then all
+ * picked edges are contracted at once, so the component count at least
+ * halves per round. Every step is a parallelFor:
+ *   - picking: each live edge offers its key to the components of both
+ *     ends with an atomic min. Keys are Kruskal's (weight above edge id),
+ *     so ties break by id and the picked edges never close a cycle; the
+ *     tree is the one Kruskal builds.
+ *   - contracting: each component points at the component its edge leads
+ *     to. Two components that picked the same edge point at each other;
+ *     the lower id becomes the root. Pointer jumping then flattens the
+ *     trees and every node takes its new component.
+ *   - compacting: edges whose ends now share a component are dropped.
+ */
+class Boruvka {
+private:
+    static constexpr std::size_t GRAIN = 1 << 14; // Edges or nodes per task
+
+    int m_nodeCount;
+    const std::vector<GraphEdge>& m_edges;
+    std::vector<int> m_component;  // Per node: the id of its component's root node
+    std::vector<int> m_tree;       // Edge ids, round by round
+    BoruvkaStats m_stats;
+
+public:
+    Boruvka(int nodeCount, const std::vector<GraphEdge>& edges);
+
+    // Builds the forest over at most `threads` threads (0 = all), recording
+    // each round into rounds if given
+    void run(unsigned threads = 0, std::vector<BoruvkaRound>* rounds = nullptr);
+
+    const std::vector<int>& getTreeEdges() const { return m_tree; }
+    const std::vector<int>& getComponents() const { return m_component; }
+    const BoruvkaStats& getStats() const { return m_stats; }
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "Boruvka.h"
+#include "DisjointSets.h"
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class BoruvkaVisualizer
+ * @brief Replays a parallel Borůvka run round by round.
+ *
+ * Each round takes two steps: the cheapest edge out of every component
+ * lights up, then those edges join the tree and the components they link
+ * merge into one colour. Edges left inside a component fade out. T changes
+ * the engine's thread count; the HUD checks the tree weight against
+ * Kruskal's.
+ */
+class BoruvkaVisualizer : public Visualizer {
+private:
+    // Edge i is renderer edge i
+    int m_nodeCount;
+    std::vector<GraphEdge> m_edges;
+    GraphRenderer m_renderer;
+
+    unsigned m_threads;
+    std::unique_ptr<Boruvka> m_engine;
+    double m_engineMs;
+    std::int64_t m_kruskalWeight;
+    std::vector<BoruvkaRound> m_rounds;
+    std::size_t m_roundIndex;     // Rounds fully replayed
+    bool m_showingPicks;          // The current round's edges are lit but not merged yet
+
+    DisjointSets m_sets;          // Components as replayed so far
+    std::vector<char> m_inTree;   // Per edge
+
+    bool m_isVisualizing;
+    bool m_isDone;
+
+    void buildGraph();
+    void runEngine();
+    void mergeRound(const BoruvkaRound& round);
+    sf::Color getComponentColor(int node);
+
+public:
+    BoruvkaVisualizer(sf::RenderWindow* window);
+    ~BoruvkaVisualizer() override = default;
+
+    void handleEvent(sf::Event& event) override;
+    bool step() override;
+    void draw() override;
+    void reset() override;
+    void start() override;
+};
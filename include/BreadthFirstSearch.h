@@ -0,0 +1,159 @@
+#pragma once
+#include "Graph.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * BFS variants:
+ *   TopDown              every frontier node checks all its arcs
+ *   DirectionOptimizing  top-down while the frontier is small; bottom-up
+ *                        (every unvisited node looks for a parent in the
+ *                        frontier and stops at the first) while it is
+ *                        large (Beamer, Asanović & Patterson)
+ */
+enum class BfsMode { TopDown, DirectionOptimizing };
+
+const BfsMode ALL_BFS_MODES[] = { BfsMode::TopDown, BfsMode::DirectionOptimizing };
+
+inline const char* bfsModeName(BfsMode mode) {
+    switch (mode) {
+        case BfsMode::TopDown:             return "top-down";
+        case BfsMode::DirectionOptimizing: return "direction-optimizing";
+    }
+    return "";
+}
+
+enum class BfsDirection { TopDown, BottomUp };
+
+// One expanded level
+struct BfsLevel {
+    int depth;
+    BfsDirection direction;
+    int frontier;            // Nodes expanded
+    int discovered;          // Nodes reached for the first time
+    std::size_t inspected;   // Arcs examined
+};
+
+struct BfsStats {
+    int levels = 0;
+    int bottomUpLevels = 0;
+    int reached = 0;
+    unsigned long long inspected = 0; // Arcs examined over all levels
+};
+
+/**
+ * @class BreadthFirstSearch
+ * @brief Level-by-level BFS over a visited bitmap.
+ *
+ * The visited set is a bitmap of one bit per node and the frontier a list
+ * of nodes. A top-down level walks the frontier list, or once it holds a
+ * node per 64 a frontier bitmap filled from it, which visits the nodes in
+ * id order. A bottom-up level walks the clear bits of the visited set and
+ * reads that frontier bitmap at each incoming arc's source.
+ * Directed graphs get a reversed copy for that, built on the first
+ * bottom-up level.
+ *
+ * Levels are expanded in parallel, each task taking a run of frontier
+ * list entries or of bitmap words. Top-down tasks claim a
+ * node by setting its visited bit with an atomic OR after a plain read has
+ * found it clear, so only the winner records it. Bottom-up tasks own the
+ * words they scan and need no atomics at all. Every task appends the nodes
+ * it reached to a list of its own and keeps its own counts; the lists are
+ * joined into the next frontier after the level, so nothing takes a lock.
+ * With one thread the same code runs without atomic writes.
+ *
+ * Direction-optimizing mode switches to bottom-up once a growing frontier's
+ * arcs exceed 1/ALPHA of the arcs still unexplored, and back to top-down
+ * once a shrinking frontier drops below 1/BETA of the nodes. On
+ * low-diameter graphs the few big middle levels then cost about one arc
+ * per node instead of all of them.
+ */
+class BreadthFirstSearch {
+private:
+    static constexpr int ALPHA = 14;
+    static constexpr int BETA = 24;
+    static constexpr std::size_t NODES_GRAIN = 256; // Frontier list entries per task
+    static constexpr std::size_t BITS_GRAIN = 4;    // Bitmap words (256 nodes) per task
+
+    using Bitmap = std::unique_ptr<std::atomic<std::uint64_t>[]>;
+
+    // What one task found during a level, besides its nodes
+    struct Part {
+        std::size_t inspected;
+        std::size_t arcs;       // Arcs leaving the nodes it reached
+        unsigned char worker;   // ThreadPool::getWorkerIndex() of the thread that ran it
+    };
+
+    const Graph& m_graph;
+    Graph m_incoming;              // Reversed graph, for directed bottom-up levels
+    bool m_hasIncoming;
+    BfsMode m_mode;
+    unsigned m_threads;
+
+    std::size_t m_words;
+    Bitmap m_visited;
+    Bitmap m_frontierBits;         // The frontier as bits, during levels that use them only
+    std::vector<int> m_frontier;
+    std::vector<int> m_previousFrontier;
+    std::vector<int> m_depth;      // Per node: level it was reached at, -1 if not yet
+    std::vector<unsigned char> m_worker; // Per node: ThreadPool worker that reached it
+    std::vector<Part> m_parts;
+    std::vector<std::vector<int>> m_partNodes; // Per task: the nodes it reached
+
+    std::size_t m_frontierArcs;    // Arcs leaving the frontier
+    std::size_t m_unexploredArcs;  // Arcs leaving unvisited nodes
+    int m_currentDepth;
+    BfsDirection m_direction;
+    std::vector<BfsLevel> m_levels;
+    BfsStats m_stats;
+
+    static bool testBit(const Bitmap& bits, int node) {
+        return (bits[node >> 6].load(std::memory_order_relaxed) >> (node & 63)) & 1;
+    }
+    // Sets or clears a bit of a word no other thread writes
+    static void setBit(const Bitmap& bits, int node, bool value = true) {
+        std::atomic<std::uint64_t>& word = bits[node >> 6];
+        std::uint64_t mask = 1ull << (node & 63);
+        std::uint64_t current = word.load(std::memory_order_relaxed);
+        word.store(value ? current | mask : current & ~mask, std::memory_order_relaxed);
+    }
+
+    void visit(int node, Part& part, std::vector<int>& nodes);
+    void expand(int node, Part& part, std::vector<int>& nodes, bool shared);
+    void topDownNodes(std::size_t begin, std::size_t end, Part& part, std::vector<int>& nodes, bool shared);
+    void topDownWords(std::size_t begin, std::size_t end, Part& part, std::vector<int>& nodes, bool shared);
+    void bottomUpWords(const Graph& incoming, std::size_t begin, std::size_t end, Part& part, std::vector<int>& nodes);
+
+public:
+    explicit BreadthFirstSearch(const Graph& graph);
+
+    void setMode(BfsMode mode) { m_mode = mode; }
+    void setThreads(unsigned threads) { m_threads = threads; } // 0 = all
+
+    // Forgets every visited node and recorded level
+    void clear();
+
+    // Makes source the frontier, keeping what earlier searches visited;
+    // false if source was visited already
+    bool start(int source);
+
+    // Expands the frontier by one level; false once it is empty
+    bool stepLevel();
+
+    // Searches from every unvisited node in turn, lowest id first
+    void run();
+
+    // Lowest unvisited node from `from` on, or -1
+    int findUnvisited(int from) const;
+
+    bool isVisited(int node) const { return testBit(m_visited, node); }
+    int getDepth(int node) const { return m_depth[node]; }
+    int getWorker(int node) const { return m_worker[node]; }
+    const std::vector<int>& getFrontier() const { return m_frontier; }
+    const std::vector<int>& getPreviousFrontier() const { return m_previousFrontier; } // Expanded by the last level
+    const std::vector<BfsLevel>& getLevels() const { return m_levels; }
+    const BfsStats& getStats() const { return m_stats; }
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "Visualizer.h"
+#include "BarChartRenderer.h"
 #include <vector>
 
 class BubbleSortVisualizer : public Visualizer {
@@ -9,14 +10,15 @@ private:
     bool m_isSorting;
     bool m_isSorted;
 
-    void initializeData();
+    BarChartRenderer m_bars;
 
 public:
-    BubbleSortVisualizer(sf::RenderWindow& window);
+    BubbleSortVisualizer(sf::RenderWindow* window);
     ~BubbleSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+/**
+ * Numeric command-line values. They are whole, non-negative numbers,
+ * written as plain digits or in exponent form ("1e6"). Signs, fractions,
+ * trailing text and values too large for the target are rejected, never
+ * wrapped or thrown.
+ */
+
+// False, leaving value untouched, unless text is one of the forms above
+inline bool parseCount(const std::string& text, unsigned long long& value) {
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) return false;
+    const char* first = text.data();
+    const char* last = first + text.size();
+    unsigned long long whole = 0;
+    std::from_chars_result result = std::from_chars(first, last, whole);
+    if (result.ec == std::errc::result_out_of_range) return false;
+    if (result.ec == std::errc() && result.ptr == last) {
+        value = whole;
+        return true;
+    }
+    double number = 0.0;
+    result = std::from_chars(first, last, number);
+    if (result.ec != std::errc() || result.ptr != last || number != std::floor(number) || number >= 0x1p64) return false;
+    value = static_cast<unsigned long long>(number);
+    return true;
+}
+
+// parseCount() into any integer type; prints "Bad value for <option>" to
+// std::cerr on failure, so the caller only has to return its error code
+template<typename T>
+bool parseOption(const std::string& option, const std::string& text, T& value) {
+    unsigned long long parsed = 0;
+    if (!parseCount(text, parsed) || parsed > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+        std::cerr << "Bad value for " << option << ": '" << text << "'" << std::endl;
+        return false;
+    }
+    value = static_cast<T>(parsed);
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <utility>
+#include <atomic>
+#include <memory>
+
+/**
+ * @class ConcurrentDisjointSets
+ * @brief Lock-free union-find that any number of threads may use at once.
+ *
+ * A root is only ever linked under a lower-numbered root, by one
+ * compare-and-swap that fails if the root was linked meanwhile; the losing
+ * thread finds the new roots and tries again. Parents therefore only
+ * decrease, which keeps the forest acyclic under any interleaving and
+ * makes every root the lowest node of its set. Path shortcuts are plain
+ * stores: only a root's parent is ever swapped, and a non-root's parent
+ * may be replaced by any of its ancestors, so racing shortcuts at worst
+ * undo each other's progress, never a link.
+ */
+class ConcurrentDisjointSets {
+private:
+    std::unique_ptr<std::atomic<int>[]> m_parent;
+    int m_count;
+
+public:
+    explicit ConcurrentDisjointSets(int count = 0) { reset(count); }
+
+    // Not thread-safe
+    void reset(int count) {
+        m_parent.reset(new std::atomic<int>[count]);
+        for (int i = 0; i < count; ++i) m_parent[i].store(i, std::memory_order_relaxed);
+        m_count = count;
+    }
+
+    int find(int x) {
+        while (true) {
+            int parent = m_parent[x].load(std::memory_order_relaxed);
+            if (parent == x) return x;
+            int grandparent = m_parent[parent].load(std::memory_order_relaxed);
+            if (grandparent != parent) m_parent[x].store(grandparent, std::memory_order_relaxed);
+            x = grandparent;
+        }
+    }
+
+    // Merges the sets of a and b; false if they were one set already
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) std::swap(a, b);
+            int expected = a;
+            if (m_parent[a].compare_exchange_strong(expected, b)) return true;
+        }
+    }
+
+    // Points x straight at its root, and returns the root
+    int flatten(int x) {
+        int root = find(x);
+        int parent = m_parent[x].load(std::memory_order_relaxed);
+        if (parent != root) m_parent[x].store(root, std::memory_order_relaxed);
+        return root;
+    }
+
+    int getCount() const { return m_count; }
+};
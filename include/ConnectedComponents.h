@@ -0,0 +1,84 @@
+#pragma once
+#include "ConcurrentDisjointSets.h"
+#include "Graph.h"
+#include <cstddef>
+#include <vector>
+
+struct ComponentsStats {
+    int components = 0;
+    int largest = 0;                    // Nodes in the biggest component
+    unsigned long long linkedArcs = 0;  // Arcs passed to unite()
+    unsigned long long skippedArcs = 0; // Arcs of nodes already in the biggest component, never looked at
+};
+
+/**
+ * @class ConnectedComponents
+ * @brief Parallel connected components over a lock-free union-find.
+ *
+ * Arcs are united straight from the CSR arrays by parallel tasks sharing
+ * one ConcurrentDisjointSets; no traversal order is needed. run() follows
+ * Afforest (Sutton, Ben-Nun & Barak): first every node links along just
+ * its first SAMPLE_ARCS arcs, which on most graphs already gathers the
+ * bulk of the nodes into one giant component. A sample of nodes finds
+ * that component, and in the last pass nodes inside it skip the rest of
+ * their arcs; every edge they skip is still seen from its other end,
+ * unless both ends are in the giant component anyway. Directed graphs get
+ * weakly connected components, and no skipping, as their arcs are not
+ * mirrored.
+ *
+ * Every link is a random access, where a BFS per component streams through
+ * its frontier. On one core this beats BFS only when there are many
+ * components spread over the node ids (1.4x on 2M nodes in 800k
+ * components); one giant component runs about 2x faster as a BFS.
+ *
+ * Labels are the lowest node id of each component.
+ */
+class ConnectedComponents {
+private:
+    static constexpr std::size_t GRAIN = 4096; // Nodes per task
+    static constexpr int SAMPLE_NODES = 1024;
+
+    const Graph& m_graph;
+    ConcurrentDisjointSets m_sets;
+    std::vector<int> m_labels;
+    ComponentsStats m_stats;
+
+    void flattenAll(unsigned threads, bool storeLabels);
+
+public:
+    static constexpr int SAMPLE_ARCS = 2;
+
+    explicit ConnectedComponents(const Graph& graph);
+
+    // Makes every node its own component again
+    void clear();
+
+    // --- The passes of run(), callable one by one ---
+
+    // Links every node along its round-th arc, if it has one
+    void linkSampledArcs(int round, unsigned threads = 0);
+
+    // Points every node straight at its root; run() does this once, after
+    // the last sampled round, so the remaining links start from short paths
+    void compress(unsigned threads = 0);
+
+    // Root of the component most sampled nodes belong to
+    int findLargestRoot();
+
+    // Links nodes [first, last) along their arcs after the sampled ones.
+    // Nodes whose root is skipRoot are left out (-1 leaves none out), and
+    // flagged in skipped (indexed from first) if given.
+    void linkRemainingArcs(int first, int last, int skipRoot, unsigned threads = 0, std::vector<char>* skipped = nullptr);
+
+    // Labels every node and counts the components, flattening on the way
+    void label(unsigned threads = 0);
+
+    void run(unsigned threads = 0);
+
+    // Current root of a node, also while the passes are under way
+    int findRoot(int node) { return m_sets.find(node); }
+
+    int getLabel(int node) const { return m_labels[node]; }
+    const std::vector<int>& getLabels() const { return m_labels; }
+    const ComponentsStats& getStats() const { return m_stats; }
+};
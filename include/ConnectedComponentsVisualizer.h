@@ -0,0 +1,61 @@
+#pragma once
+#include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "ConnectedComponents.h"
+#include <memory>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class ConnectedComponentsVisualizer
+ * @brief Steps through ConnectedComponents' passes on an undirected graph.
+ *
+ * The two sampling rounds come first, then the largest component is picked
+ * out and the remaining arcs are linked a batch of nodes at a time, arcs of
+ * nodes inside that component greyed out as skipped. Nodes are coloured by
+ * their current root, so components merge colours as they are linked.
+ * T changes the thread count; the HUD times a full run against one BFS per
+ * component, and says so when BFS is faster, as it is on most graphs
+ * without many components.
+ */
+class ConnectedComponentsVisualizer : public Visualizer {
+private:
+    enum class Phase { Sampling, FindLargest, Remaining, Labelling, Done };
+    enum class EdgeState : char { Untouched, Linked, Skipped };
+    static constexpr int BATCHES = 4; // Steps the remaining arcs are linked in
+
+    Graph m_graph;
+    GraphRenderer m_renderer;
+
+    unsigned m_threads;
+    double m_engineMs;
+    double m_bfsMs;             // Direction-optimizing BFS from every unreached node; < 0 for directed graphs
+    ComponentsStats m_engineStats;
+
+    std::unique_ptr<ConnectedComponents> m_components;
+    Phase m_phase;
+    int m_round;                // Sampling round, or batch of remaining nodes
+    int m_largestRoot;
+    std::vector<EdgeState> m_edgeStates;
+    std::vector<int> m_stepEdges; // Linked by the last step, drawn yellow
+
+    bool m_isVisualizing;
+    bool m_isDone;
+
+    void buildGraph();
+    void runEngine();
+    void markArcs(int node, std::size_t begin, std::size_t end, EdgeState state);
+    void recolor();
+    sf::Color getComponentColor(int node);
+
+public:
+    ConnectedComponentsVisualizer(sf::RenderWindow* window);
+    ~ConnectedComponentsVisualizer() override = default;
+
+    void handleEvent(sf::Event& event) override;
+    bool step() override;
+    void draw() override;
+    void reset() override;
+    void start() override;
+};
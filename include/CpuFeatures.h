@@ -0,0 +1,26 @@
+#pragma once
+
+/**
+ * Runtime checks for the SIMD kernels. A kernel marked AVX2_TARGET is
+ * compiled for AVX2 whatever the build flags, and callers only pick it
+ * when hasAvx2() reports that the machine running the program has it, so
+ * one binary runs everywhere and still gets the fast loops where it can.
+ * Without GCC/Clang on x86 there are no AVX2 kernels (HAS_AVX2_KERNELS 0).
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HAS_AVX2_KERNELS 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define HAS_AVX2_KERNELS 0
+#define AVX2_TARGET
+#endif
+
+// True if the AVX2 kernels are built in and this CPU and OS can run them
+inline bool hasAvx2() {
+#if HAS_AVX2_KERNELS
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Reproducible input data for the sorts and benchmarks. Every element is
+ * derived from (seed, index) alone by a counter-based generator, so the same
+ * seed always yields the same array, any chunk can be produced on its own,
+ * and large arrays are filled in parallel.
+ */
+enum class Distribution { Uniform, Sorted, Reversed, NearlySorted, OrganPipe, FewUnique, Zipf };
+
+const Distribution ALL_DISTRIBUTIONS[] = {
+    Distribution::Uniform, Distribution::Sorted, Distribution::Reversed, Distribution::NearlySorted,
+    Distribution::OrganPipe, Distribution::FewUnique, Distribution::Zipf
+};
+
+// Short lower-case name, as used on the command line and in reports
+std::string distributionName(Distribution distribution);
+
+// Parses a name produced by distributionName(). Returns false if unknown.
+bool parseDistribution(const std::string& name, Distribution& distribution);
+
+struct DataSpec {
+    Distribution distribution = Distribution::Uniform;
+    std::size_t count = 0;
+    std::uint64_t seed = 1;
+    std::int64_t minValue = 0;
+    std::int64_t maxValue = 1 << 30; // Inclusive
+};
+
+// SplitMix64 applied to (seed, index): a stateless source of random bits
+inline std::uint64_t randomAt(std::uint64_t seed, std::uint64_t index) {
+    std::uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// The seed the visualizers draw their inputs from. Picked at random on first
+// use unless set (e.g. from --seed), and printed so a run can be repeated.
+std::uint64_t getWorkloadSeed();
+void setWorkloadSeed(std::uint64_t seed);
+
+/**
+ * @class DataGenerator
+ * @brief Produces the elements described by a DataSpec, whole or in chunks.
+ *
+ * Values may span the full 64-bit range; narrower element types receive the
+ * value converted, so the spec's range should fit the type.
+ */
+class DataGenerator {
+private:
+    static constexpr std::size_t CHUNK_SIZE = 1 << 16;
+
+    DataSpec m_spec;
+    std::uint64_t m_range;                  // maxValue - minValue + 1, where 0 means 2^64
+    std::vector<double> m_zipfCumulative;   // Zipf only: cumulative rank weights
+
+    std::uint64_t rampAt(std::uint64_t position, std::uint64_t count) const;
+
+public:
+    explicit DataGenerator(const DataSpec& spec);
+
+    const DataSpec& getSpec() const { return m_spec; }
+
+    // Element `index` of the array
+    std::int64_t valueAt(std::uint64_t index) const;
+
+    // Writes elements [first, first + count) to out
+    template <typename T>
+    void fill(std::uint64_t first, T* out, std::size_t count) const {
+        for (std::size_t k = 0; k < count; ++k) out[k] = static_cast<T>(valueAt(first + k));
+    }
+
+    // The whole array, generated in parallel on the shared thread pool
+    template <typename T>
+    std::vector<T> generate() const {
+        std::vector<T> data(m_spec.count);
+        ThreadPool::getInstance().parallelFor(data.size(), CHUNK_SIZE, [&](std::size_t begin, std::size_t end) {
+            fill(begin, data.data() + begin, end - begin);
+        });
+        return data;
+    }
+};
+
+// Shorthand for DataGenerator(spec).generate<int>()
+std::vector<int> generateData(const DataSpec& spec);
@@ -0,0 +1,68 @@
+#pragma once
+#include "Graph.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// One round of delta-stepping, as recorded for the visualizer
+struct DeltaSteppingPhase {
+    std::int64_t bucket;        // Index of the bucket being settled
+    bool heavy;                 // Heavy edges of the settled bucket, rather than a light round
+    std::vector<int> frontier;  // Nodes whose edges were relaxed
+    std::vector<std::pair<int, std::int64_t>> updates; // Lowered distances, as they stood after the round
+};
+
+struct DeltaSteppingStats {
+    unsigned long long buckets = 0;     // Non-empty buckets settled
+    unsigned long long phases = 0;      // Light rounds plus heavy rounds
+    unsigned long long relaxations = 0; // Arcs examined
+    unsigned long long updates = 0;     // Distances lowered
+};
+
+/**
+ * @class DeltaStepping
+ * @brief Parallel single-source shortest paths (Meyer & Sanders).
+ *
+ * Tentative distances are grouped into buckets of width delta. The lowest
+ * non-empty bucket is settled in rounds: all its nodes relax their light
+ * edges (weight <= delta) in parallel, which may put nodes back into the
+ * same bucket, until it stays empty; then its nodes relax their heavy edges
+ * once. Small delta approaches Dijkstra, large delta Bellman-Ford.
+ *
+ * Relaxations run on the shared ThreadPool and lower distances with an
+ * atomic compare-and-swap, so the rounds need no locks. Buckets live in a
+ * ring of maxWeight / delta + 2 slots, as no tentative distance is further
+ * than that ahead of the current bucket. Weights must be non-negative.
+ */
+class DeltaStepping {
+private:
+    static constexpr std::size_t GRAIN = 256; // Frontier nodes per parallel task
+
+    const Graph& m_graph;
+    std::unique_ptr<std::atomic<std::int64_t>[]> m_tentative;
+    std::vector<std::int64_t> m_distances;
+    std::vector<std::vector<int>> m_lowered; // Per task: nodes it lowered in the last round
+    DeltaSteppingStats m_stats;
+
+    void relax(const std::vector<int>& frontier, bool heavy, std::int64_t delta, unsigned threads);
+
+public:
+    static constexpr std::int64_t UNREACHED = INT64_MAX;
+
+    explicit DeltaStepping(const Graph& graph);
+
+    // Maximum weight over average degree, the choice that keeps light rounds
+    // short on graphs with random weights; at least 1
+    static std::int64_t suggestDelta(const Graph& graph);
+
+    // Computes distances from source with at most `threads` threads (0 = all),
+    // recording every round into phases if given. Returns false (with a
+    // message on stderr) for a negative weight or a delta below 1.
+    bool run(int source, std::int64_t delta, unsigned threads, std::vector<DeltaSteppingPhase>* phases = nullptr);
+
+    const std::vector<std::int64_t>& getDistances() const { return m_distances; }
+    const DeltaSteppingStats& getStats() const { return m_stats; }
+};
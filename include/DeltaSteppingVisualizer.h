@@ -0,0 +1,56 @@
+#pragma once
+#include "Visualizer.h"
+#include "DeltaStepping.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <map>
+#include <string>
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class DeltaSteppingVisualizer
+ * @brief Shows delta-stepping one round at a time on the Dijkstra graph.
+ *
+ * The run is computed up front by DeltaStepping and replayed round by round:
+ * the frontier being relaxed is highlighted, nodes waiting in buckets are
+ * coloured by bucket, and a strip at the bottom lists the bucket contents.
+ * Up/Down doubles or halves delta and T cycles the thread count; both rerun
+ * the search and report its time.
+ */
+class DeltaSteppingVisualizer : public Visualizer {
+private:
+    static constexpr int SHOWN_BUCKETS = 8; // Buckets listed in the strip, from the current one
+
+    Graph m_graph;                  // Edge ids double as renderer edge indices
+    GraphRenderer m_renderer;
+    std::vector<int> m_distLabels;  // Per node, the renderer label showing its distance
+    std::unique_ptr<DeltaStepping> m_engine;
+
+    std::int64_t m_delta;
+    unsigned m_threads;             // 1, 2, 4, ... up to the pool size
+    double m_runMs;                 // Time of an unrecorded run with these settings
+    std::vector<DeltaSteppingPhase> m_phases;
+    std::size_t m_phase;            // Rounds replayed so far
+    std::vector<std::int64_t> m_distances; // As of the replayed rounds
+    std::vector<bool> m_settled;
+
+    bool m_isVisualizing;
+    bool m_isDone;
+
+    void buildGraph();
+    void runSearch();
+    sf::Color getBucketColor(std::int64_t bucket) const;
+
+public:
+    DeltaSteppingVisualizer(sf::RenderWindow* window);
+    ~DeltaSteppingVisualizer() override = default;
+
+    void handleEvent(sf::Event& event) override;
+    bool step() override;
+    void draw() override;
+    void reset() override;
+    void start() override;
+};
@@ -1,42 +1,82 @@
 #pragma once
 #include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "PriorityQueues.h"
+#include "Trace.h"
+#include <cstdint>
 #include <vector>
 #include <map>
-#include <queue>
 #include <string>
 #include <SFML/Graphics.hpp>
 
 class DijkstraVisualizer : public Visualizer {
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-        sf::Text distLabel;
-        std::vector<std::pair<int, int>> adj; // {neighbor, weight}
+    Graph m_graph;                  // Edge ids double as renderer edge indices
+    GraphRenderer m_renderer;
+    std::vector<int> m_distLabels;  // Per node, the renderer label showing its distance
+    int m_highlightedEdge;
+    
+    // Full shortest-path tree from the source, or a point-to-point query from
+    // the source to the target; Q cycles, left/right click picks the nodes
+    enum class QueryMode { FullTree, Bidirectional, AStar };
+    QueryMode m_mode;
+    int m_source;
+    int m_target;
+    Graph m_reverse;                // Incoming arcs for the backward search; empty if undirected
+    std::vector<int> m_pathEdges;   // Shortest source -> target path, shown once the run is over
+    bool m_isPathShown;
+    std::string m_querySummary;     // Result line, e.g. settled counts vs plain Dijkstra
+
+    struct QueryResult {
+        int settled;                // Settle operations (a node can be settled from both sides)
+        std::int64_t distance;      // To the target; NO_PATH if unreachable or no target
     };
+    static constexpr std::int64_t NO_PATH = INT64_MAX;
 
-    std::map<int, Node> m_nodes;
-    std::vector<sf::VertexArray> m_edges;
-    std::map<std::pair<int, int>, sf::Text> m_edgeWeights;
-    sf::Font m_font;
-    
-    std::vector<int> m_distances;
-    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> m_pq;
-    std::vector<bool> m_visited;
+    // The run is recorded up front and animated by replaying the trace.
+    // A bidirectional trace holds 2n values: forward distances, then backward
+    // distances at n + node. Node states are flags, as a node can be settled
+    // from both sides.
+    enum NodeMark { UNSETTLED = 0, SETTLED = 1, SETTLED_BACKWARD = 2 };
+    static constexpr const char* TRACE_FILE = "dijkstra.trace";
+    Trace m_trace;
+    TracePlayer m_player;
+
+    HeapKind m_heapKind;    // Priority queue used to record the run; H cycles it
+    HeapKind m_usedHeap;    // The one actually used (radix needs non-negative weights)
+    HeapStats m_heapStats;  // Both queues together for a bidirectional run
 
     bool m_isVisualizing;
     bool m_isDone;
-    sf::Clock m_clock;
-    float m_delay = 0.6f;
 
     void buildGraph();
+    std::string getTraceLabel() const;
+    void recordTrace();
+    template <typename Heap>
+    void recordWith();
+    // The runs fill m_pathEdges; a target of -1 means the full tree, and an
+    // unrecorded run only counts, for comparison
+    template <typename Heap>
+    QueryResult runDijkstra(int source, int target, bool record);
+    template <typename Heap>
+    QueryResult runBidirectional();
+    template <typename Heap>
+    QueryResult runAStar();
+    void addPath(const std::vector<std::size_t>& parentArc, const Graph& graph, int from, int node);
+    void setPathShown(bool shown);
+    sf::Color getEdgeColor(int edge) const;
+    int findNodeAt(sf::Vector2f position) const;
+    void requery();
+    void loadTrace();
 
 public:
-    DijkstraVisualizer(sf::RenderWindow& window);
+    DijkstraVisualizer(sf::RenderWindow* window);
     ~DijkstraVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
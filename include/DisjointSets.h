@@ -0,0 +1,56 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+/**
+ * @class DisjointSets
+ * @brief Union-find with union by rank and path halving.
+ *
+ * Both keep trees shallow (rank alone bounds the depth by log n), and find
+ * is a loop, so long chains cannot overflow the stack. findRoot() does not
+ * compress and writes nothing, so any number of threads may call it while
+ * no thread unites.
+ */
+class DisjointSets {
+private:
+    std::vector<int> m_parent;
+    std::vector<unsigned char> m_rank; // Upper bound on tree height; at most log2(n)
+    int m_setCount;
+
+public:
+    explicit DisjointSets(int count = 0) { reset(count); }
+
+    void reset(int count) {
+        m_parent.resize(count);
+        for (int i = 0; i < count; ++i) m_parent[i] = i;
+        m_rank.assign(count, 0);
+        m_setCount = count;
+    }
+
+    int find(int x) {
+        while (m_parent[x] != x) {
+            m_parent[x] = m_parent[m_parent[x]]; // Halve the path on the way up
+            x = m_parent[x];
+        }
+        return x;
+    }
+
+    int findRoot(int x) const {
+        while (m_parent[x] != x) x = m_parent[x];
+        return x;
+    }
+
+    // Merges the sets of a and b; false if they were already one set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (m_rank[a] < m_rank[b]) std::swap(a, b);
+        m_parent[b] = a;
+        if (m_rank[a] == m_rank[b]) m_rank[a]++;
+        m_setCount--;
+        return true;
+    }
+
+    int getSetCount() const { return m_setCount; }
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+/**
+ * The three phases of one round of blocked Floyd-Warshall. Round r uses the
+ * nodes of block r as intermediates:
+ *   Diagonal   plain Floyd-Warshall inside tile (r, r)
+ *   Panels     the other tiles of block row r and block column r, each
+ *              against the finished diagonal tile
+ *   Remainder  every other tile, a min-plus product of its row-r and
+ *              column-r panel tiles
+ * Tiles within the last two phases are independent and run in parallel.
+ */
+enum class FloydWarshallPhase { Diagonal, Panels, Remainder };
+
+inline const char* floydWarshallPhaseName(FloydWarshallPhase phase) {
+    switch (phase) {
+        case FloydWarshallPhase::Diagonal:  return "diagonal tile";
+        case FloydWarshallPhase::Panels:    return "row and column panels";
+        case FloydWarshallPhase::Remainder: return "remaining tiles";
+    }
+    return "";
+}
+
+/**
+ * @class FloydWarshall
+ * @brief All-pairs shortest paths, blocked for the cache.
+ *
+ * Distances live in one 64-byte aligned row-major buffer whose side is
+ * padded to a multiple of the block size, so a tile is `block` rows of
+ * `block` ints. With 64 x 64 tiles the three tiles a step touches fit in
+ * L2. The inner loop, c[j] = min(c[j], a + b[j]) along a tile row, uses AVX2
+ * when the CPU running the program has it and plain C++ otherwise, checked
+ * at run time (see CpuFeatures.h), so no special build flags are needed.
+ *
+ * INF marks a missing path and is never added to, so real distances only
+ * need to stay below it. Sums are clamped at -INF, so negative cycles
+ * cannot overflow. A negative diagonal entry after the run means a
+ * negative cycle; the other distances are then meaningless.
+ */
+class FloydWarshall {
+private:
+    struct AlignedDelete {
+        void operator()(int* p) const { ::operator delete[](p, std::align_val_t(ALIGNMENT)); }
+    };
+
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    int m_nodeCount;
+    int m_block;
+    int m_stride;       // Padded side of the matrix, a multiple of m_block
+    std::unique_ptr<int[], AlignedDelete> m_dist;
+
+    int* tile(int row, int col) { return m_dist.get() + (static_cast<std::size_t>(row) * m_stride + col) * m_block; }
+    void relaxTile(int* c, const int* a, const int* b) const;
+    void multiplyTile(int* c, const int* a, const int* b) const;
+
+public:
+    static constexpr int INF = INT_MAX / 2;
+    static constexpr int DEFAULT_BLOCK = 64;
+
+    explicit FloydWarshall(int nodeCount, int block = DEFAULT_BLOCK);
+
+    // Keeps the lighter of parallel edges; weights below -INF count as -INF
+    void addEdge(int u, int v, int weight);
+    int getDistance(int u, int v) const { return m_dist[static_cast<std::size_t>(u) * m_stride + v]; }
+
+    int getNodeCount() const { return m_nodeCount; }
+    int getBlock() const { return m_block; }
+    int getBlockCount() const { return m_stride / m_block; }
+
+    // Runs one phase of round `round` with at most `threads` threads (0 = all)
+    void runPhase(int round, FloydWarshallPhase phase, unsigned threads = 0);
+    void run(unsigned threads = 0);
+    bool hasNegativeCycle() const;
+
+    // "AVX2" or "scalar", whichever inner loop runs on this machine
+    static const char* getKernelName();
+};
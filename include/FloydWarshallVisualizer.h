@@ -1,33 +1,90 @@
 #pragma once
 #include "Visualizer.h"
+#include "FloydWarshall.h"
+#include "Graph.h"
+#include "Johnson.h"
+#include "Trace.h"
+#include <memory>
 #include <vector>
 #include <map>
 #include <string>
 #include <SFML/Graphics.hpp>
 
+/**
+ * @class FloydWarshallVisualizer
+ * @brief Steps through blocked Floyd-Warshall one phase at a time.
+ *
+ * Each step runs the diagonal tile, the panels or the remaining tiles of
+ * the current round, and highlights the tiles it touched. Small matrices
+ * show their distances; larger ones (e.g. from --graph) are drawn as the
+ * grid of tiles. T cycles the thread count.
+ *
+ * Runs of up to MAX_TRACED_NODES nodes are also recorded as a Trace: each
+ * phase is one event naming it, then a write per distance it changed, with
+ * a keyframe per round. S saves it, L loads a saved one for this graph and
+ * replays it phase by phase in place of the engine.
+ *
+ * J switches to Johnson's algorithm on the same graph: one step reweights
+ * with Bellman-Ford, then each step runs Dijkstra from a batch of sources
+ * in parallel and fills their rows.
+ */
 class FloydWarshallVisualizer : public Visualizer {
 private:
+    static constexpr int MAX_MATRIX_NODES = 8192; // Larger graphs fall back to the example
+    static constexpr int MAX_SHOWN_NODES = 12;    // Up to this many nodes the distances are shown
+    static constexpr int MAX_TRACED_NODES = 128;  // A keyframe holds the whole matrix
+    static constexpr const char* TRACE_FILE = "floyd_warshall.trace";
+
     int m_nodeCount;
-    std::vector<std::vector<int>> m_distMatrix;
-    sf::Font m_font;
+    std::unique_ptr<FloydWarshall> m_engine;
+    Graph m_graph;                  // The same edges, for Johnson
+    std::unique_ptr<Johnson> m_johnson;
+    bool m_useJohnson;
+    bool m_reweighted;
+    int m_nextSource;               // Johnson: rows below this are filled
+    int m_batchStart;               // Johnson: first row of the last batch
     std::vector<sf::Text> m_matrixText;
+    sf::VertexArray m_tiles;        // Matrices too large for text: 4 vertices per tile, drawn in one call
+
+    // Trace of the whole run; states[0] is round * 3 + phase + 1 of the
+    // last phase, 0 before the first
+    Trace m_trace;
+    TracePlayer m_player;
+    std::vector<std::size_t> m_phaseEnds; // Trace position after each phase
+    bool m_replaying;                     // Distances come from m_player instead of m_engine
+    std::size_t m_replayStep;
 
     bool m_isVisualizing;
     bool m_isDone;
-    int m_k, m_i, m_j; // Loop indices
-
-    sf::Clock m_clock;
-    float m_delay = 0.05f;
+    bool m_negativeCycle;
+    int m_round;
+    FloydWarshallPhase m_phase;     // Next phase to run
+    bool m_hasRun;                  // Whether any phase has run, i.e. there is a last one to show
+    unsigned m_threads;             // 1, 2, 4, ... up to the pool size
+    double m_runMs;                 // Total time of the phases run so far
 
     void buildGraph();
+    void addEdges(FloydWarshall& engine) const;
+    void resetProgress();
+    void recordTrace();
+    void findPhaseEnds();
+    void loadTrace();
+    void advancePhase();
+    bool hasNegativeCycle() const;
     void setupText();
+    int getBatchSize() const;
+    int getDistance(int u, int v) const;
+    sf::Color getTileColor(int row, int col) const;
+    sf::Color getRowColor(int node) const;
+    bool stepJohnson();
 
 public:
-    FloydWarshallVisualizer(sf::RenderWindow& window);
+    FloydWarshallVisualizer(sf::RenderWindow* window);
     ~FloydWarshallVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
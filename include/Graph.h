@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// One input edge. For undirected graphs it is stored as two arcs.
+struct GraphEdge {
+    int from;
+    int to;
+    int weight;
+};
+
+/**
+ * @class Graph
+ * @brief Weighted graph topology in compressed sparse row (CSR) form.
+ *
+ * The outgoing arcs of node u are the index range [arcBegin(u), arcEnd(u)),
+ * and their targets, weights and input edge ids sit in three flat arrays.
+ * Walking a node's neighbours therefore reads consecutive memory, and the
+ * whole graph costs a few words per node plus three ints per arc.
+ *
+ * The graph holds topology only. Positions, colours and labels live with
+ * the visualizer (see GraphRenderer), indexed by node id or by edge id.
+ */
+class Graph {
+private:
+    int m_nodeCount;
+    std::size_t m_edgeCount;
+    bool m_directed;
+    std::vector<std::size_t> m_offsets; // nodeCount + 1 entries
+    std::vector<int> m_targets;
+    std::vector<int> m_weights;
+    std::vector<int> m_edgeIds;         // Input edge each arc came from
+
+public:
+    Graph();
+
+    // Arcs keep the order of `edges` within each node. Undirected graphs get
+    // both u->v and v->u for every edge, sharing its edge id.
+    Graph(int nodeCount, const std::vector<GraphEdge>& edges, bool directed);
+
+    int getNodeCount() const { return m_nodeCount; }
+    std::size_t getEdgeCount() const { return m_edgeCount; }
+    std::size_t getArcCount() const { return m_targets.size(); }
+    bool isDirected() const { return m_directed; }
+
+    std::size_t arcBegin(int node) const { return m_offsets[node]; }
+    std::size_t arcEnd(int node) const { return m_offsets[node + 1]; }
+    std::size_t getDegree(int node) const { return m_offsets[node + 1] - m_offsets[node]; }
+
+    int getTarget(std::size_t arc) const { return m_targets[arc]; }
+    int getWeight(std::size_t arc) const { return m_weights[arc]; }
+    int getEdgeId(std::size_t arc) const { return m_edgeIds[arc]; }
+
+    // The node an arc leaves from; a binary search over the offsets
+    int getSource(std::size_t arc) const;
+
+    // The same edges with every arc turned around, keeping edge ids
+    // (an undirected graph is its own reverse)
+    Graph reversed() const;
+
+    // Id of an edge from -> to, or -1 if there is none; scans from's arcs
+    int findEdgeId(int from, int to) const;
+
+    std::size_t getMemoryBytes() const;
+};
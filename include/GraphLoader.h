@@ -0,0 +1,37 @@
+#pragma once
+#include "Graph.h"
+#include <string>
+#include <vector>
+
+/**
+ * Loading large graphs from disk. The file is memory-mapped and its edge
+ * lines are parsed in parallel chunks on the shared thread pool, so even
+ * road-network-sized files load in seconds.
+ *
+ * Formats, chosen by extension (anything else is read as an edge list):
+ *   .gr    DIMACS shortest-path: "p sp <n> <m>", then "a <u> <v> <w>", 1-based
+ *   .mtx   Matrix Market coordinate: "<i> <j> [value]", 1-based; symmetric
+ *          matrices are undirected, pattern matrices have weight 1
+ *   other  one "<u> <v> [weight]" per line, 0-based, '#' or '%' comments
+ *
+ * Real weights are rounded to the nearest integer.
+ */
+enum class GraphFormat { EdgeList, Dimacs, MatrixMarket };
+
+struct GraphFile {
+    std::string path;
+    GraphFormat format = GraphFormat::EdgeList;
+    int nodeCount = 0;
+    bool directed = true;           // What the file describes; visualizers may ignore it
+    std::vector<GraphEdge> edges;   // In file order
+};
+
+GraphFormat graphFormatForPath(const std::string& path);
+
+// Reads a graph file. Returns false (with a message on stderr) on failure.
+bool loadGraphFile(const std::string& path, GraphFile& file);
+
+// The graph the graph visualizers show in place of their built-in example,
+// e.g. from --graph. nullptr until one is set.
+const GraphFile* getWorkloadGraph();
+bool setWorkloadGraph(const std::string& path);
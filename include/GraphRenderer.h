@@ -0,0 +1,114 @@
+#pragma once
+#include "Graph.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @class GraphRenderer
+ * @brief Draws a whole graph (edges, nodes and labels) in a handful of draw calls.
+ *
+ * All edges share one line buffer, all nodes one buffer of textured circle
+ * quads, and all labels one glyph-quad buffer per character size. State
+ * changes (a node turning green, a distance label changing) only rewrite the
+ * vertices of the element concerned, and where vertex buffers are available
+ * only those vertices are uploaded to the GPU again.
+ *
+ * Building a graph needs no graphics context; textures and glyphs are only
+ * created on the first draw(), so headless runs can use the renderer freely.
+ */
+class GraphRenderer {
+private:
+    // CPU vertices plus an optional GPU copy that is updated per element
+    class Batch {
+    private:
+        std::vector<sf::Vertex> m_vertices;
+        sf::PrimitiveType m_type;
+        std::size_t m_stride;                // Vertices per element
+        sf::VertexBuffer m_buffer;
+        std::vector<std::size_t> m_dirty;    // Elements changed since the last upload
+        std::vector<std::uint8_t> m_isDirty;
+        bool m_allDirty;
+
+    public:
+        Batch(sf::PrimitiveType type, std::size_t stride);
+
+        void clear();
+        std::size_t add(std::size_t count = 1); // Appends zeroed elements, returns the first index
+        std::size_t size() const { return m_vertices.size() / m_stride; }
+        sf::Vertex* element(std::size_t index) { return &m_vertices[index * m_stride]; }
+        void markDirty(std::size_t index);
+        void draw(sf::RenderTarget& target, const sf::RenderStates& states);
+    };
+
+    struct Label {
+        sf::Vector2f position;
+        std::string text;
+        unsigned characterSize;
+        sf::Color color;
+        bool centered;       // Centered on position, otherwise position is the top-left
+        std::size_t first;   // First glyph quad in the batch of its character size
+        std::size_t capacity;
+        bool dirty;
+    };
+
+    float m_radius;
+    float m_outlineThickness;
+    sf::Color m_outlineColor;
+
+    std::vector<sf::Vector2f> m_nodePositions;
+    std::vector<sf::Color> m_nodeColors;
+    std::vector<sf::Color> m_edgeColors;
+    std::vector<Label> m_labels;
+    std::vector<std::size_t> m_dirtyLabels;
+
+    Batch m_edges; // One line per edge
+    Batch m_nodes; // Two quads per node: the outline disc, then the fill disc
+    std::map<unsigned, Batch> m_glyphs;
+
+    sf::Texture m_discTexture;
+    bool m_hasDiscTexture;
+
+    void createDiscTexture();
+    void layoutLabel(Label& label, const sf::Font& font);
+
+public:
+    static constexpr int MAX_LABELLED_NODES = 64;
+    static constexpr std::size_t MAX_LABELLED_EDGES = 128;
+
+    GraphRenderer();
+
+    // Removes every node, edge and label
+    void clear();
+
+    // Node size and outline; affects nodes added afterwards
+    void setNodeStyle(float radius, float outlineThickness = 0.f, sf::Color outlineColor = sf::Color::White);
+
+    // --- Building; each returns the new element's index ---
+    int addNode(sf::Vector2f position, sf::Color color);
+    int addEdge(int from, int to, sf::Color color = sf::Color::White);
+    int addLabel(sf::Vector2f position, const std::string& text, unsigned characterSize,
+                 sf::Color color = sf::Color::White, bool centered = true);
+
+    // Adds a graph without coordinates: nodes on a grid filling `area`, one
+    // line per edge (edge id = renderer edge index when the renderer was
+    // empty). Ids and weights are labelled only on small graphs.
+    void addGraph(int nodeCount, const std::vector<GraphEdge>& edges, sf::FloatRect area, bool weightLabels,
+                  sf::Color nodeColor, sf::Color labelColor = sf::Color::White);
+
+    // --- State changes; no-ops when nothing changes ---
+    void setNodeColor(int node, sf::Color color);
+    void setEdgeColor(int edge, sf::Color color);
+    void setLabelText(int label, const std::string& text);
+
+    sf::Vector2f getNodePosition(int node) const { return m_nodePositions[node]; }
+    float getNodeRadius() const { return m_radius; }
+    std::size_t getNodeCount() const { return m_nodePositions.size(); }
+    std::size_t getEdgeCount() const { return m_edgeColors.size(); }
+
+    // Draws edges, then nodes, then labels
+    void draw(sf::RenderTarget& target, const sf::Font& font);
+};
@@ -1,51 +1,70 @@
 #pragma once
 #include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "BreadthFirstSearch.h"
+#include <memory>
 #include <vector>
 #include <map>
 #include <stack>
-#include <queue>
 #include <string>
 #include <SFML/Graphics.hpp>
 
+/**
+ * @class GraphVisualizer
+ * @brief DFS one node per step, or BFS one level per step.
+ *
+ * BFS runs on the BreadthFirstSearch engine, each level spread over T
+ * threads; M switches between top-down and direction-optimizing. Nodes are
+ * coloured by the direction of the level that reached them, or with W by
+ * the worker thread that did. The HUD compares the arcs a full run
+ * inspects with a plain top-down run and gives its traversed edges per
+ * second.
+ */
 class GraphVisualizer : public Visualizer {
 public:
     enum class TraversalType { DFS, BFS };
 
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-        std::vector<int> adj;
-        enum class State { Unvisited, Visiting, Visited } state = State::Unvisited;
-    };
-
-    std::map<int, Node> m_adjList;
-    std::vector<sf::VertexArray> m_edges;
-    sf::Font m_font;
+    enum class NodeState { Unvisited, Visiting, Visited };
+
+    Graph m_graph;
+    std::vector<NodeState> m_states; // Per node, alongside the renderer's visual state
+    std::vector<char> m_bottomUp;    // BFS, per node: reached by a bottom-up level
+    GraphRenderer m_renderer;
     TraversalType m_traversalType;
     std::string m_traversalName;
 
     // Data structures for traversals
     std::stack<int> m_dfsStack;
-    std::queue<int> m_bfsQueue;
+    BfsMode m_bfsMode;
+    unsigned m_threads;
+    bool m_colorByWorker;
+    std::unique_ptr<BreadthFirstSearch> m_bfs;
+
+    // Full BFS runs, for the HUD
+    double m_engineMs;
+    unsigned long long m_engineInspected;
+    unsigned long long m_topDownInspected;
 
     // State for visualization
     bool m_isVisualizing;
     bool m_isDone;
     int m_componentCheckIndex; // To find next unvisited component
-    sf::Clock m_clock;
-    float m_delay = 0.5f; // seconds
 
     void buildGraph();
     void resetNodeStates();
     bool startNextTraversal();
+    void runEngine();
+    bool stepBfs();
 
 public:
-    GraphVisualizer(sf::RenderWindow& window, TraversalType type);
+    GraphVisualizer(sf::RenderWindow* window, TraversalType type);
     ~GraphVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -0,0 +1,22 @@
+#pragma once
+#include "VisualizerRegistry.h"
+#include <string>
+#include <vector>
+
+/**
+ * Runs registered visualizers without a window: each one is created headless,
+ * started, and stepped to completion as fast as the CPU allows. Prints the
+ * step count and wall time of every run.
+ *
+ * Options (args excludes the program name and "--headless"):
+ *   --filter <text>     only run entries whose name contains <text>
+ *   --max-steps <n>     stop a run after n steps (default 1e9)
+ *   --repeat <n>        run each entry n times and report the best time
+ *   --seed <n>          seed for the generated inputs (random by default)
+ *   --graph <path>      run the graph visualizers on this file (see GraphLoader.h)
+ *   --verbose           keep the visualizers' own console messages
+ *   --list              print the registered names and exit
+ *
+ * Returns the process exit code.
+ */
+int runHeadless(const std::vector<VisualizerEntry>& registry, const std::vector<std::string>& args);
@@ -1,5 +1,6 @@
 #pragma once
 #include "Visualizer.h"
+#include "BarChartRenderer.h"
 #include <vector>
 
 class HeapSortVisualizer : public Visualizer {
@@ -14,15 +15,17 @@ private:
     bool m_isSorting;
     bool m_isSorted;
 
-    void initializeData();
+    BarChartRenderer m_bars;
+
     void startHeapify(int n, int i);
 
 public:
-    HeapSortVisualizer(sf::RenderWindow& window);
+    HeapSortVisualizer(sf::RenderWindow* window);
     ~HeapSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
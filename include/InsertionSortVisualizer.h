@@ -1,5 +1,6 @@
 #pragma once
 #include "Visualizer.h"
+#include "BarChartRenderer.h"
 #include <vector>
 
 class InsertionSortVisualizer : public Visualizer {
@@ -10,14 +11,15 @@ private:
     bool m_isSorting;
     bool m_isSorted;
 
-    void initializeData();
+    BarChartRenderer m_bars;
 
 public:
-    InsertionSortVisualizer(sf::RenderWindow& window);
+    InsertionSortVisualizer(sf::RenderWindow* window);
     ~InsertionSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct JohnsonStats {
+    unsigned long long bellmanFordRelaxations = 0; // 0 when no weight is negative
+    unsigned long long sources = 0;                // Dijkstra runs so far
+    unsigned long long relaxations = 0;            // Arcs examined by those runs
+};
+
+/**
+ * @class Johnson
+ * @brief All-pairs shortest paths for sparse graphs: O(nm log n) rather than
+ * Floyd-Warshall's O(n^3).
+ *
+ * Bellman-Ford from a virtual source with a zero-weight arc to every node
+ * gives each node a potential h, and w(u, v) + h(u) - h(v) is never
+ * negative. Dijkstra then runs from every source under those weights, the
+ * sources spread over the thread pool, and each result is shifted back by
+ * h(v) - h(u). Without negative weights the potentials are all 0 and the
+ * Bellman-Ford run is skipped.
+ *
+ * The matrix uses FloydWarshall::INF for a missing path, so the two engines'
+ * results compare equal.
+ */
+class Johnson {
+private:
+    static constexpr std::size_t GRAIN = 4; // Sources per parallel task
+
+    const Graph& m_graph;
+    std::vector<std::int64_t> m_potential;
+    std::vector<int> m_distances;          // Row-major n x n
+    std::vector<std::size_t> m_cycle;      // Arcs of a negative cycle, if reweighting found one
+    JohnsonStats m_stats;
+
+public:
+    explicit Johnson(const Graph& graph);
+
+    // Computes the potentials. Returns false if the graph has a negative
+    // cycle; its arcs are then in getNegativeCycle().
+    bool reweight();
+
+    // Fills the rows of sources [first, last) with at most `threads` threads
+    // (0 = all). Needs a successful reweight().
+    void runSources(int first, int last, unsigned threads = 0);
+
+    // reweight() followed by every source
+    bool run(unsigned threads = 0);
+
+    int getDistance(int u, int v) const { return m_distances[static_cast<std::size_t>(u) * m_graph.getNodeCount() + v]; }
+    const std::vector<std::int64_t>& getPotentials() const { return m_potential; }
+    const std::vector<std::size_t>& getNegativeCycle() const { return m_cycle; }
+    const JohnsonStats& getStats() const { return m_stats; }
+};
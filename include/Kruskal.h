@@ -0,0 +1,96 @@
+#pragma once
+#include "DisjointSets.h"
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Kruskal variants:
+ *   Sorted  sort every edge, then scan them in order
+ *   Filter  Filter-Kruskal (Osipov, Sanders & Singler): split the edges
+ *           around a pivot weight, solve the light half first, then drop
+ *           heavy edges whose ends are already connected before sorting
+ *           what is left. On dense graphs most edges are dropped unsorted.
+ */
+enum class KruskalMode { Sorted, Filter };
+
+const KruskalMode ALL_KRUSKAL_MODES[] = { KruskalMode::Sorted, KruskalMode::Filter };
+
+inline const char* kruskalModeName(KruskalMode mode) {
+    switch (mode) {
+        case KruskalMode::Sorted: return "sort all edges";
+        case KruskalMode::Filter: return "Filter-Kruskal";
+    }
+    return "";
+}
+
+// What happened to one edge, as recorded for the visualizer
+enum class KruskalOutcome { Added, Rejected, Filtered };
+
+struct KruskalEvent {
+    int edge;
+    KruskalOutcome outcome;
+};
+
+struct KruskalStats {
+    unsigned long long sorted = 0;   // Edges that went through a sort
+    unsigned long long scanned = 0;  // Edges tested against the union-find in order
+    unsigned long long filtered = 0; // Filter mode: edges dropped without sorting
+    std::int64_t treeWeight = 0;
+};
+
+/**
+ * @class Kruskal
+ * @brief Minimum spanning forest of an edge list.
+ *
+ * Each edge becomes one 64-bit key, its weight (sign-flipped, so unsigned
+ * order is weight order) above its index. Sorting the keys sorts the edges
+ * by weight, ties by index, without moving the 12-byte edges themselves.
+ * Keys are sorted by a parallel LSD radix sort that skips the bytes every
+ * key shares, which with small weights and ids is most of them.
+ *
+ * Union-find uses rank and an iterative find (see DisjointSets). The filter
+ * step runs in parallel, with read-only finds. The run stops once the tree
+ * has n - 1 edges. Edge ids are ints, so there must be fewer than 2^31
+ * edges; the constructor asserts it.
+ */
+class Kruskal {
+private:
+    static constexpr std::size_t PARALLEL_MIN = 1 << 16; // Smaller ranges are sorted and filtered serially
+
+    int m_nodeCount;
+    const std::vector<GraphEdge>& m_edges;
+    std::size_t m_baseCase;
+    DisjointSets m_sets;
+    std::vector<int> m_tree;               // Edge ids, in the order they were added
+    std::vector<KruskalEvent>* m_events;   // Where to record, or nullptr
+    unsigned m_threads;
+    KruskalStats m_stats;
+
+    bool isTreeComplete() const { return static_cast<int>(m_tree.size()) + 1 >= m_nodeCount; }
+    void scan(const std::uint64_t* keys, std::size_t count);
+    void filterKruskal(std::uint64_t* first, std::uint64_t* last);
+    std::size_t filter(std::uint64_t* keys, std::size_t count);
+
+public:
+    static constexpr std::size_t DEFAULT_BASE_CASE = 1 << 14; // Filter mode: ranges this small are just sorted
+
+    Kruskal(int nodeCount, const std::vector<GraphEdge>& edges);
+
+    static std::uint64_t packKey(int weight, std::uint32_t edge) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(weight) ^ 0x80000000u) << 32) | edge;
+    }
+    static int keyEdge(std::uint64_t key) { return static_cast<int>(key & 0xffffffffu); }
+
+    // Parallel LSD radix sort over at most `threads` threads (0 = all)
+    static void sortKeys(std::uint64_t* keys, std::size_t count, unsigned threads = 0);
+
+    void setBaseCase(std::size_t edges) { m_baseCase = edges > 0 ? edges : 1; }
+
+    // Builds the forest, recording every edge's outcome into events if given
+    void run(KruskalMode mode, unsigned threads = 0, std::vector<KruskalEvent>* events = nullptr);
+
+    const std::vector<int>& getTreeEdges() const { return m_tree; }
+    const KruskalStats& getStats() const { return m_stats; }
+};
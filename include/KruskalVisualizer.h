@@ -1,49 +1,53 @@
 #pragma once
 #include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "Kruskal.h"
+#include <memory>
 #include <vector>
 #include <map>
-#include <tuple>
 #include <string>
 #include <SFML/Graphics.hpp>
 
+/**
+ * @class KruskalVisualizer
+ * @brief Replays a Kruskal run edge by edge.
+ *
+ * The Kruskal engine records what happened to each edge: added to the
+ * tree, rejected as closing a cycle, or (in Filter-Kruskal mode) dropped
+ * by a filter step without ever being sorted. M switches the mode; the HUD
+ * shows the time and counts of a full unrecorded run.
+ */
 class KruskalVisualizer : public Visualizer {
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-    };
-    
-    struct Edge {
-        int u, v, weight;
-        bool inMst = false;
-        bool isBeingTested = false;
-    };
+    static constexpr std::size_t MAX_RECORDED_EDGES = 1 << 22; // Larger graphs are only timed
 
-    std::map<int, Node> m_nodes;
-    std::vector<Edge> m_edges;
-    std::map<std::pair<int, int>, sf::Text> m_edgeWeights;
-    sf::Font m_font;
-    
-    // DSU structure
-    std::vector<int> m_parent;
-    int findSet(int i);
-    void unionSets(int i, int j);
+    // Kruskal only needs the edge list; edge i is renderer edge i
+    int m_nodeCount;
+    std::vector<GraphEdge> m_edges;
+    GraphRenderer m_renderer;
+
+    KruskalMode m_mode;
+    std::unique_ptr<Kruskal> m_engine;
+    double m_engineMs;
+    std::vector<KruskalEvent> m_events;
+    std::size_t m_eventIndex;       // Events replayed so far
+    std::vector<int> m_edgeState;   // Per edge: -1 untouched, else the KruskalOutcome replayed for it
+    int m_testedEdge;
 
     bool m_isVisualizing;
     bool m_isDone;
-    int m_edgeIndex;
-
-    sf::Clock m_clock;
-    float m_delay = 1.0f;
 
     void buildGraph();
+    void runEngine();
 
 public:
-    KruskalVisualizer(sf::RenderWindow& window);
+    KruskalVisualizer(sf::RenderWindow* window);
     ~KruskalVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
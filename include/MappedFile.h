@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * Opening is O(1) regardless of the file size; pages are read from disk by
+ * the OS only when they are first touched. Uses mmap on POSIX systems and a
+ * file mapping object on Windows.
+ */
+class MappedFile {
+private:
+    const std::uint8_t* m_data;
+    std::size_t m_size;
+#ifdef _WIN32
+    void* m_file;    // HANDLE
+    void* m_mapping; // HANDLE
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps the file, replacing any previous mapping. Returns false on failure.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const std::uint8_t* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+};
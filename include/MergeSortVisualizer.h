@@ -1,5 +1,6 @@
 #pragma once
 #include "Visualizer.h"
+#include "BarChartRenderer.h"
 #include <vector>
 
 class MergeSortVisualizer : public Visualizer {
@@ -16,14 +17,15 @@ private:
     enum class State { IDLE, MERGING, DONE } m_state;
     bool m_isSorting;
 
-    void initializeData();
+    BarChartRenderer m_bars;
 
 public:
-    MergeSortVisualizer(sf::RenderWindow& window);
+    MergeSortVisualizer(sf::RenderWindow* window);
     ~MergeSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -1,5 +1,10 @@
 #pragma once
 #include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "Prim.h"
+#include "PriorityQueues.h"
+#include <memory>
 #include <vector>
 #include <map>
 #include <queue>
@@ -8,36 +13,42 @@
 
 class PrimsVisualizer : public Visualizer {
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-        std::vector<std::pair<int, int>> adj; // {neighbor, weight}
-    };
-
-    std::map<int, Node> m_nodes;
-    std::map<std::pair<int, int>, sf::Text> m_edgeWeights;
-    sf::Font m_font;
+    Graph m_graph;              // Edge ids double as renderer edge indices
+    GraphRenderer m_renderer;
     
-    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>, std::greater<std::tuple<int, int, int>>> m_pq; // {weight, u, v}
+    // Nodes outside the tree, keyed by their lightest edge into it. Prim's
+    // keys are not monotone, so the radix heap is not an option here.
+    HeapKind m_heapKind;          // Lazy or FourAry; H cycles through both, then the array scan
+    bool m_useArrayScan;          // Dense Prim: scan m_scanKeys instead of using a heap
+    LazyHeap m_lazyHeap;
+    IndexedDaryHeap<4> m_fourAryHeap;
+    std::vector<int> m_scanKeys;  // Per node: m_bestWeight, or INT_MAX once in the tree
+    std::vector<int> m_bestWeight; // Per node: lightest edge weight into the tree so far
+    std::vector<std::size_t> m_parentArc; // Per node: the arc with that weight
     std::vector<bool> m_inMst;
-    std::vector<std::pair<int,int>> m_mstEdges;
+    std::vector<int> m_mstEdges; // Edge ids
+
+    std::unique_ptr<Prim> m_engine; // Full run with automatic selection, for the HUD
+    double m_engineMs;
 
     bool m_isVisualizing;
     bool m_isDone;
     int m_currentNode;
 
-    sf::Clock m_clock;
-    float m_delay = 1.0f;
 
     void buildGraph();
+    void startFrom(int root);
     void addEdges(int u);
+    const HeapStats& getHeapStats() const;
+    void runEngine();
 
 public:
-    PrimsVisualizer(sf::RenderWindow& window);
+    PrimsVisualizer(sf::RenderWindow* window);
     ~PrimsVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -0,0 +1,290 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+ * Priority queues keyed by node id, for Dijkstra and Prim.
+ *
+ * Every queue has the same interface, so an algorithm can be written once as
+ * a template over the queue type:
+ *   queue.update(node, key)   insert node, or lower its key if it is queued
+ *   queue.pop(node, key)      remove a node with the smallest key; false if empty
+ *   queue.peekKey(key)        the smallest key without removing it; false if empty
+ *   queue.size()              nodes (or, for LazyHeap, entries) queued
+ *   queue.getStats()          operation counts since construction
+ * A node must not be updated again after it has been popped.
+ */
+enum class HeapKind { Lazy, FourAry, Radix };
+
+const HeapKind ALL_HEAP_KINDS[] = { HeapKind::Lazy, HeapKind::FourAry, HeapKind::Radix };
+
+inline const char* heapKindName(HeapKind kind) {
+    switch (kind) {
+        case HeapKind::Lazy:    return "lazy binary heap";
+        case HeapKind::FourAry: return "indexed 4-ary heap";
+        case HeapKind::Radix:   return "radix heap";
+    }
+    return "";
+}
+
+struct HeapStats {
+    unsigned long long pushes = 0;       // New entries
+    unsigned long long decreaseKeys = 0; // Keys lowered in place
+    unsigned long long pops = 0;         // Nodes handed out
+    unsigned long long stalePops = 0;    // LazyHeap: outdated entries thrown away
+    std::size_t maxSize = 0;             // Largest size() reached
+};
+
+/**
+ * @class LazyHeap
+ * @brief std::priority_queue that pushes a new entry instead of decreasing a
+ * key and skips the outdated ones on pop. Can grow to one entry per edge.
+ */
+class LazyHeap {
+private:
+    using Entry = std::pair<std::int64_t, int>; // {key, node}
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_queue;
+    std::vector<std::int64_t> m_best; // Smallest key pushed per node
+    std::vector<bool> m_queued;
+    HeapStats m_stats;
+
+public:
+    explicit LazyHeap(int nodeCount) : m_best(nodeCount), m_queued(nodeCount, false) {}
+
+    void update(int node, std::int64_t key) {
+        if (m_queued[node] && key >= m_best[node]) return;
+        if (m_queued[node]) m_stats.decreaseKeys++; // Logically; physically another push
+        m_queued[node] = true;
+        m_best[node] = key;
+        m_queue.push({key, node});
+        m_stats.pushes++;
+        if (m_queue.size() > m_stats.maxSize) m_stats.maxSize = m_queue.size();
+    }
+
+    bool pop(int& node, std::int64_t& key) {
+        if (!peekKey(key)) return false;
+        node = m_queue.top().second;
+        m_queue.pop();
+        m_queued[node] = false;
+        m_stats.pops++;
+        return true;
+    }
+
+    // Drops outdated entries from the top until a current one is there
+    bool peekKey(std::int64_t& key) {
+        while (!m_queue.empty()) {
+            const Entry& top = m_queue.top();
+            if (m_queued[top.second] && top.first == m_best[top.second]) {
+                key = top.first;
+                return true;
+            }
+            m_queue.pop();
+            m_stats.stalePops++;
+        }
+        return false;
+    }
+
+    std::size_t size() const { return m_queue.size(); }
+    const HeapStats& getStats() const { return m_stats; }
+};
+
+/**
+ * @class IndexedDaryHeap
+ * @brief Array heap with D children per slot and a node -> slot index, so a
+ * key is lowered in place. Holds at most one entry per node.
+ *
+ * Keys and nodes sit in parallel arrays; D = 4 keeps a slot's children in
+ * one cache line and halves the depth of a binary heap.
+ */
+template <int D = 4>
+class IndexedDaryHeap {
+private:
+    std::vector<std::int64_t> m_keys; // By slot
+    std::vector<int> m_nodes;         // By slot
+    std::vector<int> m_slot;          // By node; -1 when not queued
+    HeapStats m_stats;
+
+    void place(std::size_t slot, std::int64_t key, int node) {
+        m_keys[slot] = key;
+        m_nodes[slot] = node;
+        m_slot[node] = static_cast<int>(slot);
+    }
+
+    void siftUp(std::size_t slot, std::int64_t key, int node) {
+        while (slot > 0) {
+            std::size_t parent = (slot - 1) / D;
+            if (m_keys[parent] <= key) break;
+            place(slot, m_keys[parent], m_nodes[parent]);
+            slot = parent;
+        }
+        place(slot, key, node);
+    }
+
+    void siftDown(std::size_t slot, std::int64_t key, int node) {
+        const std::size_t n = m_keys.size();
+        while (true) {
+            std::size_t first = slot * D + 1;
+            if (first >= n) break;
+            std::size_t last = first + D < n ? first + D : n;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child) {
+                if (m_keys[child] < m_keys[best]) best = child;
+            }
+            if (m_keys[best] >= key) break;
+            place(slot, m_keys[best], m_nodes[best]);
+            slot = best;
+        }
+        place(slot, key, node);
+    }
+
+public:
+    explicit IndexedDaryHeap(int nodeCount) : m_slot(nodeCount, -1) {}
+
+    void update(int node, std::int64_t key) {
+        int slot = m_slot[node];
+        if (slot < 0) {
+            m_keys.push_back(key);
+            m_nodes.push_back(node);
+            siftUp(m_keys.size() - 1, key, node);
+            m_stats.pushes++;
+            if (m_keys.size() > m_stats.maxSize) m_stats.maxSize = m_keys.size();
+        } else if (key < m_keys[slot]) {
+            siftUp(slot, key, node);
+            m_stats.decreaseKeys++;
+        }
+    }
+
+    bool pop(int& node, std::int64_t& key) {
+        if (m_keys.empty()) return false;
+        key = m_keys[0];
+        node = m_nodes[0];
+        m_slot[node] = -1;
+        std::int64_t lastKey = m_keys.back();
+        int lastNode = m_nodes.back();
+        m_keys.pop_back();
+        m_nodes.pop_back();
+        if (!m_keys.empty()) siftDown(0, lastKey, lastNode);
+        m_stats.pops++;
+        return true;
+    }
+
+    bool peekKey(std::int64_t& key) const {
+        if (m_keys.empty()) return false;
+        key = m_keys[0];
+        return true;
+    }
+
+    std::size_t size() const { return m_keys.size(); }
+    const HeapStats& getStats() const { return m_stats; }
+};
+
+/**
+ * @class RadixHeap
+ * @brief Monotone integer priority queue: bucket b holds keys whose highest
+ * bit differing from the last popped key is bit b - 1.
+ *
+ * Keys must be non-negative and never below the last popped key, which holds
+ * for Dijkstra with non-negative integer weights. Each entry moves to a lower
+ * bucket at most 64 times, so a pop costs O(log C) amortized for keys up to C.
+ * Decreasing a key moves its entry between buckets in O(1).
+ */
+class RadixHeap {
+private:
+    static constexpr int BUCKETS = 65;
+
+    struct Entry {
+        std::uint64_t key;
+        int node;
+    };
+
+    std::vector<Entry> m_buckets[BUCKETS];
+    std::vector<int> m_bucket;           // By node; -1 when not queued
+    std::vector<std::uint32_t> m_index;  // By node: position within its bucket
+    std::uint64_t m_last;
+    std::size_t m_size;
+    HeapStats m_stats;
+
+    static int bitWidth(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return x == 0 ? 0 : 64 - __builtin_clzll(x);
+#else
+        int width = 0;
+        while (x) { x >>= 1; ++width; }
+        return width;
+#endif
+    }
+
+    void insert(std::uint64_t key, int node) {
+        int bucket = bitWidth(key ^ m_last);
+        m_bucket[node] = bucket;
+        m_index[node] = static_cast<std::uint32_t>(m_buckets[bucket].size());
+        m_buckets[bucket].push_back({key, node});
+    }
+
+    // Makes bucket 0 non-empty: every entry of the first non-empty bucket
+    // moves to a lower bucket relative to the new minimum
+    void refill() {
+        int b = 1;
+        while (m_buckets[b].empty()) ++b;
+        std::vector<Entry> entries;
+        entries.swap(m_buckets[b]);
+        m_last = entries[0].key;
+        for (const Entry& entry : entries) m_last = entry.key < m_last ? entry.key : m_last;
+        for (const Entry& entry : entries) insert(entry.key, entry.node);
+        entries.clear();
+        m_buckets[b].swap(entries); // Keep the capacity
+    }
+
+    void remove(int node) {
+        std::vector<Entry>& bucket = m_buckets[m_bucket[node]];
+        Entry moved = bucket.back();
+        bucket[m_index[node]] = moved;
+        m_index[moved.node] = m_index[node];
+        bucket.pop_back();
+        m_bucket[node] = -1;
+    }
+
+public:
+    explicit RadixHeap(int nodeCount) : m_bucket(nodeCount, -1), m_index(nodeCount, 0), m_last(0), m_size(0) {}
+
+    void update(int node, std::int64_t key) {
+        std::uint64_t k = static_cast<std::uint64_t>(key);
+        if (m_bucket[node] >= 0) {
+            if (k >= m_buckets[m_bucket[node]][m_index[node]].key) return;
+            remove(node);
+            m_stats.decreaseKeys++;
+        } else {
+            m_size++;
+            m_stats.pushes++;
+            if (m_size > m_stats.maxSize) m_stats.maxSize = m_size;
+        }
+        insert(k, node);
+    }
+
+    bool pop(int& node, std::int64_t& key) {
+        if (m_size == 0) return false;
+        if (m_buckets[0].empty()) refill();
+        Entry entry = m_buckets[0].back();
+        m_buckets[0].pop_back();
+        m_bucket[entry.node] = -1;
+        m_size--;
+        node = entry.node;
+        key = static_cast<std::int64_t>(entry.key);
+        m_stats.pops++;
+        return true;
+    }
+
+    bool peekKey(std::int64_t& key) {
+        if (m_size == 0) return false;
+        if (m_buckets[0].empty()) refill();
+        key = static_cast<std::int64_t>(m_last);
+        return true;
+    }
+
+    std::size_t size() const { return m_size; }
+    const HeapStats& getStats() const { return m_stats; }
+};
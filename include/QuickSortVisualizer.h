@@ -1,5 +1,6 @@
 #pragma once
 #include "Visualizer.h"
+#include "BarChartRenderer.h"
 #include <vector>
 #include <stack>
 #include <utility> // For std::pair
@@ -19,14 +20,15 @@ private:
     enum class State { IDLE, PARTITIONING, DONE } m_state;
     bool m_isSorting;
 
-    void initializeData();
+    BarChartRenderer m_bars;
 
 public:
-    QuickSortVisualizer(sf::RenderWindow& window);
+    QuickSortVisualizer(sf::RenderWindow* window);
     ~QuickSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class ResourceManager
+ * @brief A process-wide cache for fonts and textures.
+ *
+ * Every resource is loaded from disk at most once and then shared by
+ * reference, so visualizers can be created and drawn without touching the
+ * file system. References stay valid for the lifetime of the program.
+ */
+class ResourceManager {
+private:
+    std::map<std::string, std::unique_ptr<sf::Font>> m_fonts;
+    std::map<std::string, std::unique_ptr<sf::Texture>> m_textures;
+
+    ResourceManager() = default;
+
+public:
+    static constexpr const char* DEFAULT_FONT = "assets/arial.ttf";
+
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    static ResourceManager& getInstance();
+
+    // Loads (or finds) a font and reports whether it is usable
+    bool loadFont(const std::string& path = DEFAULT_FONT);
+
+    // Returns the cached font, loading it on first use. A font that failed to
+    // load is still returned (empty) so callers never dereference null.
+    const sf::Font& getFont(const std::string& path = DEFAULT_FONT);
+
+    // Returns the cached texture, loading it on first use
+    const sf::Texture& getTexture(const std::string& path);
+
+    // Rasterizes the printable ASCII glyphs of a font at the given sizes so
+    // that HUD text does not populate glyph pages in the middle of a frame.
+    // Needs an active rendering context (i.e. call after creating the window).
+    void prewarmGlyphs(const sf::Font& font, const std::vector<unsigned int>& characterSizes, bool bold = false);
+};
@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Native implementations of the sorting algorithms shown by the sort
+ * visualizers, written as plain loops so they run at full speed.
+ *
+ * Every engine reports its operations to a Sink with three methods:
+ *   sink.compare(i, j)      elements i and j are compared
+ *   sink.swap(i, j)         elements i and j are exchanged
+ *   sink.write(i, newValue) element i is overwritten
+ * A Trace records them for playback; a counter can simply tally them.
+ * Each engine follows the same variant as its step-by-step visualizer, so a
+ * recorded run shows exactly what the live visualizer would.
+ */
+enum class SortAlgorithm { Bubble, Selection, Insertion, Merge, Quick, Heap };
+
+const SortAlgorithm ALL_SORT_ALGORITHMS[] = {
+    SortAlgorithm::Bubble, SortAlgorithm::Selection, SortAlgorithm::Insertion,
+    SortAlgorithm::Merge, SortAlgorithm::Quick, SortAlgorithm::Heap
+};
+
+inline std::string sortAlgorithmName(SortAlgorithm algorithm) {
+    switch (algorithm) {
+        case SortAlgorithm::Bubble:    return "Bubble Sort";
+        case SortAlgorithm::Selection: return "Selection Sort";
+        case SortAlgorithm::Insertion: return "Insertion Sort";
+        case SortAlgorithm::Merge:     return "Merge Sort";
+        case SortAlgorithm::Quick:     return "Quick Sort";
+        case SortAlgorithm::Heap:      return "Heap Sort";
+    }
+    return "";
+}
+
+// True for the O(n^2) algorithms, which callers cap at smaller inputs
+inline bool isQuadraticSort(SortAlgorithm algorithm) {
+    return algorithm == SortAlgorithm::Bubble || algorithm == SortAlgorithm::Selection ||
+           algorithm == SortAlgorithm::Insertion;
+}
+
+// Sink that only tallies the operations
+struct OperationCounter {
+    unsigned long long comparisons = 0;
+    unsigned long long swaps = 0;
+    unsigned long long writes = 0;
+
+    void compare(int, int) { ++comparisons; }
+    void swap(int, int) { ++swaps; }
+    template <typename T>
+    void write(int, const T&) { ++writes; }
+};
+
+template <typename T, typename Sink>
+void bubbleSortEngine(std::vector<T>& data, Sink& sink) {
+    const int n = static_cast<int>(data.size());
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n - i - 1; ++j) {
+            sink.compare(j, j + 1);
+            if (data[j] > data[j + 1]) {
+                std::swap(data[j], data[j + 1]);
+                sink.swap(j, j + 1);
+            }
+        }
+    }
+}
+
+template <typename T, typename Sink>
+void selectionSortEngine(std::vector<T>& data, Sink& sink) {
+    const int n = static_cast<int>(data.size());
+    for (int i = 0; i < n - 1; ++i) {
+        int minIndex = i;
+        for (int j = i + 1; j < n; ++j) {
+            sink.compare(j, minIndex);
+            if (data[j] < data[minIndex]) minIndex = j;
+        }
+        std::swap(data[minIndex], data[i]);
+        sink.swap(minIndex, i);
+    }
+}
+
+template <typename T, typename Sink>
+void insertionSortEngine(std::vector<T>& data, Sink& sink) {
+    const int n = static_cast<int>(data.size());
+    for (int i = 1; i < n; ++i) {
+        T key = data[i];
+        int j = i - 1;
+        while (j >= 0) {
+            sink.compare(j, i);
+            if (!(data[j] > key)) break;
+            sink.write(j + 1, data[j]);
+            data[j + 1] = data[j];
+            --j;
+        }
+        sink.write(j + 1, key);
+        data[j + 1] = key;
+    }
+}
+
+// Bottom-up merge sort with an auxiliary copy of each merged range
+template <typename T, typename Sink>
+void mergeSortEngine(std::vector<T>& data, Sink& sink) {
+    const int n = static_cast<int>(data.size());
+    std::vector<T> aux(data.size());
+    for (int size = 1; size < n; size *= 2) {
+        for (int left = 0; left < n; left += 2 * size) {
+            int mid = std::min(left + size - 1, n - 1);
+            int right = std::min(left + 2 * size - 1, n - 1);
+            std::copy(data.begin() + left, data.begin() + right + 1, aux.begin() + left);
+
+            int i = left, j = mid + 1, k = left;
+            while (i <= mid && j <= right) {
+                sink.compare(i, j);
+                const T& next = (aux[i] <= aux[j]) ? aux[i++] : aux[j++];
+                sink.write(k, next);
+                data[k++] = next;
+            }
+            while (i <= mid) { sink.write(k, aux[i]); data[k++] = aux[i++]; }
+            while (j <= right) { sink.write(k, aux[j]); data[k++] = aux[j++]; }
+        }
+    }
+}
+
+// Lomuto partitioning with the last element as pivot and an explicit stack
+template <typename T, typename Sink>
+void quickSortEngine(std::vector<T>& data, Sink& sink) {
+    std::vector<std::pair<int, int>> stack;
+    stack.push_back({0, static_cast<int>(data.size()) - 1});
+    while (!stack.empty()) {
+        auto [low, high] = stack.back();
+        stack.pop_back();
+        if (low >= high) continue;
+
+        T pivot = data[high];
+        int p = low;
+        for (int j = low; j < high; ++j) {
+            sink.compare(j, high);
+            if (data[j] < pivot) {
+                if (p != j) {
+                    std::swap(data[p], data[j]);
+                    sink.swap(p, j);
+                }
+                ++p;
+            }
+        }
+        if (p != high) {
+            std::swap(data[p], data[high]);
+            sink.swap(p, high);
+        }
+        if (p + 1 < high) stack.push_back({p + 1, high});
+        if (low < p - 1) stack.push_back({low, p - 1});
+    }
+}
+
+template <typename T, typename Sink>
+void siftDownEngine(std::vector<T>& data, int heapSize, int root, Sink& sink) {
+    while (true) {
+        int largest = root;
+        int l = 2 * root + 1;
+        int r = 2 * root + 2;
+        if (l < heapSize) {
+            sink.compare(l, largest);
+            if (data[l] > data[largest]) largest = l;
+        }
+        if (r < heapSize) {
+            sink.compare(r, largest);
+            if (data[r] > data[largest]) largest = r;
+        }
+        if (largest == root) return;
+        std::swap(data[root], data[largest]);
+        sink.swap(root, largest);
+        root = largest;
+    }
+}
+
+template <typename T, typename Sink>
+void heapSortEngine(std::vector<T>& data, Sink& sink) {
+    const int n = static_cast<int>(data.size());
+    for (int i = n / 2 - 1; i >= 0; --i) siftDownEngine(data, n, i, sink);
+    for (int heapSize = n; heapSize > 1; --heapSize) {
+        std::swap(data[0], data[heapSize - 1]);
+        sink.swap(0, heapSize - 1);
+        siftDownEngine(data, heapSize - 1, 0, sink);
+    }
+}
+
+template <typename T, typename Sink>
+void runSortEngine(SortAlgorithm algorithm, std::vector<T>& data, Sink& sink) {
+    switch (algorithm) {
+        case SortAlgorithm::Bubble:    bubbleSortEngine(data, sink); break;
+        case SortAlgorithm::Selection: selectionSortEngine(data, sink); break;
+        case SortAlgorithm::Insertion: insertionSortEngine(data, sink); break;
+        case SortAlgorithm::Merge:     mergeSortEngine(data, sink); break;
+        case SortAlgorithm::Quick:     quickSortEngine(data, sink); break;
+        case SortAlgorithm::Heap:      heapSortEngine(data, sink); break;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Visualizer.h"
+#include "BarChartRenderer.h"
+#include "SortEngines.h"
+#include "Trace.h"
+#include <vector>
+
+/**
+ * @class SortTraceVisualizer
+ * @brief Records a sort at native speed, then animates the recorded trace.
+ *
+ * Unlike the step-by-step sort visualizers, the algorithm cost is paid once
+ * when the trace is recorded. Playback can run at any speed, in reverse, one
+ * event at a time, or jump anywhere by scrubbing the timeline. Traces can be
+ * saved to and loaded from a file, so long runs only need recording once.
+ */
+class SortTraceVisualizer : public Visualizer {
+private:
+    SortAlgorithm m_algorithm;
+    int m_elementCount;
+    Trace m_trace;
+    TracePlayer m_player;
+    BarChartRenderer m_bars;
+
+    bool m_isPlaying;
+    bool m_isReversed;
+    bool m_isScrubbing;
+    bool m_isLoaded;       // Playing a trace file rather than a fresh recording
+    double m_recordMillis; // Wall time of the native run
+
+    void record();
+    void saveTrace();
+    void loadTrace();
+    int getMaxElementCount() const;
+    sf::FloatRect getTimelineRect() const;
+    void scrubTo(float x);
+
+public:
+    SortTraceVisualizer(sf::RenderWindow* window);
+    ~SortTraceVisualizer() override = default;
+
+    void handleEvent(sf::Event& event) override;
+    bool step() override;
+    void draw() override;
+    void reset() override;
+    void start() override;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/**
+ * @class StepScheduler
+ * @brief Decides how many algorithm steps a visualizer runs each frame.
+ *
+ * The scheduler converts a target speed (steps per second) into a number of
+ * steps for the current frame, independent of the frame rate. Steps are also
+ * capped by a per-frame time budget, so "run to completion" finishes as fast
+ * as possible while the window keeps rendering at full frame rate.
+ */
+class StepScheduler {
+private:
+    double m_stepsPerSecond;
+    bool m_unbounded;        // Run as many steps as fit in the frame budget
+    double m_pendingSteps;   // Fractional steps carried over between frames
+    sf::Time m_frameBudget;  // Maximum time spent stepping per frame
+    sf::Clock m_frameClock;
+
+public:
+    static constexpr double MIN_STEPS_PER_SECOND = 0.1;
+
+    explicit StepScheduler(double stepsPerSecond = 60.0);
+
+    void setStepsPerSecond(double stepsPerSecond);
+    double getStepsPerSecond() const { return m_stepsPerSecond; }
+    void setUnbounded(bool unbounded);
+    bool isUnbounded() const { return m_unbounded; }
+    void setFrameBudget(sf::Time budget) { m_frameBudget = budget; }
+
+    // Move to the next faster/slower preset speed
+    void faster();
+    void slower();
+
+    // Handles the speed keys: +/- change speed, F toggles run-to-completion
+    void handleEvent(const sf::Event& event);
+
+    // Human readable speed, e.g. "60 steps/s" or "max"
+    std::string getSpeedLabel() const;
+
+    // Calls step() as often as this frame allows. step() returns false when
+    // the algorithm is paused or finished. Returns the number of steps run.
+    std::size_t run(const std::function<bool()>& step);
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads shared by every parallel algorithm.
+ *
+ * Threads are started once and reused, so parallel loops cost a wake-up
+ * rather than a thread creation. The calling thread always takes part in its
+ * own loop, which keeps nested parallelFor calls from deadlocking.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping;
+
+    void workerLoop(unsigned index);
+    void submit(std::function<void()> task);
+
+public:
+    // Creates `threadCount - 1` workers; the caller is the remaining thread
+    explicit ThreadPool(unsigned threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The process-wide pool, sized to the hardware
+    static ThreadPool& getInstance();
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_threads.size()) + 1; }
+
+    // Which thread is running: 1 to getThreadCount() - 1 inside a worker,
+    // 0 on any thread outside the pool (such as the one calling parallelFor)
+    static unsigned getWorkerIndex();
+
+    // Splits [0, count) into chunks of `grain` indices and runs body(begin, end)
+    // on each, spread over at most `maxThreads` threads (0 = all). Returns once
+    // every chunk is done.
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body, unsigned maxThreads = 0);
+};
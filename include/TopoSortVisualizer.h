@@ -1,51 +1,60 @@
 #pragma once
 #include "Visualizer.h"
+#include "Graph.h"
+#include "GraphRenderer.h"
+#include "TopologicalSort.h"
+#include <memory>
 #include <vector>
 #include <map>
-#include <stack>
-#include <queue>
 #include <string>
 #include <SFML/Graphics.hpp>
 
+/**
+ * @class TopoSortVisualizer
+ * @brief Steps a TopologicalSort: one DFS push or finish, or one Kahn wave, per step.
+ *
+ * DFS mode shows the stack in yellow and finished nodes in green. Kahn's
+ * mode shows the wave about to be expanded in yellow and colours every
+ * expanded wave by its index, so the wavefronts stay apart. When the graph
+ * has a cycle, both modes stop on it and draw it in red. C adds an arc
+ * that closes a cycle in the example, T changes the thread count.
+ */
 class TopoSortVisualizer : public Visualizer {
 public:
     enum class AlgoType { DFS_BASED, KAHN };
 
 private:
-    struct Node {
-        sf::CircleShape shape;
-        sf::Text label;
-        std::vector<int> adj;
-        enum class State { Unvisited, Visiting, Visited } state = State::Unvisited;
-    };
-
-    std::map<int, Node> m_adjList;
-    std::vector<sf::VertexArray> m_edges;
-    sf::Font m_font;
+    static constexpr int MAX_LISTED_NODES = 64; // Larger orders are only counted in the HUD
+
+    Graph m_graph;
+    GraphRenderer m_renderer;
     AlgoType m_algoType;
+    TopoMode m_mode;
     std::string m_algoName;
+    bool m_withCycle;
 
-    // Data structures for algorithms
-    std::vector<int> m_inDegree;
-    std::stack<int> m_dfsStack;
-    std::queue<int> m_kahnQueue;
-    std::vector<int> m_sortedResult;
+    unsigned m_threads;
+    double m_engineMs;
+    TopoStats m_engineStats;
+    std::unique_ptr<TopologicalSort> m_sort;
 
     bool m_isVisualizing;
     bool m_isDone;
-    sf::Clock m_clock;
-    float m_delay = 0.8f;
 
     void buildGraph();
-    void resetNodeStates();
-    void dfs(int u);
+    void runEngine();
+    void paintWave(std::size_t wave, sf::Color color);
+    void paintStep(std::size_t sortedBefore);
+    void paintCycle();
+    std::string getOrderText() const;
 
 public:
-    TopoSortVisualizer(sf::RenderWindow& window, AlgoType type);
+    TopoSortVisualizer(sf::RenderWindow* window, AlgoType type);
     ~TopoSortVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
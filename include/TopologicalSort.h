@@ -0,0 +1,116 @@
+#pragma once
+#include "Graph.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Topological sort variants:
+ *   DepthFirst  reverse finishing order of a DFS on an explicit stack
+ *   Kahn        level by level: every node whose in-degree drops to zero
+ *               joins the next wave, and each wave is expanded in parallel
+ */
+enum class TopoMode { DepthFirst, Kahn };
+
+inline const char* topoModeName(TopoMode mode) {
+    switch (mode) {
+        case TopoMode::DepthFirst: return "depth-first";
+        case TopoMode::Kahn:       return "Kahn's";
+    }
+    return "";
+}
+
+// Where a node stands in the depth-first mode
+enum class TopoState : unsigned char { Unvisited, Active, Done };
+
+struct TopoStats {
+    int sorted = 0;
+    int waves = 0;         // Kahn
+    int widestWave = 0;    // Kahn
+    int deepestStack = 0;  // DFS
+    bool acyclic = true;
+};
+
+/**
+ * @class TopologicalSort
+ * @brief Steppable topological sort that reports a cycle when there is no order.
+ *
+ * The DFS keeps a frame (node, next arc) per stacked node, so path length
+ * is bounded by memory rather than the call stack. An arc to a node still
+ * on the stack closes a cycle, which is read straight off the stack.
+ *
+ * Kahn's mode counts in-degrees, then expands one wave of ready nodes per
+ * step. Tasks take runs of the wave and decrement their targets' in-degrees
+ * with atomic subtractions; the task that takes one to zero appends the
+ * target to a list of its own, and the lists joined in task order are the
+ * next wave, so nothing takes a lock. With one thread the same code runs
+ * without atomic writes. Besides the in-degrees a wave writes nothing per
+ * node: which wave a node is in follows from its place in the order.
+ * When the waves run out before every node is sorted, the nodes left over
+ * all wait on each other, and a DFS over just them finds a cycle.
+ */
+class TopologicalSort {
+private:
+    static constexpr std::size_t WAVE_GRAIN = 256;   // Wave entries per task
+    static constexpr std::size_t NODES_GRAIN = 4096; // Nodes per task when counting in-degrees
+
+    struct Frame {
+        int node;
+        std::size_t arc; // Next arc to follow
+    };
+
+    const Graph& m_graph;
+    TopoMode m_mode;
+    unsigned m_threads;
+
+    std::vector<int> m_order;       // Kahn: waves so far; DFS: finished nodes, reversed once all are
+    std::vector<int> m_cycle;       // Each node has an arc to the next, the last one to the first
+
+    // Depth-first
+    std::vector<TopoState> m_state; // Active = on the stack
+    std::vector<Frame> m_stack;
+    int m_nextRoot;
+
+    // Kahn's
+    std::unique_ptr<std::atomic<int>[]> m_inDegree;
+    std::vector<std::size_t> m_waveStarts; // Wave i is m_order[m_waveStarts[i], m_waveStarts[i + 1])
+    std::vector<std::vector<int>> m_partNodes; // Per task: the nodes it made ready
+
+    bool m_finished;
+    TopoStats m_stats;
+
+    unsigned getThreads() const;
+    void push(int node);
+    bool stepDepthFirst();
+    bool stepKahn();
+    void collectCycle(int from);
+    void findCycle();
+
+public:
+    explicit TopologicalSort(const Graph& graph);
+
+    void setThreads(unsigned threads) { m_threads = threads; } // 0 = all
+
+    // Clears all progress and prepares the given mode; Kahn's counts the
+    // in-degrees and makes the sources the first wave here
+    void start(TopoMode mode);
+
+    // DFS: one node pushed or finished. Kahn: one wave expanded.
+    // False, doing nothing, once isFinished(): every node is sorted or a
+    // cycle has been found.
+    bool step();
+
+    // Sorts in one go; true if the graph is acyclic
+    bool run(TopoMode mode);
+
+    bool isFinished() const { return m_finished; }
+    TopoState getState(int node) const { return m_state[node]; } // Depth-first only
+    const std::vector<int>& getOrder() const { return m_order; } // Complete only if finished without a cycle
+    const std::vector<int>& getCycle() const { return m_cycle; }
+    std::size_t getStackDepth() const { return m_stack.size(); }
+    int getStackTop() const { return m_stack.empty() ? -1 : m_stack.back().node; }
+    std::size_t getWaveCount() const { return m_waveStarts.empty() ? 0 : m_waveStarts.size() - 1; }
+    std::size_t getWaveStart(std::size_t wave) const { return m_waveStarts[wave]; } // wave == getWaveCount() gives the end
+    const TopoStats& getStats() const { return m_stats; }
+};
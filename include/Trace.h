@@ -0,0 +1,179 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * One algorithm step in decoded form. The meaning of the operands depends on
+ * the type:
+ *   Compare   a, b: the two indices compared
+ *   Swap      a, b: the two indices swapped
+ *   Write     a = index, b = new value, c = old value
+ *   NodeState a = node, b = new state, c = old state
+ *   EdgeRelax a = from, b = to, c = new distance of b, d = old distance of b
+ * Old values are not stored in a trace; the player fills them in while
+ * decoding so that events can be undone when playing backwards.
+ */
+struct TraceEvent {
+    enum class Type : std::uint8_t { Compare, Swap, Write, NodeState, EdgeRelax };
+
+    Type type;
+    std::int32_t a, b, c, d;
+};
+
+// The data a trace operates on: array values (sort data or node distances)
+// and one small integer state per node.
+struct TraceState {
+    std::vector<int> values;
+    std::vector<int> states;
+};
+
+// Applies an event to a state (forward) or undoes it (backward).
+// Forward application fills in the event's old value(s).
+void applyTraceEvent(TraceState& state, TraceEvent& event, bool forward);
+
+// A full snapshot of the state taken before event number `step`
+struct TraceKeyframe {
+    std::uint64_t step;
+    std::uint64_t byteOffset;     // Where event `step` starts in the event stream (page-aligned in a file)
+    std::uint64_t snapshotOffset; // First int of the snapshot in the snapshot pool
+};
+
+/**
+ * @class Trace
+ * @brief A recorded run stored as keyframes plus a delta-encoded event stream.
+ *
+ * Events are packed as a type byte followed by zigzag varints; indices are
+ * stored relative to the previous event, so the typical event takes 2-4
+ * bytes. Every few events (adaptively, proportional to the state size) a
+ * full snapshot is taken, which bounds the memory spent on snapshots relative
+ * to the events, and lets a player reach any step with a binary search over
+ * the keyframes plus a short replay.
+ *
+ * A trace can be saved to a binary file and loaded back by memory-mapping it:
+ *   header | keyframe index | snapshots | event stream
+ * In the file every keyframe's chunk of the event stream starts on a page
+ * boundary, so a player only pages in the chunks it actually visits. A
+ * loaded trace is read-only.
+ */
+class Trace {
+private:
+    std::string m_label; // What produced the trace, e.g. the algorithm name
+    std::size_t m_valueCount;
+    std::size_t m_stateCount;
+    std::vector<std::uint8_t> m_bytes;        // Encoded events
+    std::vector<TraceKeyframe> m_keyframes;
+    std::vector<std::int32_t> m_snapshots;    // Keyframe snapshots: values then states
+    std::uint64_t m_eventCount;
+    std::uint64_t m_keyframeInterval;
+
+    // Recording state
+    TraceState m_liveState;  // State after the last recorded event
+    std::int32_t m_lastIndex; // Delta base for the next event's first operand
+
+    // Sections of a loaded trace point into the mapped file instead
+    std::shared_ptr<MappedFile> m_file;
+    const std::uint8_t* m_fileEvents;
+    const TraceKeyframe* m_fileKeyframes;
+    const std::int32_t* m_fileSnapshots;
+    std::size_t m_fileKeyframeCount;
+    std::size_t m_fileEventBytes;
+
+    void append(TraceEvent event);
+    void addKeyframe();
+
+    const std::uint8_t* eventData() const { return m_file ? m_fileEvents : m_bytes.data(); }
+    std::size_t eventBytes() const { return m_file ? m_fileEventBytes : m_bytes.size(); }
+    const TraceKeyframe* keyframeData() const { return m_file ? m_fileKeyframes : m_keyframes.data(); }
+    const std::int32_t* snapshotData() const { return m_file ? m_fileSnapshots : m_snapshots.data(); }
+
+public:
+    static constexpr std::uint32_t FILE_VERSION = 2;
+
+    Trace();
+    explicit Trace(TraceState initialState);
+
+    void setLabel(const std::string& label) { m_label = label; }
+    const std::string& getLabel() const { return m_label; }
+
+    // Writes the trace to disk. Returns false (and reports why) on failure.
+    bool saveToFile(const std::string& path) const;
+
+    // Replaces this trace with a memory-mapped one. On failure the trace is
+    // left unchanged and false is returned.
+    bool loadFromFile(const std::string& path);
+
+    // --- Recording ---
+    void compare(int i, int j) { append({TraceEvent::Type::Compare, i, j, 0, 0}); }
+    void swap(int i, int j) { append({TraceEvent::Type::Swap, i, j, 0, 0}); }
+    void write(int i, int newValue) { append({TraceEvent::Type::Write, i, newValue, 0, 0}); }
+    void nodeState(int node, int newState) { append({TraceEvent::Type::NodeState, node, newState, 0, 0}); }
+    void relax(int u, int v, int newDist) { append({TraceEvent::Type::EdgeRelax, u, v, newDist, 0}); }
+
+    // Takes a keyframe before the next event, e.g. at the start of a round,
+    // unless there is one there already
+    void markKeyframe();
+
+    // --- Reading ---
+    std::size_t size() const { return static_cast<std::size_t>(m_eventCount); }
+    std::size_t getValueCount() const { return m_valueCount; }
+    std::size_t getStateCount() const { return m_stateCount; }
+    std::size_t getKeyframeCount() const { return m_file ? m_fileKeyframeCount : m_keyframes.size(); }
+    const TraceKeyframe& getKeyframe(std::size_t index) const { return keyframeData()[index]; }
+    bool isMapped() const { return m_file != nullptr; }
+    std::size_t getMemoryBytes() const; // Encoded size, in memory or on disk
+
+    // Index of the last keyframe at or before `step` (binary search)
+    std::size_t findKeyframe(std::size_t step) const;
+
+    // Copies the snapshot of a keyframe into state
+    void restoreKeyframe(std::size_t index, TraceState& state) const;
+
+    // Decodes every event between keyframe `index` and the next one
+    void decodeBlock(std::size_t index, std::vector<TraceEvent>& events) const;
+
+    TraceState getInitialState() const;
+};
+
+/**
+ * @class TracePlayer
+ * @brief Replays a Trace forwards, backwards, or jumps to any position.
+ *
+ * The player decodes one keyframe block at a time, so stepping in either
+ * direction is O(1) amortized and seeking costs a binary search plus at most
+ * one block of replay.
+ */
+class TracePlayer {
+private:
+    const Trace* m_trace;
+    TraceState m_state;
+    std::size_t m_position;   // Number of events applied to m_state
+
+    std::size_t m_block;      // Keyframe whose events are decoded
+    std::size_t m_blockStart; // Step of that keyframe
+    std::vector<TraceEvent> m_blockEvents;
+
+    void loadBlock(std::size_t keyframe); // Also resets the state to the keyframe
+    std::size_t blockEnd() const { return m_blockStart + m_blockEvents.size(); }
+
+public:
+    TracePlayer();
+
+    void load(const Trace& trace);
+
+    bool stepForward();  // Returns false at the end of the trace
+    bool stepBackward(); // Returns false at the start of the trace
+    void seek(std::size_t position);
+
+    std::size_t getPosition() const { return m_position; }
+    std::size_t getLength() const { return m_trace ? m_trace->size() : 0; }
+    bool atEnd() const { return m_position >= getLength(); }
+    const TraceState& getState() const { return m_state; }
+
+    // The event that produced the current state, or nullptr at the start
+    const TraceEvent* getLastEvent() const;
+};
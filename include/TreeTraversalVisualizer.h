@@ -22,7 +22,6 @@ private:
     };
 
     std::unique_ptr<TreeNode> m_root;
-    sf::Font m_font;
     TraversalType m_traversalType;
     std::string m_traversalName;
 
@@ -30,8 +29,6 @@ private:
     std::vector<TreeNode*> m_traversalOrder;
     int m_currentIndex;
     bool m_isVisualizing;
-    sf::Clock m_clock;
-    float m_delay = 0.7f;
 
     // Helper methods
     std::unique_ptr<TreeNode> buildTree(const std::vector<int*>& values, int start, int end);
@@ -45,11 +42,12 @@ private:
     void resetNodeStates(TreeNode* node);
 
 public:
-    TreeTraversalVisualizer(sf::RenderWindow& window, TraversalType type);
+    TreeTraversalVisualizer(sf::RenderWindow* window, TraversalType type);
     ~TreeTraversalVisualizer() override = default;
 
     void handleEvent(sf::Event& event) override;
-    void update() override;
+    bool step() override;
     void draw() override;
     void reset() override;
+    void start() override;
 };
@@ -1,5 +1,10 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "DataGenerator.h"
+#include "ResourceManager.h"
+#include "StepScheduler.h"
+#include <algorithm>
+#include <vector>
 
 /**
  * @class Visualizer
@@ -8,14 +13,54 @@
  * This class defines the common interface that every algorithm visualizer
  * must implement. This ensures that the main application can treat all
  * visualizers uniformly, making it easy to switch between them.
+ *
+ * A visualizer created without a window runs headless: it lays itself out
+ * on a virtual canvas of HEADLESS_CANVAS_SIZE and can be stepped, but never
+ * drawn. This lets the algorithms run on machines without a display.
  */
 class Visualizer {
 protected:
-    sf::RenderWindow& m_window; // A reference to the main application window
+    sf::RenderWindow* m_window; // The main application window, or nullptr when headless
+    const sf::Font& m_font;     // Shared HUD/label font owned by the ResourceManager
+    StepScheduler m_scheduler;  // Paces step() calls independently of the frame rate
+    std::uint64_t m_dataRuns = 0; // Inputs generated so far, see generateBarData()
+
+    bool isHeadless() const { return m_window == nullptr; }
+
+    // Size of the area the visualizer lays itself out in
+    sf::Vector2u getCanvasSize() const { return m_window ? m_window->getSize() : HEADLESS_CANVAS_SIZE; }
+
+    // Moves a label's origin to the center of its text. Measuring text needs
+    // rasterized glyphs (and so a graphics context), which headless runs skip.
+    void centerOrigin(sf::Text& text) const {
+        if (isHeadless()) return;
+        sf::FloatRect bounds = text.getLocalBounds();
+        text.setOrigin(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+    }
+
+    // Where the graph visualizers lay out graphs without coordinates
+    sf::FloatRect getGraphArea() const {
+        return sf::FloatRect(50.f, 70.f, getCanvasSize().x - 100.f, getCanvasSize().y - 130.f);
+    }
+
+    // Random bar heights in [10, canvas height - topMargin] for the sort
+    // visualizers. Drawn from the workload seed, so the n-th input of every
+    // visualizer is the same array.
+    std::vector<int> generateBarData(std::size_t count, int topMargin) {
+        DataSpec spec;
+        spec.count = count;
+        spec.seed = randomAt(getWorkloadSeed(), m_dataRuns++);
+        spec.minValue = 10;
+        spec.maxValue = std::max(20, static_cast<int>(getCanvasSize().y) - topMargin);
+        return generateData(spec);
+    }
 
 public:
-    // Constructor that takes a reference to the render window
-    Visualizer(sf::RenderWindow& window) : m_window(window) {}
+    inline static const sf::Vector2u HEADLESS_CANVAS_SIZE = sf::Vector2u(1280, 720);
+
+    // Constructor that takes the render window (nullptr for a headless run)
+    Visualizer(sf::RenderWindow* window)
+        : m_window(window), m_font(ResourceManager::getInstance().getFont()) {}
     
     // Virtual destructor is important for base classes
     virtual ~Visualizer() = default;
@@ -25,12 +70,21 @@ public:
     // handleEvent: Process SFML events (e.g., keyboard presses, mouse clicks)
     virtual void handleEvent(sf::Event& event) = 0;
 
-    // update: Update the state of the algorithm (e.g., perform one step of a sort)
-    virtual void update() = 0;
+    // step: Advance the algorithm by exactly one step (e.g., one comparison of a sort).
+    // Returns false when there is nothing to do because it is paused or finished.
+    virtual bool step() = 0;
 
     // draw: Render the current state of the algorithm to the window
     virtual void draw() = 0;
     
     // reset: Resets the algorithm to its initial state, ready for visualization
     virtual void reset() = 0;
+
+    // start: Starts (or resumes) the algorithm without any user input
+    virtual void start() = 0;
+
+    // update: Runs as many steps as the scheduler allows for this frame
+    void update() { m_scheduler.run([this] { return step(); }); }
+
+    StepScheduler& getScheduler() { return m_scheduler; }
 };
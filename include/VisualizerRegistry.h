@@ -0,0 +1,17 @@
+#pragma once
+#include "Visualizer.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Creates a visualizer for the given window (nullptr for a headless run)
+using VisualizerFactory = std::function<std::unique_ptr<Visualizer>(sf::RenderWindow*)>;
+
+struct VisualizerEntry {
+    std::string name;
+    VisualizerFactory factory; // Empty for entries that need interactive input first (BST)
+};
+
+// Every algorithm the application knows about, in menu order
+std::vector<VisualizerEntry> createVisualizerRegistry();
@@ -4,11 +4,9 @@
 
 using namespace std;
 
-BSTVisualizer::BSTVisualizer(sf::RenderWindow& window, Operation op, int value)
+BSTVisualizer::BSTVisualizer(sf::RenderWindow* window, Operation op, int value)
     : Visualizer(window), m_operation(op), m_targetValue(value), m_isVisualizing(false), m_isDone(false), m_currentNode(nullptr), m_parent(nullptr) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) {
-        cerr << "Error loading font in BSTVisualizer" << endl;
-    }
+    m_scheduler.setStepsPerSecond(1.0 / 0.6); // One step every 0.6s by default
     switch(op) {
         case Operation::INSERT: m_opName = "Insert " + to_string(value); break;
         case Operation::SEARCH: m_opName = "Search for " + to_string(value); break;
@@ -48,8 +46,7 @@ void BSTVisualizer::setNodePositions(TreeNode* node, int x, int y, int h_spacing
     node->label.setFont(m_font);
     node->label.setString(to_string(node->value));
     node->label.setCharacterSize(22);
-    sf::FloatRect r = node->label.getLocalBounds();
-    node->label.setOrigin(r.left + r.width/2.f, r.top + r.height/2.f);
+    centerOrigin(node->label);
     node->label.setPosition(node->position);
 
     if (node->left) setNodePositions(node->left.get(), x - h_spacing, y + 90, h_spacing / 2);
@@ -65,7 +62,7 @@ void BSTVisualizer::resetNodeStates(TreeNode* node) {
 
 void BSTVisualizer::reset() {
     buildInitialTree();
-    setNodePositions(m_root.get(), m_window.getSize().x / 2, 100, m_window.getSize().x / 4);
+    setNodePositions(m_root.get(), getCanvasSize().x / 2, 100, getCanvasSize().x / 4);
     resetNodeStates(m_root.get());
     m_isVisualizing = false;
     m_isDone = false;
@@ -74,6 +71,10 @@ void BSTVisualizer::reset() {
     cout << "BST " << m_opName << " reset. Press SPACE to start." << endl;
 }
 
+void BSTVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
 void BSTVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = true;
@@ -81,12 +82,11 @@ void BSTVisualizer::handleEvent(sf::Event& event) {
     }
 }
 
-void BSTVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+bool BSTVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
 
     if (!m_currentNode) { // Node not found or tree is empty
-        m_isDone = true; m_isVisualizing = false; return;
+        m_isDone = true; m_isVisualizing = false; return true;
     }
 
     m_currentNode->state = TreeNode::State::Visiting;
@@ -99,10 +99,10 @@ void BSTVisualizer::update() {
             m_isDone = true; m_isVisualizing = false;
         } else { // DELETE
             deleteNode();
-            setNodePositions(m_root.get(), m_window.getSize().x / 2, 100, m_window.getSize().x / 4);
+            setNodePositions(m_root.get(), getCanvasSize().x / 2, 100, getCanvasSize().x / 4);
             m_isDone = true; m_isVisualizing = false;
         }
-        return;
+        return true;
     }
 
     m_parent = m_currentNode;
@@ -115,9 +115,10 @@ void BSTVisualizer::update() {
     // If we've reached a null pointer, it's time to insert (if that's the op)
     if (!m_currentNode && m_operation == Operation::INSERT) {
         insertNode();
-        setNodePositions(m_root.get(), m_window.getSize().x / 2, 100, m_window.getSize().x / 4);
+        setNodePositions(m_root.get(), getCanvasSize().x / 2, 100, getCanvasSize().x / 4);
         m_isDone = true; m_isVisualizing = false;
     }
+    return true;
 }
 
 void BSTVisualizer::insertNode() {
@@ -172,11 +173,11 @@ void BSTVisualizer::drawTree(TreeNode* node) {
     if (!node) return;
     if (node->left) {
         sf::Vertex line[] = {node->position, node->left->position};
-        m_window.draw(line, 2, sf::Lines);
+        m_window->draw(line, 2, sf::Lines);
     }
     if (node->right) {
         sf::Vertex line[] = {node->position, node->right->position};
-        m_window.draw(line, 2, sf::Lines);
+        m_window->draw(line, 2, sf::Lines);
     }
     drawTree(node->left.get());
     drawTree(node->right.get());
@@ -187,14 +188,14 @@ void BSTVisualizer::drawTree(TreeNode* node) {
         case TreeNode::State::Found:   node->shape.setFillColor(sf::Color::Green); break;
         default: break;
     }
-    m_window.draw(node->shape);
-    m_window.draw(node->label);
+    m_window->draw(node->shape);
+    m_window->draw(node->label);
 }
 
 void BSTVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
+    m_window->clear(sf::Color(30, 30, 30));
     if (m_root) drawTree(m_root.get());
     sf::Text infoText("BST: " + m_opName, m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
 }
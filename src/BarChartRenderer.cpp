@@ -0,0 +1,27 @@
+#include "BarChartRenderer.h"
+
+BarChartRenderer::BarChartRenderer()
+    : m_vertices(sf::Quads), m_baseColor(sf::Color::Cyan) {}
+
+void BarChartRenderer::resizeColumns(std::size_t columns) {
+    if (m_vertices.getVertexCount() != columns * 4) {
+        m_vertices.resize(columns * 4);
+    }
+}
+
+void BarChartRenderer::setColumn(std::size_t column, float x, float width, float height, float canvasHeight, sf::Color color) {
+    // Leave a one pixel gap between bars while they are wide enough to show it
+    float barWidth = (width > 2.f) ? width - 1.f : width;
+    float top = canvasHeight - height;
+
+    sf::Vertex* quad = &m_vertices[column * 4];
+    quad[0].position = sf::Vector2f(x, top);
+    quad[1].position = sf::Vector2f(x + barWidth, top);
+    quad[2].position = sf::Vector2f(x + barWidth, canvasHeight);
+    quad[3].position = sf::Vector2f(x, canvasHeight);
+    quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+}
+
+void BarChartRenderer::draw(sf::RenderTarget& target) const {
+    if (m_vertices.getVertexCount() > 0) target.draw(m_vertices);
+}
@@ -0,0 +1,229 @@
+#include "BellmanFord.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+
+using namespace std;
+
+BellmanFord::BellmanFord(const Graph& graph) : m_graph(graph) {}
+
+bool BellmanFord::run(int source, BellmanFordMode mode, unsigned threads) {
+    auto clear = [&] {
+        m_distances.assign(m_graph.getNodeCount(), UNREACHED);
+        m_parentArc.assign(m_graph.getNodeCount(), NO_ARC);
+        m_distances[source] = 0;
+        m_cycle.clear();
+    };
+    clear();
+    m_stats = BellmanFordStats();
+
+    int lowered = -1; // A node still being lowered when a negative cycle was proven
+    switch (mode) {
+        case BellmanFordMode::Passes:   lowered = runPasses(); break;
+        case BellmanFordMode::Queue:    lowered = runQueue(source); break;
+        case BellmanFordMode::Parallel: lowered = runParallel(source, threads); break;
+    }
+    if (!m_cycle.empty()) return false;
+    if (lowered < 0) return true;
+
+    // Following the parents n times leaves any path that reaches back to
+    // the source, so it ends on a cycle
+    int node = lowered;
+    for (int step = 0; step < m_graph.getNodeCount() && m_parentArc[node] != NO_ARC; ++step) {
+        node = m_graph.getSource(m_parentArc[node]);
+    }
+    if (!readCycle(node)) {
+        // A parallel parent may have lost a race, and a queue-mode path
+        // count may be outdated by the time it reaches n; sequential passes
+        // always leave the cycle in the parent arcs
+        clear();
+        if (runPasses() < 0 && m_cycle.empty()) return true;
+        if (m_cycle.empty()) findParentCycle();
+    }
+    return false;
+}
+
+// Gauss-Seidel passes: a distance lowered early in a pass is used by the
+// arcs after it, so most graphs settle in far fewer than n - 1 passes
+int BellmanFord::runPasses() {
+    int n = m_graph.getNodeCount();
+    for (int pass = 1; pass <= n; ++pass) {
+        m_stats.passes++;
+        int lowered = -1;
+        for (int u = 0; u < n; ++u) {
+            if (m_distances[u] == UNREACHED) continue;
+            for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                m_stats.relaxations++;
+                int v = m_graph.getTarget(arc);
+                int64_t candidate = m_distances[u] + m_graph.getWeight(arc);
+                if (candidate < m_distances[v]) {
+                    m_distances[v] = candidate;
+                    m_parentArc[v] = arc;
+                    m_stats.updates++;
+                    lowered = v;
+                }
+            }
+        }
+        if (lowered < 0) return -1;
+        if (pass == n) return lowered; // Still improving after n - 1 passes
+        if (pass % CYCLE_CHECK_PASSES == 0 && findParentCycle()) return -1;
+    }
+    return -1;
+}
+
+// SPFA. A shortest path has at most n - 1 arcs, so a distance reached
+// through a path of n arcs proves a negative cycle.
+int BellmanFord::runQueue(int source) {
+    int n = m_graph.getNodeCount();
+    vector<int> arcsOnPath(n, 0);
+    vector<bool> queued(n, false);
+    deque<int> queue = {source};
+    queued[source] = true;
+
+    while (!queue.empty()) {
+        int u = queue.front();
+        queue.pop_front();
+        queued[u] = false;
+        m_stats.dequeues++;
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            m_stats.relaxations++;
+            int v = m_graph.getTarget(arc);
+            int64_t candidate = m_distances[u] + m_graph.getWeight(arc);
+            if (candidate >= m_distances[v]) continue;
+            m_distances[v] = candidate;
+            m_parentArc[v] = arc;
+            m_stats.updates++;
+            arcsOnPath[v] = arcsOnPath[u] + 1;
+            if (arcsOnPath[v] >= n) return v;
+            if (!queued[v]) {
+                queued[v] = true;
+                queue.push_back(v);
+            }
+        }
+        if (m_stats.dequeues % n == 0 && findParentCycle()) return -1;
+    }
+    return -1;
+}
+
+int BellmanFord::runParallel(int source, unsigned threads) {
+    int n = m_graph.getNodeCount();
+    unique_ptr<atomic<int64_t>[]> distances(new atomic<int64_t>[n]);
+    unique_ptr<atomic<size_t>[]> parents(new atomic<size_t>[n]);
+    for (int v = 0; v < n; ++v) {
+        distances[v].store(UNREACHED, memory_order_relaxed);
+        parents[v].store(NO_ARC, memory_order_relaxed);
+    }
+    distances[source].store(0, memory_order_relaxed);
+    auto copyOut = [&] {
+        for (int v = 0; v < n; ++v) {
+            m_distances[v] = distances[v].load(memory_order_relaxed);
+            m_parentArc[v] = parents[v].load(memory_order_relaxed);
+        }
+    };
+
+    for (int pass = 1; pass <= n; ++pass) {
+        m_stats.passes++;
+        atomic<unsigned long long> relaxations{0}, updates{0};
+        atomic<int> lowered{-1};
+        ThreadPool::getInstance().parallelFor(n, GRAIN, [&](size_t begin, size_t end) {
+            unsigned long long examined = 0, changed = 0;
+            int last = -1;
+            for (int u = static_cast<int>(begin); u < static_cast<int>(end); ++u) {
+                int64_t du = distances[u].load(memory_order_relaxed);
+                if (du == UNREACHED) continue;
+                for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                    ++examined;
+                    int v = m_graph.getTarget(arc);
+                    int64_t candidate = du + m_graph.getWeight(arc);
+                    int64_t current = distances[v].load(memory_order_relaxed);
+                    while (candidate < current) {
+                        if (distances[v].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+                            parents[v].store(arc, memory_order_relaxed); // May be overtaken by a racing lower value
+                            ++changed;
+                            last = v;
+                            break;
+                        }
+                    }
+                }
+            }
+            relaxations.fetch_add(examined, memory_order_relaxed);
+            updates.fetch_add(changed, memory_order_relaxed);
+            if (last >= 0) lowered.store(last, memory_order_relaxed);
+        }, threads);
+        m_stats.relaxations += relaxations.load();
+        m_stats.updates += updates.load();
+
+        if (lowered.load() < 0) break;
+        if (pass == n || pass % CYCLE_CHECK_PASSES == 0) {
+            copyOut();
+            if (pass == n) return lowered.load();
+            if (findParentCycle()) return -1;
+        }
+    }
+    copyOut();
+    rebuildParents(source);
+    return -1;
+}
+
+// A parent stored after a successful compare-and-swap may belong to a
+// distance another thread has since lowered, so once the distances are
+// final the parents are picked again among the tight arcs, d[u] + w == d[v].
+// They are searched from the source, as a choice made node by node could
+// close a loop of zero-weight arcs.
+void BellmanFord::rebuildParents(int source) {
+    int n = m_graph.getNodeCount();
+    m_parentArc.assign(n, NO_ARC);
+    vector<bool> reached(n, false);
+    vector<int> stack = {source};
+    reached[source] = true;
+    while (!stack.empty()) {
+        int u = stack.back();
+        stack.pop_back();
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = m_graph.getTarget(arc);
+            if (reached[v] || m_distances[u] + m_graph.getWeight(arc) != m_distances[v]) continue;
+            reached[v] = true;
+            m_parentArc[v] = arc;
+            stack.push_back(v);
+        }
+    }
+}
+
+// Looks for a cycle among the parent arcs; each node is walked once
+bool BellmanFord::findParentCycle() {
+    int n = m_graph.getNodeCount();
+    vector<int> walk(n, -1); // Start of the walk that first reached the node
+    for (int start = 0; start < n; ++start) {
+        int v = start;
+        while (v >= 0 && walk[v] < 0) {
+            walk[v] = start;
+            v = m_parentArc[v] == NO_ARC ? -1 : m_graph.getSource(m_parentArc[v]);
+        }
+        if (v >= 0 && walk[v] == start && readCycle(v)) return true;
+    }
+    return false;
+}
+
+// Reads the parent cycle through node into m_cycle. Returns false, leaving
+// m_cycle empty, if node is not on a negative parent cycle.
+bool BellmanFord::readCycle(int node) {
+    int n = m_graph.getNodeCount();
+    m_cycle.clear();
+    int64_t weight = 0;
+    int v = node;
+    do {
+        if (m_parentArc[v] == NO_ARC || static_cast<int>(m_cycle.size()) >= n) {
+            m_cycle.clear();
+            return false;
+        }
+        m_cycle.push_back(m_parentArc[v]);
+        weight += m_graph.getWeight(m_parentArc[v]);
+        v = m_graph.getSource(m_parentArc[v]);
+    } while (v != node);
+    reverse(m_cycle.begin(), m_cycle.end());
+    if (weight < 0) return true;
+    m_cycle.clear();
+    return false;
+}
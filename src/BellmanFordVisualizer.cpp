@@ -1,105 +1,220 @@
 #include "BellmanFordVisualizer.h"
+#include "GraphLoader.h"
+#include <chrono>
 #include <iostream>
 #include <limits>
 
 using namespace std;
 
-BellmanFordVisualizer::BellmanFordVisualizer(sf::RenderWindow& window)
-    : Visualizer(window), m_isVisualizing(false), m_isDone(false), m_iteration(0), m_edgeIndex(0), m_negativeCycle(false) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) cerr << "Error loading font" << endl;
+BellmanFordVisualizer::BellmanFordVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_mode(BellmanFordMode::Passes), m_engineMs(0.0), m_isVisualizing(false), m_isDone(false),
+      m_iteration(0), m_passChanged(false), m_arc(0), m_arcSource(0), m_negativeCycle(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.3); // One step every 0.3s by default
 }
 
 void BellmanFordVisualizer::buildGraph() {
-    m_nodes.clear(); m_edges.clear(); m_edgeWeights.clear();
+    m_distLabels.clear(); m_renderer.clear();
+    m_highlightedEdges.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, sf::Color(100, 100, 250));
+        m_graph = Graph(file->nodeCount, file->edges, file->directed);
+        if (file->nodeCount <= GraphRenderer::MAX_LABELLED_NODES) {
+            for (int u = 0; u < file->nodeCount; ++u) {
+                sf::Vector2f below(0, m_renderer.getNodeRadius() + 5);
+                m_distLabels.push_back(m_renderer.addLabel(m_renderer.getNodePosition(u) + below, "inf", 18, sf::Color::White, false));
+            }
+        }
+        return;
+    }
     map<int, sf::Vector2f> positions = {
         {0, {150, 360}}, {1, {400, 200}}, {2, {400, 520}}, {3, {700, 360}}, {4, {950, 360}}
     };
     for(const auto& p : positions) {
-        Node node;
-        node.shape.setRadius(30.f); node.shape.setOrigin(30.f, 30.f);
-        node.shape.setPosition(p.second);
-        node.label.setFont(m_font); node.label.setString(to_string(p.first));
-        node.label.setCharacterSize(24);
-        sf::FloatRect r = node.label.getLocalBounds();
-        node.label.setOrigin(r.left + r.width/2.f, r.top + r.height/2.f);
-        node.label.setPosition(p.second);
-        node.distLabel.setFont(m_font); node.distLabel.setCharacterSize(18);
-        m_nodes[p.first] = node;
+        m_renderer.addNode(p.second, sf::Color(100, 100, 250));
+        m_renderer.addLabel(p.second, to_string(p.first), 24);
+        m_distLabels.push_back(m_renderer.addLabel(p.second + sf::Vector2f(0, 35), "inf", 18, sf::Color::White, false));
     }
+    vector<GraphEdge> edges;
     auto addEdge = [&](int u, int v, int w) {
-        m_edges.emplace_back(u, v, w);
-        sf::Text weightText(to_string(w), m_font, 20);
-        sf::Vector2f pos = (m_nodes[u].shape.getPosition() + m_nodes[v].shape.getPosition()) / 2.f;
-        weightText.setPosition(pos);
-        m_edgeWeights[{u,v}] = weightText;
+        edges.push_back({u, v, w});
+        m_renderer.addEdge(u, v);
+        sf::Vector2f pos = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+        m_renderer.addLabel(pos, to_string(w), 20, sf::Color::White, false);
     };
     addEdge(0, 1, 6); addEdge(0, 2, 7); addEdge(1, 3, 5);
     addEdge(1, 2, 8); addEdge(2, 3, -4); addEdge(1, 4, -2); addEdge(3, 4, 3);
+    m_graph = Graph(positions.size(), edges, true);
+}
+
+void BellmanFordVisualizer::runEngine() {
+    m_engine = make_unique<BellmanFord>(m_graph);
+    auto startTime = chrono::steady_clock::now();
+    bool ok = m_engine->run(0, m_mode);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_cycleEdges.clear();
+    for (size_t arc : m_engine->getNegativeCycle()) m_cycleEdges.push_back(m_graph.getEdgeId(arc));
+
+    const BellmanFordStats& stats = m_engine->getStats();
+    cout << "Bellman-Ford with " << bellmanFordModeName(m_mode) << ": " << m_engineMs << " ms, " << stats.passes << " passes, "
+         << stats.dequeues << " dequeues, " << stats.relaxations << " relaxations, " << stats.updates << " updates";
+    if (ok) cout << "." << endl;
+    else cout << "; negative cycle of " << m_cycleEdges.size() << " edges." << endl;
 }
 
 void BellmanFordVisualizer::reset() {
     buildGraph();
-    m_distances.assign(m_nodes.size(), numeric_limits<int>::max());
+    runEngine();
+    int n = m_graph.getNodeCount();
+    m_distances.assign(n, numeric_limits<int>::max());
     m_distances[0] = 0;
     m_isVisualizing = false;
     m_isDone = false;
     m_iteration = 0;
-    m_edgeIndex = 0;
+    m_passChanged = false;
+    m_arc = 0;
+    m_arcSource = m_mode == BellmanFordMode::Queue ? -1 : 0;
+    m_passEdges.clear();
+    m_queue.assign(1, 0);
+    m_queued.assign(n, false);
+    m_queued[0] = true;
+    m_arcsOnPath.assign(n, 0);
     m_negativeCycle = false;
     cout << "Bellman-Ford reset. Press SPACE to start." << endl;
 }
 
+void BellmanFordVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
 void BellmanFordVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::M) {
+            m_mode = static_cast<BellmanFordMode>((static_cast<int>(m_mode) + 1) % size(ALL_BELLMAN_FORD_MODES));
+            reset();
+        }
     }
 }
 
-void BellmanFordVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+void BellmanFordVisualizer::finish(bool negativeCycle) {
+    m_negativeCycle = negativeCycle;
+    m_isDone = true; m_isVisualizing = false;
+}
 
-    if (m_iteration < m_nodes.size() - 1) {
-        auto [u, v, w] = m_edges[m_edgeIndex];
-        if (m_distances[u] != numeric_limits<int>::max() && m_distances[u] + w < m_distances[v]) {
-            m_distances[v] = m_distances[u] + w;
-        }
-        m_edgeIndex++;
-        if (m_edgeIndex >= m_edges.size()) {
-            m_edgeIndex = 0;
-            m_iteration++;
+// One arc per step; stops after a pass that changes nothing
+void BellmanFordVisualizer::stepPasses() {
+    int n = m_graph.getNodeCount();
+    if (m_graph.getArcCount() == 0) return finish(false);
+    while (m_arc >= m_graph.arcEnd(m_arcSource)) m_arcSource++; // Skip nodes without arcs
+    int u = m_arcSource, v = m_graph.getTarget(m_arc), w = m_graph.getWeight(m_arc);
+    if (m_distances[u] != numeric_limits<int>::max() && m_distances[u] + w < m_distances[v]) {
+        m_distances[v] = m_distances[u] + w;
+        m_passChanged = true;
+        if (m_iteration == n - 1) return finish(true); // Still improving after n - 1 passes
+    }
+    m_arc++;
+    if (m_arc >= m_graph.getArcCount()) {
+        m_arc = 0;
+        m_arcSource = 0;
+        m_iteration++;
+        if (!m_passChanged) return finish(false);
+        m_passChanged = false;
+    }
+}
+
+// A whole pass per step. Every arc reads the distances from before the
+// pass, as the threads of a parallel pass may see any of them.
+void BellmanFordVisualizer::stepParallelPass() {
+    vector<int> before = m_distances;
+    m_passEdges.clear();
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        if (before[u] == numeric_limits<int>::max()) continue;
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = m_graph.getTarget(arc);
+            if (before[u] + m_graph.getWeight(arc) < m_distances[v]) {
+                m_distances[v] = before[u] + m_graph.getWeight(arc);
+                m_passEdges.push_back(m_graph.getEdgeId(arc));
+            }
         }
-    } else { // Check for negative cycle
-        for(const auto& edge : m_edges) {
-            auto [u, v, w] = edge;
-            if (m_distances[u] != numeric_limits<int>::max() && m_distances[u] + w < m_distances[v]) {
-                m_negativeCycle = true; break;
+    }
+    m_iteration++;
+    if (m_passEdges.empty()) finish(false);
+    else if (m_iteration == m_graph.getNodeCount()) finish(true);
+}
+
+// Takes a node from the queue, then relaxes its arcs one per step
+void BellmanFordVisualizer::stepQueue() {
+    int n = m_graph.getNodeCount();
+    if (m_arcSource < 0) {
+        if (m_queue.empty()) return finish(false);
+        m_arcSource = m_queue.front();
+        m_queue.pop_front();
+        m_queued[m_arcSource] = false;
+        m_arc = m_graph.arcBegin(m_arcSource);
+    } else {
+        int u = m_arcSource, v = m_graph.getTarget(m_arc), w = m_graph.getWeight(m_arc);
+        if (m_distances[u] + w < m_distances[v]) {
+            m_distances[v] = m_distances[u] + w;
+            m_arcsOnPath[v] = m_arcsOnPath[u] + 1;
+            if (m_arcsOnPath[v] >= n) return finish(true); // A shortest path never has n arcs
+            if (!m_queued[v]) {
+                m_queued[v] = true;
+                m_queue.push_back(v);
             }
         }
-        m_isDone = true; m_isVisualizing = false;
+        m_arc++;
     }
+    if (m_arc >= m_graph.arcEnd(m_arcSource)) m_arcSource = -1;
+}
+
+bool BellmanFordVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+
+    switch (m_mode) {
+        case BellmanFordMode::Passes:   stepPasses(); break;
+        case BellmanFordMode::Queue:    stepQueue(); break;
+        case BellmanFordMode::Parallel: stepParallelPass(); break;
+    }
+    return true;
 }
 
 void BellmanFordVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for(const auto& edge : m_edges) {
-        sf::Vertex line[] = {m_nodes[get<0>(edge)].shape.getPosition(), m_nodes[get<1>(edge)].shape.getPosition()};
-        if(m_isVisualizing && !m_isDone && m_edgeIndex == (&edge - &m_edges[0])) line[0].color = line[1].color = sf::Color::Yellow;
-        m_window.draw(line, 2, sf::Lines);
+    m_window->clear(sf::Color(30, 30, 30));
+    vector<int> highlighted;
+    if (m_isDone && m_negativeCycle) highlighted = m_cycleEdges;
+    else if (m_mode == BellmanFordMode::Parallel) highlighted = m_passEdges;
+    else if (m_isVisualizing && !m_isDone && m_arcSource >= 0 && m_arc < m_graph.getArcCount()) highlighted.push_back(m_graph.getEdgeId(m_arc));
+    if (highlighted != m_highlightedEdges) {
+        for (int edge : m_highlightedEdges) m_renderer.setEdgeColor(edge, sf::Color::White);
+        sf::Color color = m_isDone && m_negativeCycle ? sf::Color::Red : sf::Color::Yellow;
+        for (int edge : highlighted) m_renderer.setEdgeColor(edge, color);
+        m_highlightedEdges = highlighted;
     }
-    for (const auto& pair : m_edgeWeights) m_window.draw(pair.second);
-    for (auto& pair : m_nodes) {
-        pair.second.shape.setFillColor(sf::Color(100, 100, 250));
-        string distStr = (m_distances[pair.first] == numeric_limits<int>::max()) ? "inf" : to_string(m_distances[pair.first]);
-        pair.second.distLabel.setString(distStr);
-        pair.second.distLabel.setPosition(pair.second.shape.getPosition() + sf::Vector2f(0, 35));
-        m_window.draw(pair.second.shape);
-        m_window.draw(pair.second.label);
-        m_window.draw(pair.second.distLabel);
+    if (m_mode == BellmanFordMode::Queue) {
+        for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+            sf::Color color = u == m_arcSource ? sf::Color::Yellow : (m_queued[u] ? sf::Color(255, 140, 0) : sf::Color(100, 100, 250));
+            m_renderer.setNodeColor(u, color);
+        }
+    }
+    for (size_t u = 0; u < m_distLabels.size(); ++u) { // None on graphs too large to label
+        string distStr = (m_distances[u] == numeric_limits<int>::max()) ? "inf" : to_string(m_distances[u]);
+        m_renderer.setLabelText(m_distLabels[u], distStr);
     }
-    string status = m_isDone ? (m_negativeCycle ? "Negative Cycle Detected!" : "Complete!") : (m_isVisualizing ? "Iter " + to_string(m_iteration+1) : "Paused.");
+    m_renderer.draw(*m_window, m_font);
+    string progress = m_mode == BellmanFordMode::Queue ? "Queue " + to_string(m_queue.size()) : "Pass " + to_string(m_iteration + 1);
+    string status = m_isDone ? (m_negativeCycle ? "Negative Cycle Detected!" : "Complete!") : (m_isVisualizing ? progress : "Paused.");
     sf::Text infoText("Bellman-Ford | " + status, m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    const BellmanFordStats& stats = m_engine->getStats();
+    string engine = "M: " + string(bellmanFordModeName(m_mode)) + " | full run: " + to_string(stats.passes) + " passes, " +
+                    to_string(stats.dequeues) + " dequeues, " + to_string(stats.relaxations) + " relaxations, " +
+                    to_string(static_cast<long long>(m_engineMs)) + " ms";
+    if (!m_cycleEdges.empty()) engine += ", negative cycle of " + to_string(m_cycleEdges.size()) + " edges";
+    sf::Text engineText(engine, m_font, 18);
+    engineText.setFillColor(sf::Color(200, 200, 200));
+    engineText.setPosition(10, 38);
+    m_window->draw(engineText);
 }
@@ -0,0 +1,561 @@
+#include "Benchmark.h"
+#include "CommandLine.h"
+#include "DataGenerator.h"
+#include "DeltaStepping.h"
+#include "FloydWarshall.h"
+#include "GraphLoader.h"
+#include "Johnson.h"
+#include "PriorityQueues.h"
+#include "SortEngines.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    // Thrown by the counter to abandon a run that exceeds its budget
+    struct BudgetExceeded {};
+
+    struct BudgetedCounter : OperationCounter {
+        unsigned long long budget;
+        explicit BudgetedCounter(unsigned long long maxComparisons) : budget(maxComparisons) {}
+        void compare(int, int) {
+            if (++comparisons > budget) throw BudgetExceeded();
+        }
+    };
+
+    /**
+     * Collects rows of named columns and prints them as an aligned table,
+     * CSV or JSON. Table and CSV rows are written as soon as they arrive.
+     */
+    class Report {
+    private:
+        struct Column { string name; int width; bool numeric; };
+        vector<Column> m_columns;
+        vector<vector<string>> m_rows;
+        string m_format;
+        ostream& m_out;
+
+    public:
+        Report(const string& format, ostream& out) : m_format(format), m_out(out) {}
+
+        void addColumn(const string& name, int width, bool numeric) { m_columns.push_back({name, width, numeric}); }
+
+        void begin() {
+            if (m_format == "json") return;
+            for (size_t c = 0; c < m_columns.size(); ++c) {
+                if (m_format == "csv") m_out << (c ? "," : "") << m_columns[c].name;
+                else m_out << (c ? "  " : "") << (m_columns[c].numeric ? right : left) << setw(m_columns[c].width) << m_columns[c].name;
+            }
+            m_out << endl;
+        }
+
+        void addRow(const vector<string>& row) {
+            if (m_format == "json") {
+                m_rows.push_back(row);
+                return;
+            }
+            for (size_t c = 0; c < row.size(); ++c) {
+                if (m_format == "csv") m_out << (c ? "," : "") << row[c];
+                else m_out << (c ? "  " : "") << (m_columns[c].numeric ? right : left) << setw(m_columns[c].width) << row[c];
+            }
+            m_out << endl;
+        }
+
+        void end(const string& suite, unsigned long long seed) {
+            if (m_format != "json") return;
+            m_out << "{\n  \"suite\": \"" << suite << "\",\n  \"seed\": " << seed << ",\n  \"results\": [";
+            for (size_t r = 0; r < m_rows.size(); ++r) {
+                m_out << (r ? ",\n" : "\n") << "    {";
+                for (size_t c = 0; c < m_columns.size(); ++c) {
+                    bool quoted = !m_columns[c].numeric;
+                    const string& value = m_rows[r][c] == "-" && !quoted ? "null" : m_rows[r][c]; // Not applicable
+                    m_out << (c ? ", " : "") << '"' << m_columns[c].name << "\": "
+                          << (quoted ? "\"" : "") << value << (quoted ? "\"" : "");
+                }
+                m_out << "}";
+            }
+            m_out << "\n  ]\n}" << endl;
+        }
+    };
+
+    vector<string> splitList(const string& list) {
+        vector<string> items;
+        stringstream stream(list);
+        string item;
+        while (getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    // "Quick Sort" -> "quick"
+    string sortShortName(SortAlgorithm algorithm) {
+        string name = sortAlgorithmName(algorithm);
+        name = name.substr(0, name.find(' '));
+        transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        return name;
+    }
+
+    string formatNumber(double value, int precision) {
+        ostringstream text;
+        text << fixed << setprecision(precision) << value;
+        return text.str();
+    }
+
+    struct SortLimits {
+        unsigned long long quadraticMax;
+        unsigned long long maxOps;
+        int repeat;
+    };
+
+    // Runs every algorithm on one input; returns false if any result was wrong
+    template <typename T>
+    bool benchmarkSorts(const DataSpec& spec, const vector<SortAlgorithm>& algorithms, const SortLimits& limits, Report& report) {
+        const vector<T> input = DataGenerator(spec).generate<T>();
+        vector<T> expected = input;
+        sort(expected.begin(), expected.end());
+
+        bool correct = true;
+        for (SortAlgorithm algorithm : algorithms) {
+            if (isQuadraticSort(algorithm) && spec.count > limits.quadraticMax) continue;
+
+            OperationCounter counts;
+            double bestSeconds = 0.0;
+            string status = "ok";
+            for (int r = 0; r < limits.repeat && status == "ok"; ++r) {
+                vector<T> data = input;
+                BudgetedCounter counter(limits.maxOps);
+                auto begin = chrono::steady_clock::now();
+                try {
+                    runSortEngine(algorithm, data, counter);
+                } catch (const BudgetExceeded&) {
+                    status = "over-budget";
+                }
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+                if (status == "ok" && data != expected) status = "WRONG";
+                if (r == 0 || seconds < bestSeconds) bestSeconds = seconds;
+                counts = counter;
+            }
+            if (status == "WRONG") correct = false;
+
+            report.addRow({sortShortName(algorithm), distributionName(spec.distribution), to_string(spec.count),
+                           to_string(counts.comparisons), to_string(counts.swaps), to_string(counts.writes),
+                           formatNumber(bestSeconds * 1000.0, 3), formatNumber(bestSeconds * 1e9 / spec.count, 2), status});
+        }
+        return correct;
+    }
+
+    int runSortSuite(const vector<string>& args) {
+        vector<SortAlgorithm> algorithms(begin(ALL_SORT_ALGORITHMS), end(ALL_SORT_ALGORITHMS));
+        vector<Distribution> distributions(begin(ALL_DISTRIBUTIONS), end(ALL_DISTRIBUTIONS));
+        unsigned long long minSize = 100, maxSize = 1000000, quadraticMax = 10000;
+        unsigned long long maxOps = 4000000000ULL, seed = 1;
+        int repeat = 1, keyBits = 32;
+        string format = "table", outputPath;
+        bool valid = true;
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const string& arg = args[i];
+            if (i + 1 >= args.size()) {
+                cerr << "Missing value for benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            const string& value = args[++i];
+            if (arg == "--algorithms") {
+                algorithms.clear();
+                for (const string& name : splitList(value)) {
+                    auto match = find_if(begin(ALL_SORT_ALGORITHMS), end(ALL_SORT_ALGORITHMS),
+                                         [&](SortAlgorithm a) { return sortShortName(a) == name; });
+                    if (match == end(ALL_SORT_ALGORITHMS)) {
+                        cerr << "Unknown sort '" << name << "'" << endl;
+                        return 1;
+                    }
+                    algorithms.push_back(*match);
+                }
+            } else if (arg == "--distributions") {
+                distributions.clear();
+                for (const string& name : splitList(value)) {
+                    Distribution distribution;
+                    if (!parseDistribution(name, distribution)) {
+                        cerr << "Unknown distribution '" << name << "'" << endl;
+                        return 1;
+                    }
+                    distributions.push_back(distribution);
+                }
+            }
+            else if (arg == "--min-size") valid = parseOption(arg, value, minSize);
+            else if (arg == "--max-size") valid = parseOption(arg, value, maxSize);
+            else if (arg == "--quadratic-max") valid = parseOption(arg, value, quadraticMax);
+            else if (arg == "--max-ops") valid = parseOption(arg, value, maxOps);
+            else if (arg == "--repeat") valid = parseOption(arg, value, repeat);
+            else if (arg == "--seed") valid = parseOption(arg, value, seed);
+            else if (arg == "--key-bits") valid = parseOption(arg, value, keyBits);
+            else if (arg == "--format") format = value;
+            else if (arg == "--output") outputPath = value;
+            else {
+                cerr << "Unknown benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            if (!valid) return 1;
+        }
+        minSize = max(1ULL, minSize);
+        repeat = max(1, repeat);
+        if (keyBits != 32 && keyBits != 64) {
+            cerr << "--key-bits must be 32 or 64" << endl;
+            return 1;
+        }
+        if (format != "table" && format != "csv" && format != "json") {
+            cerr << "Unknown report format '" << format << "'" << endl;
+            return 1;
+        }
+
+        ofstream file;
+        if (!outputPath.empty()) {
+            file.open(outputPath);
+            if (!file) {
+                cerr << "Error opening '" << outputPath << "' for writing" << endl;
+                return 1;
+            }
+        }
+        Report report(format, outputPath.empty() ? cout : file);
+        report.addColumn("algorithm", 9, false);
+        report.addColumn("distribution", 13, false);
+        report.addColumn("n", 10, true);
+        report.addColumn("comparisons", 15, true);
+        report.addColumn("swaps", 13, true);
+        report.addColumn("writes", 13, true);
+        report.addColumn("ms", 11, true);
+        report.addColumn("ns_per_element", 14, true);
+        report.addColumn("status", 11, false);
+        report.begin();
+        SortLimits limits = {quadraticMax, maxOps, repeat};
+
+        bool failed = false;
+        for (unsigned long long n = minSize; n <= maxSize; n *= 10) {
+            for (Distribution distribution : distributions) {
+                DataSpec spec;
+                spec.distribution = distribution;
+                spec.count = n;
+                spec.seed = seed;
+                if (keyBits == 64) {
+                    spec.minValue = INT64_MIN;
+                    spec.maxValue = INT64_MAX;
+                    failed |= !benchmarkSorts<int64_t>(spec, algorithms, limits, report);
+                } else {
+                    failed |= !benchmarkSorts<int>(spec, algorithms, limits, report);
+                }
+            }
+            if (n > maxSize / 10) break; // Avoid overflowing past the largest size
+        }
+        report.end("sorts", seed);
+        return failed ? 1 : 0;
+    }
+
+    // `degree` arcs out of every node to uniformly random targets
+    vector<GraphEdge> generateRandomGraph(int nodes, int degree, int maxWeight, uint64_t seed) {
+        vector<GraphEdge> edges(static_cast<size_t>(nodes) * degree);
+        ThreadPool::getInstance().parallelFor(edges.size(), 1 << 16, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                edges[i].from = static_cast<int>(i / degree);
+                edges[i].to = static_cast<int>(randomAt(seed, 2 * i) % nodes);
+                edges[i].weight = 1 + static_cast<int>(randomAt(seed, 2 * i + 1) % maxWeight);
+            }
+        });
+        return edges;
+    }
+
+    // Sequential reference: Dijkstra with the indexed 4-ary heap
+    vector<int64_t> dijkstraDistances(const Graph& graph, int source) {
+        vector<int64_t> distances(graph.getNodeCount(), DeltaStepping::UNREACHED);
+        vector<bool> settled(graph.getNodeCount(), false);
+        IndexedDaryHeap<4> heap(graph.getNodeCount());
+        distances[source] = 0;
+        heap.update(source, 0);
+        int u;
+        int64_t key;
+        while (heap.pop(u, key)) {
+            settled[u] = true;
+            for (size_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                int v = graph.getTarget(arc);
+                int64_t distance = key + graph.getWeight(arc);
+                if (distance < distances[v] && !settled[v]) {
+                    distances[v] = distance;
+                    heap.update(v, distance);
+                }
+            }
+        }
+        return distances;
+    }
+
+    int runShortestPathSuite(const vector<string>& args) {
+        string graphPath, format = "table", outputPath;
+        unsigned long long nodes = 1000000, degree = 8, maxWeight = 1000, seed = 1;
+        long long source = 0, delta = 0;
+        int repeat = 1;
+        vector<unsigned> threadCounts;
+        bool valid = true;
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const string& arg = args[i];
+            if (i + 1 >= args.size()) {
+                cerr << "Missing value for benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            const string& value = args[++i];
+            if (arg == "--graph") graphPath = value;
+            else if (arg == "--nodes") valid = parseOption(arg, value, nodes);
+            else if (arg == "--degree") valid = parseOption(arg, value, degree);
+            else if (arg == "--max-weight") valid = parseOption(arg, value, maxWeight);
+            else if (arg == "--source") valid = parseOption(arg, value, source);
+            else if (arg == "--delta") valid = parseOption(arg, value, delta);
+            else if (arg == "--threads") {
+                for (const string& count : splitList(value)) {
+                    unsigned threads = 0;
+                    if (!(valid = parseOption(arg, count, threads))) break;
+                    threadCounts.push_back(max(1u, threads));
+                }
+            }
+            else if (arg == "--repeat") valid = parseOption(arg, value, repeat);
+            else if (arg == "--seed") valid = parseOption(arg, value, seed);
+            else if (arg == "--format") format = value;
+            else if (arg == "--output") outputPath = value;
+            else {
+                cerr << "Unknown benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            if (!valid) return 1;
+        }
+        nodes = max(1ULL, nodes);
+        maxWeight = max(1ULL, maxWeight);
+        repeat = max(1, repeat);
+        if (format != "table" && format != "csv" && format != "json") {
+            cerr << "Unknown report format '" << format << "'" << endl;
+            return 1;
+        }
+        if (nodes > INT32_MAX || maxWeight > INT32_MAX || degree > INT32_MAX / nodes) {
+            cerr << "Random graph too large" << endl;
+            return 1;
+        }
+        if (threadCounts.empty()) {
+            for (unsigned t = 1; t < ThreadPool::getInstance().getThreadCount(); t *= 2) threadCounts.push_back(t);
+            threadCounts.push_back(ThreadPool::getInstance().getThreadCount());
+        }
+
+        Graph graph;
+        if (!graphPath.empty()) {
+            GraphFile file;
+            if (!loadGraphFile(graphPath, file)) return 1;
+            graph = Graph(file.nodeCount, file.edges, file.directed);
+        } else {
+            graph = Graph(static_cast<int>(nodes), generateRandomGraph(static_cast<int>(nodes), static_cast<int>(degree), static_cast<int>(maxWeight), seed), true);
+        }
+        if (source < 0 || source >= graph.getNodeCount()) {
+            cerr << "--source must be a node of the graph" << endl;
+            return 1;
+        }
+        if (delta <= 0) delta = DeltaStepping::suggestDelta(graph);
+
+        ofstream file;
+        if (!outputPath.empty()) {
+            file.open(outputPath);
+            if (!file) {
+                cerr << "Error opening '" << outputPath << "' for writing" << endl;
+                return 1;
+            }
+        }
+        Report report(format, outputPath.empty() ? cout : file);
+        report.addColumn("algorithm", 14, false);
+        report.addColumn("threads", 7, true);
+        report.addColumn("delta", 8, true);
+        report.addColumn("ms", 11, true);
+        report.addColumn("speedup", 7, true);
+        report.addColumn("vs_dijkstra", 11, true);
+        report.addColumn("rounds", 9, true);
+        report.addColumn("relaxations", 13, true);
+        report.addColumn("status", 6, false);
+        report.begin();
+
+        auto bestOf = [&](const function<void()>& run) {
+            double best = 0.0;
+            for (int r = 0; r < repeat; ++r) {
+                auto begin = chrono::steady_clock::now();
+                run();
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+                if (r == 0 || seconds < best) best = seconds;
+            }
+            return best;
+        };
+
+        vector<int64_t> expected;
+        double dijkstraSeconds = bestOf([&] { expected = dijkstraDistances(graph, static_cast<int>(source)); });
+        report.addRow({"dijkstra", "1", "-", formatNumber(dijkstraSeconds * 1000.0, 3), "-", "1.00", "-", to_string(graph.getArcCount()), "ok"});
+
+        // Speedup is relative to the first (normally single-threaded) delta-stepping run
+        DeltaStepping engine(graph);
+        double baseSeconds = 0.0;
+        bool failed = false;
+        for (unsigned threads : threadCounts) {
+            bool ran = true;
+            double seconds = bestOf([&] { ran = engine.run(static_cast<int>(source), delta, threads); });
+            if (!ran) return 1;
+            if (baseSeconds == 0.0) baseSeconds = seconds;
+            bool correct = engine.getDistances() == expected;
+            failed |= !correct;
+            const DeltaSteppingStats& stats = engine.getStats();
+            report.addRow({"delta-stepping", to_string(threads), to_string(delta), formatNumber(seconds * 1000.0, 3),
+                           formatNumber(baseSeconds / seconds, 2), formatNumber(dijkstraSeconds / seconds, 2),
+                           to_string(stats.phases), to_string(stats.relaxations), correct ? "ok" : "WRONG"});
+        }
+        report.end("sssp", seed);
+        return failed ? 1 : 0;
+    }
+
+    int runAllPairsSuite(const vector<string>& args) {
+        string format = "table", outputPath;
+        unsigned long long nodes = 1024, maxWeight = 1000, seed = 1;
+        int repeat = 1;
+        unsigned threads = 0;
+        vector<unsigned long long> degrees;
+        bool valid = true;
+
+        for (size_t i = 0; i < args.size(); ++i) {
+            const string& arg = args[i];
+            if (i + 1 >= args.size()) {
+                cerr << "Missing value for benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            const string& value = args[++i];
+            if (arg == "--nodes") valid = parseOption(arg, value, nodes);
+            else if (arg == "--degrees") {
+                for (const string& text : splitList(value)) {
+                    unsigned long long degree = 0;
+                    if (!(valid = parseOption(arg, text, degree))) break;
+                    degrees.push_back(max(1ULL, degree));
+                }
+            }
+            else if (arg == "--max-weight") valid = parseOption(arg, value, maxWeight);
+            else if (arg == "--threads") valid = parseOption(arg, value, threads);
+            else if (arg == "--repeat") valid = parseOption(arg, value, repeat);
+            else if (arg == "--seed") valid = parseOption(arg, value, seed);
+            else if (arg == "--format") format = value;
+            else if (arg == "--output") outputPath = value;
+            else {
+                cerr << "Unknown benchmark option '" << arg << "'" << endl;
+                return 1;
+            }
+            if (!valid) return 1;
+        }
+        nodes = max(1ULL, nodes);
+        maxWeight = max(1ULL, maxWeight);
+        repeat = max(1, repeat);
+        if (format != "table" && format != "csv" && format != "json") {
+            cerr << "Unknown report format '" << format << "'" << endl;
+            return 1;
+        }
+        if (nodes > 8192) {
+            cerr << "APSP benchmark limited to 8192 nodes" << endl;
+            return 1;
+        }
+        // Divided rather than multiplied, so the check cannot wrap
+        if (maxWeight > INT32_MAX || (nodes > 1 && maxWeight >= FloydWarshall::INF / (nodes - 1))) {
+            cerr << "--max-weight too large: path lengths must stay below " << FloydWarshall::INF << endl;
+            return 1;
+        }
+        if (degrees.empty()) {
+            for (unsigned long long d = 1; d < nodes; d *= 2) degrees.push_back(d);
+            degrees.push_back(nodes);
+        }
+
+        ofstream file;
+        if (!outputPath.empty()) {
+            file.open(outputPath);
+            if (!file) {
+                cerr << "Error opening '" << outputPath << "' for writing" << endl;
+                return 1;
+            }
+        }
+        ostream& out = outputPath.empty() ? cout : file;
+        Report report(format, out);
+        report.addColumn("degree", 7, true);
+        report.addColumn("arcs", 11, true);
+        report.addColumn("density", 8, true);
+        report.addColumn("floyd_ms", 11, true);
+        report.addColumn("johnson_ms", 11, true);
+        report.addColumn("faster", 14, false);
+        report.addColumn("status", 6, false);
+        report.begin();
+
+        auto bestOf = [&](const function<void()>& run) {
+            double best = 0.0;
+            for (int r = 0; r < repeat; ++r) {
+                auto begin = chrono::steady_clock::now();
+                run();
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+                if (r == 0 || seconds < best) best = seconds;
+            }
+            return best;
+        };
+
+        // Both times include filling their matrix
+        int n = static_cast<int>(nodes);
+        bool failed = false;
+        unsigned long long lastJohnsonWin = 0, firstFloydWin = 0;
+        for (unsigned long long degree : degrees) {
+            if (degree > INT32_MAX / nodes) break;
+            Graph graph(n, generateRandomGraph(n, static_cast<int>(degree), static_cast<int>(maxWeight), seed), true);
+            unique_ptr<FloydWarshall> floyd;
+            double floydSeconds = bestOf([&] {
+                floyd = make_unique<FloydWarshall>(n);
+                for (int u = 0; u < n; ++u) {
+                    for (size_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) floyd->addEdge(u, graph.getTarget(arc), graph.getWeight(arc));
+                }
+                floyd->run(threads);
+            });
+            unique_ptr<Johnson> johnson;
+            double johnsonSeconds = bestOf([&] {
+                johnson = make_unique<Johnson>(graph);
+                johnson->run(threads);
+            });
+
+            bool correct = true;
+            for (int u = 0; u < n && correct; ++u) {
+                for (int v = 0; v < n && correct; ++v) correct = floyd->getDistance(u, v) == johnson->getDistance(u, v);
+            }
+            failed |= !correct;
+            bool johnsonFaster = johnsonSeconds < floydSeconds;
+            if (johnsonFaster && !firstFloydWin) lastJohnsonWin = degree;
+            if (!johnsonFaster && !firstFloydWin && lastJohnsonWin) firstFloydWin = degree;
+            report.addRow({to_string(degree), to_string(graph.getArcCount()), formatNumber(static_cast<double>(graph.getArcCount()) / nodes / nodes, 4),
+                           formatNumber(floydSeconds * 1000.0, 3), formatNumber(johnsonSeconds * 1000.0, 3),
+                           johnsonFaster ? "johnson" : "floyd-warshall", correct ? "ok" : "WRONG"});
+        }
+        report.end("apsp", seed);
+
+        // The summary goes with a table; with csv or json it would spoil the file
+        ostream& summary = format == "table" ? out : cerr;
+        if (!lastJohnsonWin) summary << "Blocked Floyd-Warshall was faster at every degree tried." << endl;
+        else if (!firstFloydWin) summary << "Johnson was faster at every degree tried." << endl;
+        else summary << "Crossover: Johnson is faster up to degree " << lastJohnsonWin << ", blocked Floyd-Warshall from degree "
+                     << firstFloydWin << " (" << FloydWarshall::getKernelName() << " kernel, " << nodes << " nodes)." << endl;
+        return failed ? 1 : 0;
+    }
+}
+
+int runBenchmark(const vector<string>& args) {
+    if (!args.empty() && args[0] == "sorts") return runSortSuite(vector<string>(args.begin() + 1, args.end()));
+    if (!args.empty() && args[0] == "sssp") return runShortestPathSuite(vector<string>(args.begin() + 1, args.end()));
+    if (!args.empty() && args[0] == "apsp") return runAllPairsSuite(vector<string>(args.begin() + 1, args.end()));
+
+    cerr << "Usage: --bench <suite> [options]\nSuites:\n  sorts\n  sssp\n  apsp" << endl;
+    return 1;
+}
@@ -0,0 +1,135 @@
+#include "Boruvka.h"
+#include "Kruskal.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+using namespace std;
+
+namespace {
+
+const uint64_t NO_EDGE = ~0ull;
+
+// Keeps the items that pass `keep`, in order, in parallel chunks that are
+// then moved together; returns how many are left
+template <typename Keep>
+size_t compact(int* items, size_t count, size_t grain, unsigned threads, Keep keep) {
+    vector<size_t> chunkKept((count + grain - 1) / grain);
+    ThreadPool::getInstance().parallelFor(count, grain, [&](size_t begin, size_t end) {
+        size_t out = begin;
+        for (size_t i = begin; i < end; ++i) {
+            if (keep(items[i])) items[out++] = items[i];
+        }
+        chunkKept[begin / grain] = out - begin;
+    }, threads);
+    size_t kept = 0;
+    for (size_t c = 0; c < chunkKept.size(); ++c) {
+        memmove(items + kept, items + c * grain, chunkKept[c] * sizeof(int));
+        kept += chunkKept[c];
+    }
+    return kept;
+}
+
+} // namespace
+
+Boruvka::Boruvka(int nodeCount, const vector<GraphEdge>& edges) : m_nodeCount(nodeCount), m_edges(edges) {}
+
+void Boruvka::run(unsigned threads, vector<BoruvkaRound>* rounds) {
+    ThreadPool& pool = ThreadPool::getInstance();
+    int n = m_nodeCount;
+    m_tree.clear();
+    m_stats = BoruvkaStats();
+    if (rounds) rounds->clear();
+
+    m_component.resize(n);
+    vector<int> roots(n);
+    for (int v = 0; v < n; ++v) m_component[v] = roots[v] = v;
+
+    vector<int> live(m_edges.size());
+    for (size_t i = 0; i < live.size(); ++i) live[i] = static_cast<int>(i);
+    live.resize(compact(live.data(), live.size(), GRAIN, threads,
+                        [&](int edge) { return m_edges[edge].from != m_edges[edge].to; }));
+
+    unique_ptr<atomic<uint64_t>[]> best(new atomic<uint64_t>[n]);
+    vector<int> next(n), jumped(n);
+
+    while (!live.empty()) {
+        BoruvkaRound round;
+        round.componentsBefore = static_cast<int>(roots.size());
+        round.liveEdges = live.size();
+        m_stats.rounds++;
+        m_stats.scanned += live.size();
+
+        // Cheapest outgoing edge of every component
+        pool.parallelFor(roots.size(), GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) best[roots[i]].store(NO_EDGE, memory_order_relaxed);
+        }, threads);
+        auto offer = [&](int component, uint64_t key) {
+            uint64_t current = best[component].load(memory_order_relaxed);
+            while (key < current && !best[component].compare_exchange_weak(current, key, memory_order_relaxed)) {}
+        };
+        pool.parallelFor(live.size(), GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const GraphEdge& edge = m_edges[live[i]];
+                uint64_t key = Kruskal::packKey(edge.weight, static_cast<uint32_t>(live[i]));
+                offer(m_component[edge.from], key);
+                offer(m_component[edge.to], key);
+            }
+        }, threads);
+
+        // Point each component across its edge; of a pair that picked the
+        // same edge, the lower id stays a root and the edge is added once
+        pool.parallelFor(roots.size(), GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                int c = roots[i];
+                uint64_t key = best[c].load(memory_order_relaxed);
+                if (key == NO_EDGE) { next[c] = c; continue; }
+                const GraphEdge& edge = m_edges[Kruskal::keyEdge(key)];
+                next[c] = m_component[edge.from] == c ? m_component[edge.to] : m_component[edge.from];
+            }
+        }, threads);
+        pool.parallelFor(roots.size(), GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                int c = roots[i];
+                int target = next[c];
+                jumped[c] = (next[target] == c && c < target) ? c : target;
+            }
+        }, threads);
+        swap(next, jumped);
+        for (int c : roots) {
+            if (next[c] == c) continue;
+            int edge = Kruskal::keyEdge(best[c].load(memory_order_relaxed));
+            round.edges.push_back(edge);
+            m_tree.push_back(edge);
+            m_stats.treeWeight += m_edges[edge].weight;
+        }
+
+        // Pointer jumping until every component points at its new root
+        atomic<bool> changed(true);
+        while (changed.load()) {
+            changed.store(false);
+            pool.parallelFor(roots.size(), GRAIN, [&](size_t begin, size_t end) {
+                bool any = false;
+                for (size_t i = begin; i < end; ++i) {
+                    int c = roots[i];
+                    jumped[c] = next[next[c]];
+                    any |= jumped[c] != next[c];
+                }
+                if (any) changed.store(true, memory_order_relaxed);
+            }, threads);
+            swap(next, jumped);
+        }
+
+        pool.parallelFor(n, GRAIN, [&](size_t begin, size_t end) {
+            for (size_t v = begin; v < end; ++v) m_component[v] = next[m_component[v]];
+        }, threads);
+        roots.resize(compact(roots.data(), roots.size(), GRAIN, threads, [&](int c) { return next[c] == c; }));
+        live.resize(compact(live.data(), live.size(), GRAIN, threads, [&](int edge) {
+            return m_component[m_edges[edge].from] != m_component[m_edges[edge].to];
+        }));
+
+        round.componentsAfter = static_cast<int>(roots.size());
+        if (rounds) rounds->push_back(move(round));
+    }
+}
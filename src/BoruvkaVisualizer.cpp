@@ -0,0 +1,166 @@
+#include "BoruvkaVisualizer.h"
+#include "GraphLoader.h"
+#include "Kruskal.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+using namespace std;
+
+BoruvkaVisualizer::BoruvkaVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_nodeCount(0), m_threads(ThreadPool::getInstance().getThreadCount()), m_engineMs(0.0),
+      m_kruskalWeight(0), m_roundIndex(0), m_showingPicks(false), m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 1.0); // One step every 1.0s by default
+}
+
+// Same example as Kruskal's and Prim's, so the trees can be compared
+void BoruvkaVisualizer::buildGraph() {
+    m_edges.clear(); m_renderer.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, sf::Color::White, sf::Color::Black);
+        m_edges = file->edges;
+        m_nodeCount = file->nodeCount;
+        return;
+    }
+    map<int, sf::Vector2f> positions = {
+        {0, {150, 200}}, {1, {150, 500}}, {2, {450, 350}},
+        {3, {750, 200}}, {4, {750, 500}}, {5, {1050, 350}}
+    };
+    for(const auto& p : positions) {
+        m_renderer.addNode(p.second, sf::Color::White);
+        m_renderer.addLabel(p.second, to_string(p.first), 24, sf::Color::Black);
+    }
+    m_nodeCount = positions.size();
+    auto addEdge = [&](int u, int v, int w) {
+        m_edges.push_back({u, v, w});
+        m_renderer.addEdge(u, v);
+        sf::Vector2f middle = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+        m_renderer.addLabel(middle, to_string(w), 20, sf::Color::White, false);
+    };
+    addEdge(0, 1, 7); addEdge(0, 2, 1); addEdge(1, 2, 5); addEdge(2, 3, 6);
+    addEdge(2, 4, 2); addEdge(3, 4, 4); addEdge(3, 5, 3); addEdge(4, 5, 8);
+}
+
+// Times a recorded run (the record is only the tree edges, so it costs
+// next to nothing) and runs Kruskal for the weight check
+void BoruvkaVisualizer::runEngine() {
+    m_engine = make_unique<Boruvka>(m_nodeCount, m_edges);
+    auto startTime = chrono::steady_clock::now();
+    m_engine->run(m_threads, &m_rounds);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+
+    Kruskal kruskal(m_nodeCount, m_edges);
+    kruskal.run(KruskalMode::Filter, m_threads);
+    m_kruskalWeight = kruskal.getStats().treeWeight;
+
+    const BoruvkaStats& stats = m_engine->getStats();
+    cout << "Boruvka (" << m_threads << " threads): " << m_engineMs << " ms, " << stats.rounds << " rounds, "
+         << m_engine->getTreeEdges().size() << " tree edges of weight " << stats.treeWeight
+         << " (Kruskal: " << m_kruskalWeight << "), " << stats.scanned << " edge visits." << endl;
+}
+
+void BoruvkaVisualizer::reset() {
+    buildGraph();
+    runEngine();
+    m_sets.reset(m_nodeCount);
+    m_inTree.assign(m_edges.size(), false);
+    m_roundIndex = 0;
+    m_showingPicks = false;
+    m_isVisualizing = false;
+    m_isDone = false;
+    cout << "Boruvka's reset. Press SPACE to start." << endl;
+}
+
+void BoruvkaVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
+void BoruvkaVisualizer::handleEvent(sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
+        if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::T) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            reset();
+        }
+    }
+}
+
+sf::Color BoruvkaVisualizer::getComponentColor(int node) {
+    static const sf::Color palette[] = {
+        {255, 170, 170}, {170, 220, 255}, {190, 255, 170}, {255, 225, 150}, {220, 180, 255},
+        {150, 240, 230}, {255, 190, 230}, {230, 230, 160}, {200, 200, 255}, {255, 200, 160}
+    };
+    return palette[m_sets.findRoot(node) % size(palette)];
+}
+
+void BoruvkaVisualizer::mergeRound(const BoruvkaRound& round) {
+    for (int edge : round.edges) {
+        m_sets.unite(m_edges[edge].from, m_edges[edge].to);
+        m_inTree[edge] = true;
+    }
+    for (int v = 0; v < m_nodeCount; ++v) m_renderer.setNodeColor(v, getComponentColor(v));
+    for (size_t i = 0; i < m_edges.size(); ++i) {
+        sf::Color color = sf::Color::White;
+        if (m_inTree[i]) color = sf::Color::Green;
+        else if (m_sets.findRoot(m_edges[i].from) == m_sets.findRoot(m_edges[i].to)) color = sf::Color(90, 90, 90);
+        m_renderer.setEdgeColor(i, color);
+    }
+}
+
+bool BoruvkaVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+
+    if (m_roundIndex >= m_rounds.size()) {
+        m_isDone = true; m_isVisualizing = false;
+    } else if (!m_showingPicks) {
+        for (int edge : m_rounds[m_roundIndex].edges) m_renderer.setEdgeColor(edge, sf::Color::Yellow);
+        m_showingPicks = true;
+    } else {
+        mergeRound(m_rounds[m_roundIndex++]);
+        m_showingPicks = false;
+    }
+    return true;
+}
+
+void BoruvkaVisualizer::draw() {
+    m_window->clear(sf::Color(30, 30, 30));
+    m_renderer.draw(*m_window, m_font);
+    std::string statusText;
+    if (m_isDone)
+        statusText = "Complete!";
+    else if (m_isVisualizing)
+        statusText = "Visualizing...";
+    else
+        statusText = "Paused.";
+    sf::Text infoText("Boruvka's Algorithm (MST) | " + statusText, m_font, 20);
+    infoText.setPosition(10, 10);
+    m_window->draw(infoText);
+
+    ostringstream progress;
+    if (m_roundIndex < m_rounds.size()) {
+        const BoruvkaRound& round = m_rounds[m_roundIndex];
+        progress << "Round " << m_roundIndex + 1 << "/" << m_rounds.size() << ": " << round.componentsBefore << " components, "
+                 << round.liveEdges << " live edges, " << round.edges.size() << " cheapest edges"
+                 << (m_showingPicks ? " (yellow) -> " + to_string(round.componentsAfter) + " components" : "");
+    } else {
+        progress << m_rounds.size() << " rounds, " << (m_rounds.empty() ? m_nodeCount : m_rounds.back().componentsAfter) << " components left";
+    }
+    sf::Text progressText(progress.str(), m_font, 18);
+    progressText.setFillColor(sf::Color(200, 200, 200));
+    progressText.setPosition(10, 38);
+    m_window->draw(progressText);
+
+    const BoruvkaStats& stats = m_engine->getStats();
+    ostringstream run;
+    run << "T threads: " << m_threads << " | full run: " << fixed << setprecision(2) << m_engineMs << " ms, "
+        << stats.scanned << " edge visits, tree weight " << stats.treeWeight
+        << (stats.treeWeight == m_kruskalWeight ? " (matches Kruskal)" : " (Kruskal: " + to_string(m_kruskalWeight) + ")");
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 62);
+    m_window->draw(runText);
+}
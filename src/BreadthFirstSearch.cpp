@@ -0,0 +1,190 @@
+#include "BreadthFirstSearch.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+using namespace std;
+
+BreadthFirstSearch::BreadthFirstSearch(const Graph& graph)
+    : m_graph(graph), m_hasIncoming(false), m_mode(BfsMode::DirectionOptimizing), m_threads(0), m_words(0) {
+    clear();
+}
+
+void BreadthFirstSearch::clear() {
+    int n = m_graph.getNodeCount();
+    m_words = (static_cast<size_t>(n) + 63) / 64;
+    m_visited.reset(new atomic<uint64_t>[m_words]);
+    m_frontierBits.reset(new atomic<uint64_t>[m_words]);
+    for (size_t word = 0; word < m_words; ++word) {
+        m_visited[word].store(0, memory_order_relaxed);
+        m_frontierBits[word].store(0, memory_order_relaxed);
+    }
+    if (n % 64 != 0) m_visited[m_words - 1].store(~0ull << (n % 64)); // Bits past the last node count as visited
+    m_frontier.clear();
+    m_previousFrontier.clear();
+    m_depth.assign(n, -1);
+    m_worker.assign(n, 0);
+    m_frontierArcs = 0;
+    m_unexploredArcs = m_graph.getArcCount();
+    m_currentDepth = 0;
+    m_direction = BfsDirection::TopDown;
+    m_levels.clear();
+    m_stats = BfsStats();
+}
+
+bool BreadthFirstSearch::start(int source) {
+    if (isVisited(source)) return false;
+    setBit(m_visited, source);
+    m_frontier.assign(1, source);
+    m_previousFrontier.clear();
+    m_depth[source] = 0;
+    m_worker[source] = 0;
+    m_frontierArcs = m_graph.getDegree(source);
+    m_unexploredArcs -= m_frontierArcs;
+    m_currentDepth = 0;
+    m_direction = BfsDirection::TopDown;
+    m_stats.reached++;
+    return true;
+}
+
+// Bookkeeping for a node whose visited bit the caller has set
+inline void BreadthFirstSearch::visit(int node, Part& part, vector<int>& nodes) {
+    nodes.push_back(node);
+    m_depth[node] = m_currentDepth + 1;
+    m_worker[node] = part.worker;
+    part.arcs += m_graph.getDegree(node);
+}
+
+// With `shared` set other tasks may claim the same nodes, so claims are
+// atomic ORs; a plain read first skips most visited targets without one
+inline void BreadthFirstSearch::expand(int u, Part& part, vector<int>& nodes, bool shared) {
+    part.inspected += m_graph.getDegree(u);
+    for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+        int v = m_graph.getTarget(arc);
+        atomic<uint64_t>& visited = m_visited[v >> 6];
+        uint64_t mask = 1ull << (v & 63);
+        uint64_t current = visited.load(memory_order_relaxed);
+        if (current & mask) continue;
+        if (shared) {
+            if (visited.fetch_or(mask, memory_order_relaxed) & mask) continue; // Another task won
+        } else {
+            visited.store(current | mask, memory_order_relaxed);
+        }
+        visit(v, part, nodes);
+    }
+}
+
+void BreadthFirstSearch::topDownNodes(size_t begin, size_t end, Part& part, vector<int>& nodes, bool shared) {
+    for (size_t i = begin; i < end; ++i) expand(m_frontier[i], part, nodes, shared);
+}
+
+void BreadthFirstSearch::topDownWords(size_t begin, size_t end, Part& part, vector<int>& nodes, bool shared) {
+    for (size_t word = begin; word < end; ++word) {
+        for (uint64_t bits = m_frontierBits[word].load(memory_order_relaxed); bits != 0; bits &= bits - 1) {
+            expand(static_cast<int>(word * 64 + __builtin_ctzll(bits)), part, nodes, shared);
+        }
+    }
+}
+
+// Each unvisited node takes the first frontier node among its in-neighbours
+// and skips the rest of its arcs. A task writes only its own words.
+void BreadthFirstSearch::bottomUpWords(const Graph& incoming, size_t begin, size_t end, Part& part, vector<int>& nodes) {
+    for (size_t word = begin; word < end; ++word) {
+        for (uint64_t bits = ~m_visited[word].load(memory_order_relaxed); bits != 0; bits &= bits - 1) {
+            int v = static_cast<int>(word * 64 + __builtin_ctzll(bits));
+            for (size_t arc = incoming.arcBegin(v); arc < incoming.arcEnd(v); ++arc) {
+                part.inspected++;
+                if (testBit(m_frontierBits, incoming.getTarget(arc))) {
+                    setBit(m_visited, v);
+                    visit(v, part, nodes);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool BreadthFirstSearch::stepLevel() {
+    if (m_frontier.empty()) return false;
+    if (m_mode == BfsMode::DirectionOptimizing) {
+        bool growing = m_frontier.size() > m_previousFrontier.size();
+        if (m_direction == BfsDirection::TopDown && growing && m_frontierArcs > m_unexploredArcs / ALPHA)
+            m_direction = BfsDirection::BottomUp;
+        else if (m_direction == BfsDirection::BottomUp && !growing
+                 && m_frontier.size() < static_cast<size_t>(m_graph.getNodeCount() / BETA))
+            m_direction = BfsDirection::TopDown;
+    }
+    // A top-down level walks a large frontier as bits, in node order, which
+    // reads the CSR arrays far more sequentially than the list order would
+    bool topDown = m_direction == BfsDirection::TopDown;
+    bool useBits = !topDown || m_frontier.size() >= m_words;
+    if (!topDown && m_graph.isDirected() && !m_hasIncoming) {
+        m_incoming = m_graph.reversed();
+        m_hasIncoming = true;
+    }
+    const Graph& incoming = m_graph.isDirected() ? m_incoming : m_graph;
+    if (useBits) {
+        for (int u : m_frontier) setBit(m_frontierBits, u);
+    }
+
+    size_t count = useBits ? m_words : m_frontier.size();
+    size_t grain = useBits ? BITS_GRAIN : NODES_GRAIN;
+    size_t chunks = (count + grain - 1) / grain;
+    ThreadPool& pool = ThreadPool::getInstance();
+    unsigned threads = m_threads ? min(m_threads, pool.getThreadCount()) : pool.getThreadCount();
+    bool shared = chunks > 1 && threads > 1;
+    m_parts.resize(chunks);
+    if (m_partNodes.size() < chunks) m_partNodes.resize(chunks);
+    pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+        // Counted on the stack, where the compiler can keep it in registers
+        Part part = { 0, 0, static_cast<unsigned char>(ThreadPool::getWorkerIndex()) };
+        vector<int>& nodes = m_partNodes[begin / grain];
+        nodes.clear();
+        if (!topDown) bottomUpWords(incoming, begin, end, part, nodes);
+        else if (useBits) topDownWords(begin, end, part, nodes, shared);
+        else topDownNodes(begin, end, part, nodes, shared);
+        m_parts[begin / grain] = part;
+    }, threads);
+    if (useBits) {
+        for (int u : m_frontier) setBit(m_frontierBits, u, false);
+    }
+
+    // The tasks' lists, in task order, are the next frontier
+    BfsLevel level = { m_currentDepth, m_direction, static_cast<int>(m_frontier.size()), 0, 0 };
+    swap(m_previousFrontier, m_frontier);
+    m_frontier.clear();
+    m_frontierArcs = 0;
+    for (size_t c = 0; c < chunks; ++c) {
+        level.inspected += m_parts[c].inspected;
+        m_frontierArcs += m_parts[c].arcs;
+        m_frontier.insert(m_frontier.end(), m_partNodes[c].begin(), m_partNodes[c].end());
+    }
+    level.discovered = static_cast<int>(m_frontier.size());
+    m_unexploredArcs -= m_frontierArcs;
+    m_currentDepth++;
+
+    m_stats.levels++;
+    if (level.direction == BfsDirection::BottomUp) m_stats.bottomUpLevels++;
+    m_stats.reached += level.discovered;
+    m_stats.inspected += level.inspected;
+    m_levels.push_back(level);
+    return true;
+}
+
+int BreadthFirstSearch::findUnvisited(int from) const {
+    size_t word = from >> 6;
+    if (word >= m_words) return -1;
+    uint64_t bits = ~m_visited[word].load(memory_order_relaxed) & (~0ull << (from & 63));
+    while (bits == 0) {
+        if (++word == m_words) return -1;
+        bits = ~m_visited[word].load(memory_order_relaxed);
+    }
+    return static_cast<int>(word * 64 + __builtin_ctzll(bits));
+}
+
+void BreadthFirstSearch::run() {
+    clear();
+    for (int source = findUnvisited(0); source >= 0; source = findUnvisited(source + 1)) {
+        start(source);
+        while (stepLevel()) {}
+    }
+}
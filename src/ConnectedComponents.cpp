@@ -0,0 +1,119 @@
+#include "ConnectedComponents.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+ConnectedComponents::ConnectedComponents(const Graph& graph) : m_graph(graph) {
+    clear();
+}
+
+void ConnectedComponents::clear() {
+    m_sets.reset(m_graph.getNodeCount());
+    m_labels.assign(m_graph.getNodeCount(), 0);
+    for (int v = 0; v < m_graph.getNodeCount(); ++v) m_labels[v] = v;
+    m_stats = ComponentsStats();
+}
+
+void ConnectedComponents::linkSampledArcs(int round, unsigned threads) {
+    atomic<unsigned long long> linked(0);
+    ThreadPool::getInstance().parallelFor(m_graph.getNodeCount(), GRAIN, [&](size_t begin, size_t end) {
+        const Graph& graph = m_graph;
+        ConcurrentDisjointSets& sets = m_sets;
+        unsigned long long count = 0;
+        for (int u = static_cast<int>(begin); u < static_cast<int>(end); ++u) {
+            size_t arc = graph.arcBegin(u) + round;
+            if (arc >= graph.arcEnd(u)) continue;
+            sets.unite(u, graph.getTarget(arc));
+            count++;
+        }
+        linked += count;
+    }, threads);
+    m_stats.linkedArcs += linked;
+}
+
+// The roots flatten() finds are the labels, so labelling is this same pass
+void ConnectedComponents::flattenAll(unsigned threads, bool storeLabels) {
+    ThreadPool::getInstance().parallelFor(m_graph.getNodeCount(), GRAIN, [&](size_t begin, size_t end) {
+        ConcurrentDisjointSets& sets = m_sets;
+        int* labels = m_labels.data();
+        for (size_t v = begin; v < end; ++v) {
+            int root = sets.flatten(static_cast<int>(v));
+            if (storeLabels) labels[v] = root;
+        }
+    }, threads);
+}
+
+void ConnectedComponents::compress(unsigned threads) {
+    flattenAll(threads, false);
+}
+
+int ConnectedComponents::findLargestRoot() {
+    int n = m_graph.getNodeCount();
+    if (n == 0) return -1;
+    vector<int> roots(SAMPLE_NODES);
+    uint32_t seed = 0x9e3779b9u;
+    for (int& root : roots) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        root = m_sets.find(static_cast<int>(seed % n));
+    }
+    sort(roots.begin(), roots.end());
+    int best = roots[0], bestCount = 0;
+    for (size_t i = 0; i < roots.size();) {
+        size_t j = i;
+        while (j < roots.size() && roots[j] == roots[i]) ++j;
+        if (static_cast<int>(j - i) > bestCount) {
+            best = roots[i];
+            bestCount = static_cast<int>(j - i);
+        }
+        i = j;
+    }
+    return best;
+}
+
+void ConnectedComponents::linkRemainingArcs(int first, int last, int skipRoot, unsigned threads, vector<char>* skipped) {
+    atomic<unsigned long long> linkedTotal(0), skippedTotal(0);
+    if (skipped) skipped->assign(last - first, false);
+    ThreadPool::getInstance().parallelFor(last - first, GRAIN, [&](size_t begin, size_t end) {
+        unsigned long long linkedCount = 0, skippedCount = 0;
+        for (int u = first + static_cast<int>(begin); u < first + static_cast<int>(end); ++u) {
+            size_t arcBegin = m_graph.arcBegin(u) + SAMPLE_ARCS;
+            if (arcBegin >= m_graph.arcEnd(u)) continue;
+            if (skipRoot >= 0 && m_sets.find(u) == skipRoot) {
+                skippedCount += m_graph.arcEnd(u) - arcBegin;
+                if (skipped) (*skipped)[u - first] = true;
+                continue;
+            }
+            for (size_t arc = arcBegin; arc < m_graph.arcEnd(u); ++arc) m_sets.unite(u, m_graph.getTarget(arc));
+            linkedCount += m_graph.arcEnd(u) - arcBegin;
+        }
+        linkedTotal += linkedCount;
+        skippedTotal += skippedCount;
+    }, threads);
+    m_stats.linkedArcs += linkedTotal;
+    m_stats.skippedArcs += skippedTotal;
+}
+
+void ConnectedComponents::label(unsigned threads) {
+    int n = m_graph.getNodeCount();
+    flattenAll(threads, true);
+    vector<int> sizes(n, 0);
+    for (int v = 0; v < n; ++v) sizes[m_labels[v]]++;
+    m_stats.components = 0;
+    m_stats.largest = 0;
+    for (int v = 0; v < n; ++v) {
+        if (sizes[v] == 0) continue;
+        m_stats.components++;
+        m_stats.largest = max(m_stats.largest, sizes[v]);
+    }
+}
+
+void ConnectedComponents::run(unsigned threads) {
+    clear();
+    for (int round = 0; round < SAMPLE_ARCS; ++round) linkSampledArcs(round, threads);
+    compress(threads);
+    int skipRoot = m_graph.isDirected() ? -1 : findLargestRoot();
+    linkRemainingArcs(0, m_graph.getNodeCount(), skipRoot, threads);
+    label(threads);
+}
@@ -0,0 +1,222 @@
+#include "ConnectedComponentsVisualizer.h"
+#include "BreadthFirstSearch.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+using namespace std;
+
+ConnectedComponentsVisualizer::ConnectedComponentsVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_threads(ThreadPool::getInstance().getThreadCount()), m_engineMs(0.0), m_bfsMs(-1.0),
+      m_phase(Phase::Sampling), m_round(0), m_largestRoot(-1), m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 1.0); // One step every 1.0s by default
+}
+
+void ConnectedComponentsVisualizer::buildGraph() {
+    m_renderer.clear();
+    m_renderer.setNodeStyle(30.f, 2.f, sf::Color::White);
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), false, sf::Color(100, 100, 250));
+        m_graph = Graph(file->nodeCount, file->edges, file->directed);
+        return;
+    }
+
+    // Node 0's sampled arcs reach only 1 and 2, so 3 and 4 join the big
+    // component through their own arcs; 6-8 and 9-10 stay apart, 11 alone
+    map<int, sf::Vector2f> positions = {
+        {0, {300, 350}}, {1, {150, 200}}, {2, {450, 200}}, {3, {150, 500}}, {4, {450, 500}}, {5, {300, 620}},
+        {6, {750, 200}}, {7, {950, 200}}, {8, {850, 380}},
+        {9, {750, 560}}, {10, {950, 560}}, {11, {1100, 380}}
+    };
+    for(const auto& p : positions) {
+        m_renderer.addNode(p.second, sf::Color(100, 100, 250));
+        m_renderer.addLabel(p.second, to_string(p.first), 24);
+    }
+    vector<GraphEdge> edges;
+    auto addEdge = [&](int u, int v) {
+        edges.push_back({u, v, 1});
+        m_renderer.addEdge(u, v);
+    };
+    addEdge(0, 1); addEdge(0, 2); addEdge(0, 3); addEdge(0, 4); addEdge(1, 2);
+    addEdge(3, 5); addEdge(4, 5); addEdge(1, 3); addEdge(2, 4);
+    addEdge(6, 7); addEdge(7, 8); addEdge(6, 8);
+    addEdge(9, 10);
+    m_graph = Graph(positions.size(), edges, false);
+}
+
+// Times a full run, and for undirected graphs a BFS from every unreached
+// node, which finds the same components
+void ConnectedComponentsVisualizer::runEngine() {
+    ConnectedComponents components(m_graph);
+    auto startTime = chrono::steady_clock::now();
+    components.run(m_threads);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_engineStats = components.getStats();
+
+    m_bfsMs = -1.0;
+    if (!m_graph.isDirected()) {
+        BreadthFirstSearch bfs(m_graph);
+        bfs.setThreads(m_threads);
+        startTime = chrono::steady_clock::now();
+        bfs.run();
+        m_bfsMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    }
+    cout << "Connected components (" << m_threads << " threads): " << m_engineMs << " ms, " << m_engineStats.components
+         << " components, largest " << m_engineStats.largest << " nodes, " << m_engineStats.linkedArcs << " arcs linked, "
+         << m_engineStats.skippedArcs << " skipped";
+    if (m_bfsMs >= 0) cout << "; BFS per component: " << m_bfsMs << " ms";
+    cout << "." << endl;
+}
+
+void ConnectedComponentsVisualizer::reset() {
+    buildGraph();
+    runEngine();
+    m_components = make_unique<ConnectedComponents>(m_graph);
+    m_edgeStates.assign(m_graph.getEdgeCount(), EdgeState::Untouched);
+    m_stepEdges.clear();
+    m_phase = Phase::Sampling;
+    m_round = 0;
+    m_largestRoot = -1;
+    recolor();
+    m_isVisualizing = false;
+    m_isDone = false;
+    cout << "Connected Components reset. Press SPACE to start." << endl;
+}
+
+void ConnectedComponentsVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
+void ConnectedComponentsVisualizer::handleEvent(sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
+        if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::T) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            reset();
+        }
+    }
+}
+
+sf::Color ConnectedComponentsVisualizer::getComponentColor(int node) {
+    static const sf::Color palette[] = {
+        {255, 170, 170}, {170, 220, 255}, {190, 255, 170}, {255, 225, 150}, {220, 180, 255},
+        {150, 240, 230}, {255, 190, 230}, {230, 230, 160}, {200, 200, 255}, {255, 200, 160}
+    };
+    return palette[m_components->findRoot(node) % size(palette)];
+}
+
+// A skipped edge may still be linked from its other end, so Linked wins
+void ConnectedComponentsVisualizer::markArcs(int node, size_t begin, size_t end, EdgeState state) {
+    for (size_t arc = m_graph.arcBegin(node) + begin; arc < min(m_graph.arcBegin(node) + end, m_graph.arcEnd(node)); ++arc) {
+        int edge = m_graph.getEdgeId(arc);
+        if (state == EdgeState::Linked) m_stepEdges.push_back(edge);
+        if (m_edgeStates[edge] != EdgeState::Linked) m_edgeStates[edge] = state;
+    }
+}
+
+void ConnectedComponentsVisualizer::recolor() {
+    for (int v = 0; v < m_graph.getNodeCount(); ++v) m_renderer.setNodeColor(v, getComponentColor(v));
+    for (size_t i = 0; i < m_edgeStates.size(); ++i) {
+        sf::Color color = sf::Color::White;
+        if (m_edgeStates[i] == EdgeState::Linked) color = sf::Color::Green;
+        else if (m_edgeStates[i] == EdgeState::Skipped) color = sf::Color(90, 90, 90);
+        m_renderer.setEdgeColor(i, color);
+    }
+    for (int edge : m_stepEdges) m_renderer.setEdgeColor(edge, sf::Color::Yellow);
+}
+
+bool ConnectedComponentsVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+
+    int n = m_graph.getNodeCount();
+    m_stepEdges.clear();
+    switch (m_phase) {
+        case Phase::Sampling:
+            m_components->linkSampledArcs(m_round, m_threads);
+            for (int v = 0; v < n; ++v) markArcs(v, m_round, m_round + 1, EdgeState::Linked);
+            if (++m_round == ConnectedComponents::SAMPLE_ARCS) {
+                m_components->compress(m_threads);
+                m_phase = m_graph.isDirected() ? Phase::Remaining : Phase::FindLargest;
+                m_round = 0;
+            }
+            break;
+        case Phase::FindLargest:
+            m_largestRoot = m_components->findLargestRoot();
+            m_phase = Phase::Remaining;
+            break;
+        case Phase::Remaining: {
+            int batch = max(1, (n + BATCHES - 1) / BATCHES);
+            int first = m_round * batch, last = min(n, first + batch);
+            vector<char> skipped;
+            m_components->linkRemainingArcs(first, last, m_largestRoot, m_threads, &skipped);
+            for (int v = first; v < last; ++v)
+                markArcs(v, ConnectedComponents::SAMPLE_ARCS, m_graph.getDegree(v), skipped[v - first] ? EdgeState::Skipped : EdgeState::Linked);
+            if (++m_round * batch >= n) m_phase = Phase::Labelling;
+            break;
+        }
+        case Phase::Labelling:
+            m_components->label(m_threads);
+            m_phase = Phase::Done;
+            break;
+        case Phase::Done:
+            m_isDone = true; m_isVisualizing = false;
+            break;
+    }
+    recolor();
+    return true;
+}
+
+void ConnectedComponentsVisualizer::draw() {
+    m_window->clear(sf::Color(30, 30, 30));
+    m_renderer.draw(*m_window, m_font);
+    std::string statusText;
+    if (m_isDone)
+        statusText = "Complete!";
+    else if (m_isVisualizing)
+        statusText = "Visualizing...";
+    else
+        statusText = "Paused.";
+    sf::Text infoText("Connected Components (union-find) | " + statusText, m_font, 20);
+    infoText.setPosition(10, 10);
+    m_window->draw(infoText);
+
+    ostringstream progress;
+    switch (m_phase) {
+        case Phase::Sampling:
+            progress << "Next: link every node along its arc #" << m_round + 1 << " of " << ConnectedComponents::SAMPLE_ARCS << " sampled";
+            break;
+        case Phase::FindLargest:
+            progress << "Next: sample nodes to find the largest component";
+            break;
+        case Phase::Remaining:
+            progress << "Next: link the remaining arcs of batch " << m_round + 1 << "/" << BATCHES;
+            if (m_largestRoot >= 0) progress << ", skipping nodes in root " << m_largestRoot << "'s component";
+            break;
+        case Phase::Labelling:
+            progress << "Next: label every node with its root";
+            break;
+        case Phase::Done:
+            progress << m_components->getStats().components << " components, largest " << m_components->getStats().largest << " nodes";
+            break;
+    }
+    sf::Text progressText(progress.str(), m_font, 18);
+    progressText.setFillColor(sf::Color(200, 200, 200));
+    progressText.setPosition(10, 38);
+    m_window->draw(progressText);
+
+    ostringstream run;
+    run << "T threads: " << m_threads << " | full run: " << fixed << setprecision(2) << m_engineMs << " ms, "
+        << m_engineStats.components << " components, " << m_engineStats.skippedArcs << " arcs skipped";
+    if (m_bfsMs >= 0) run << " | BFS per component: " << m_bfsMs << " ms";
+    if (m_bfsMs >= 0 && m_bfsMs < m_engineMs) run << " (union-find only wins on many-component graphs)";
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 62);
+    m_window->draw(runText);
+}
@@ -0,0 +1,138 @@
+#include "DataGenerator.h"
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+namespace {
+    const uint64_t DISPLACE_STREAM = 0xA5A5A5A5A5A5A5A5ULL; // Separates the nearly-sorted moves from the values
+    const uint64_t FEW_UNIQUE_VALUES = 16;
+    const uint64_t ZIPF_RANKS = 1024;
+
+    bool g_hasWorkloadSeed = false;
+    uint64_t g_workloadSeed = 0;
+
+    // High 64 bits of a 128-bit product
+    uint64_t mulHigh(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+        uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32, bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+        uint64_t middle = (aLow * bLow >> 32) + (aHigh * bLow & 0xFFFFFFFF) + aLow * bHigh;
+        return aHigh * bHigh + (aHigh * bLow >> 32) + (middle >> 32);
+#endif
+    }
+
+    // Maps 64 random bits onto [0, range), where range 0 stands for 2^64
+    uint64_t scaleTo(uint64_t random, uint64_t range) {
+        return range == 0 ? random : mulHigh(random, range);
+    }
+}
+
+string distributionName(Distribution distribution) {
+    switch (distribution) {
+        case Distribution::Uniform:      return "uniform";
+        case Distribution::Sorted:       return "sorted";
+        case Distribution::Reversed:     return "reversed";
+        case Distribution::NearlySorted: return "nearly-sorted";
+        case Distribution::OrganPipe:    return "organ-pipe";
+        case Distribution::FewUnique:    return "few-unique";
+        case Distribution::Zipf:         return "zipf";
+    }
+    return "";
+}
+
+bool parseDistribution(const string& name, Distribution& distribution) {
+    for (Distribution candidate : ALL_DISTRIBUTIONS) {
+        if (distributionName(candidate) == name) {
+            distribution = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t getWorkloadSeed() {
+    if (!g_hasWorkloadSeed) {
+        random_device rd;
+        setWorkloadSeed((static_cast<uint64_t>(rd()) << 32) | rd());
+    }
+    return g_workloadSeed;
+}
+
+void setWorkloadSeed(uint64_t seed) {
+    g_workloadSeed = seed;
+    g_hasWorkloadSeed = true;
+    cout << "Workload seed: " << seed << " (repeat with --seed " << seed << ")" << endl;
+}
+
+DataGenerator::DataGenerator(const DataSpec& spec)
+    : m_spec(spec), m_range(static_cast<uint64_t>(spec.maxValue) - static_cast<uint64_t>(spec.minValue) + 1) {
+    if (m_spec.distribution == Distribution::Zipf) {
+        // Rank k is drawn with probability proportional to 1/(k+1)
+        uint64_t ranks = m_range == 0 ? ZIPF_RANKS : min(ZIPF_RANKS, m_range);
+        m_zipfCumulative.resize(ranks);
+        double total = 0.0;
+        for (uint64_t k = 0; k < ranks; ++k) m_zipfCumulative[k] = (total += 1.0 / (k + 1));
+    }
+}
+
+// Evenly spaced offsets: position 0 -> 0, position `count` -> the full range
+uint64_t DataGenerator::rampAt(uint64_t position, uint64_t count) const {
+    return scaleTo(position * (UINT64_MAX / max<uint64_t>(count, 1)), m_range);
+}
+
+int64_t DataGenerator::valueAt(uint64_t index) const {
+    const uint64_t n = m_spec.count;
+    uint64_t offset = 0; // Distance above minValue
+
+    switch (m_spec.distribution) {
+        case Distribution::Uniform:
+            offset = scaleTo(randomAt(m_spec.seed, index), m_range);
+            break;
+        case Distribution::Sorted:
+            offset = rampAt(index, n);
+            break;
+        case Distribution::Reversed:
+            offset = rampAt(n - 1 - index, n);
+            break;
+        case Distribution::NearlySorted: {
+            // Sorted, except that about 1% of the elements take the value of a
+            // position up to 16 places away
+            uint64_t random = randomAt(m_spec.seed ^ DISPLACE_STREAM, index);
+            uint64_t position = index;
+            if (random % 100 == 0) {
+                int64_t shifted = static_cast<int64_t>(index) + static_cast<int64_t>((random >> 8) % 33) - 16;
+                position = static_cast<uint64_t>(clamp<int64_t>(shifted, 0, static_cast<int64_t>(n) - 1));
+            }
+            offset = rampAt(position, n);
+            break;
+        }
+        case Distribution::OrganPipe: {
+            // Ascending to the middle, then descending
+            uint64_t half = (n + 1) / 2;
+            offset = rampAt(index < half ? index : n - 1 - index, half);
+            break;
+        }
+        case Distribution::FewUnique: {
+            uint64_t distinct = m_range == 0 ? FEW_UNIQUE_VALUES : min(FEW_UNIQUE_VALUES, m_range);
+            uint64_t spacing = distinct > 1 ? (m_range - 1) / (distinct - 1) : 0;
+            offset = scaleTo(randomAt(m_spec.seed, index), distinct) * spacing;
+            break;
+        }
+        case Distribution::Zipf: {
+            uint64_t ranks = m_zipfCumulative.size();
+            double u = (randomAt(m_spec.seed, index) >> 11) * (1.0 / 9007199254740992.0) * m_zipfCumulative.back(); // 53 random bits
+            uint64_t rank = min<uint64_t>(lower_bound(m_zipfCumulative.begin(), m_zipfCumulative.end(), u) - m_zipfCumulative.begin(), ranks - 1);
+            uint64_t spacing = m_range == 0 ? (UINT64_MAX / ranks) : m_range / ranks;
+            offset = rank * spacing; // Rank 0, the most frequent, is the minimum
+            break;
+        }
+    }
+    return static_cast<int64_t>(static_cast<uint64_t>(m_spec.minValue) + offset);
+}
+
+vector<int> generateData(const DataSpec& spec) {
+    return DataGenerator(spec).generate<int>();
+}
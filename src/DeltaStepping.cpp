@@ -0,0 +1,131 @@
+#include "DeltaStepping.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+DeltaStepping::DeltaStepping(const Graph& graph)
+    : m_graph(graph), m_tentative(new atomic<int64_t>[max(graph.getNodeCount(), 1)]) {}
+
+int64_t DeltaStepping::suggestDelta(const Graph& graph) {
+    int64_t maxWeight = 0;
+    for (size_t arc = 0; arc < graph.getArcCount(); ++arc) maxWeight = max<int64_t>(maxWeight, graph.getWeight(arc));
+    double degree = graph.getNodeCount() ? static_cast<double>(graph.getArcCount()) / graph.getNodeCount() : 0.0;
+    return max<int64_t>(1, static_cast<int64_t>(maxWeight / max(1.0, degree)));
+}
+
+// Relaxes the light (or heavy) arcs of every frontier node in parallel.
+// Each task lists the nodes it lowered in its own m_lowered entry.
+void DeltaStepping::relax(const vector<int>& frontier, bool heavy, int64_t delta, unsigned threads) {
+    size_t tasks = (frontier.size() + GRAIN - 1) / GRAIN;
+    if (m_lowered.size() < tasks) m_lowered.resize(tasks);
+    for (vector<int>& lowered : m_lowered) lowered.clear(); // Earlier rounds may have had more tasks
+    atomic<unsigned long long> examined{0};
+
+    ThreadPool::getInstance().parallelFor(frontier.size(), GRAIN, [&](size_t begin, size_t end) {
+        vector<int>& lowered = m_lowered[begin / GRAIN];
+        unsigned long long count = 0;
+        for (size_t i = begin; i < end; ++i) {
+            int u = frontier[i];
+            int64_t du = m_tentative[u].load(memory_order_relaxed);
+            for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                int weight = m_graph.getWeight(arc);
+                if ((weight > delta) != heavy) continue;
+                ++count;
+                int v = m_graph.getTarget(arc);
+                int64_t candidate = du + weight;
+                int64_t current = m_tentative[v].load(memory_order_relaxed);
+                while (candidate < current) {
+                    if (m_tentative[v].compare_exchange_weak(current, candidate, memory_order_relaxed)) {
+                        lowered.push_back(v);
+                        break;
+                    }
+                }
+            }
+        }
+        examined.fetch_add(count, memory_order_relaxed);
+    }, threads);
+    m_stats.relaxations += examined.load();
+}
+
+bool DeltaStepping::run(int source, int64_t delta, unsigned threads, vector<DeltaSteppingPhase>* phases) {
+    int n = m_graph.getNodeCount();
+    int64_t maxWeight = 0;
+    for (size_t arc = 0; arc < m_graph.getArcCount(); ++arc) {
+        if (m_graph.getWeight(arc) < 0) {
+            cerr << "Error: delta-stepping needs non-negative weights" << endl;
+            return false;
+        }
+        maxWeight = max<int64_t>(maxWeight, m_graph.getWeight(arc));
+    }
+    if (delta < 1) {
+        cerr << "Error: delta must be at least 1" << endl;
+        return false;
+    }
+    m_stats = DeltaSteppingStats();
+    if (phases) phases->clear();
+    for (int v = 0; v < n; ++v) m_tentative[v].store(UNREACHED, memory_order_relaxed);
+
+    // A node may sit in several slots after repeated lowering; only the entry
+    // in the slot of its current distance counts, once per round
+    vector<vector<int>> slots(static_cast<size_t>(maxWeight / delta + 2));
+    vector<int64_t> inRound(n, -1);  // Round that last took the node into its frontier
+    vector<int64_t> inBucket(n, -1); // Bucket whose settled set holds the node
+    size_t queued = 0;
+    int64_t round = 0;
+    vector<int> frontier, settled;
+
+    auto enqueue = [&](DeltaSteppingPhase* phase) {
+        for (const vector<int>& lowered : m_lowered) {
+            for (int v : lowered) {
+                int64_t distance = m_tentative[v].load(memory_order_relaxed);
+                slots[(distance / delta) % slots.size()].push_back(v);
+                if (phase) phase->updates.push_back({v, distance});
+            }
+            queued += lowered.size();
+            m_stats.updates += lowered.size();
+        }
+    };
+    auto recordPhase = [&](int64_t bucket, bool heavy, const vector<int>& nodes) -> DeltaSteppingPhase* {
+        m_stats.phases++;
+        if (!phases) return nullptr;
+        phases->push_back({bucket, heavy, nodes, {}});
+        return &phases->back();
+    };
+
+    m_tentative[source].store(0, memory_order_relaxed);
+    slots[0].push_back(source);
+    queued = 1;
+    for (int64_t bucket = 0; queued > 0; ++bucket) {
+        vector<int>& slot = slots[bucket % slots.size()];
+        if (slot.empty()) continue;
+        settled.clear();
+        while (!slot.empty()) {
+            queued -= slot.size();
+            frontier.clear();
+            ++round;
+            for (int v : slot) {
+                if (m_tentative[v].load(memory_order_relaxed) / delta != bucket || inRound[v] == round) continue;
+                inRound[v] = round;
+                frontier.push_back(v);
+                if (inBucket[v] != bucket) {
+                    inBucket[v] = bucket;
+                    settled.push_back(v);
+                }
+            }
+            slot.clear();
+            if (frontier.empty()) break;
+            relax(frontier, false, delta, threads);
+            enqueue(recordPhase(bucket, false, frontier));
+        }
+        if (settled.empty()) continue; // Only outdated entries
+        m_stats.buckets++;
+        relax(settled, true, delta, threads); // Heavy arcs only reach later buckets
+        enqueue(recordPhase(bucket, true, settled));
+    }
+
+    m_distances.resize(n);
+    for (int v = 0; v < n; ++v) m_distances[v] = m_tentative[v].load(memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,209 @@
+#include "DeltaSteppingVisualizer.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    const sf::Color NODE_COLOR(100, 100, 250);
+    const sf::Color HEAVY_EDGE_COLOR(110, 110, 110);
+}
+
+DeltaSteppingVisualizer::DeltaSteppingVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_delta(1), m_threads(ThreadPool::getInstance().getThreadCount()), m_runMs(0.0), m_phase(0),
+      m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.8); // One round every 0.8s by default
+}
+
+// The same graph as the Dijkstra visualizer, so the two can be compared
+void DeltaSteppingVisualizer::buildGraph() {
+    m_distLabels.clear(); m_renderer.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, NODE_COLOR);
+        m_graph = Graph(file->nodeCount, file->edges, file->directed);
+        if (file->nodeCount <= GraphRenderer::MAX_LABELLED_NODES) {
+            for (int u = 0; u < file->nodeCount; ++u) {
+                sf::Vector2f below(0, m_renderer.getNodeRadius() + 5);
+                m_distLabels.push_back(m_renderer.addLabel(m_renderer.getNodePosition(u) + below, "inf", 18, sf::Color::White, false));
+            }
+        }
+    } else {
+        map<int, sf::Vector2f> positions = {
+            {0, {150, 360}}, {1, {350, 200}}, {2, {350, 520}},
+            {3, {650, 200}}, {4, {650, 520}}, {5, {850, 360}}, {6, {1050, 360}}
+        };
+        for(const auto& p : positions) {
+            m_renderer.addNode(p.second, NODE_COLOR);
+            m_renderer.addLabel(p.second, to_string(p.first), 24);
+            m_distLabels.push_back(m_renderer.addLabel(p.second + sf::Vector2f(0, 35), "inf", 18, sf::Color::White, false));
+        }
+        vector<GraphEdge> edges;
+        auto addEdge = [&](int u, int v, int w) {
+            edges.push_back({u, v, w});
+            m_renderer.addEdge(u, v);
+            sf::Vector2f middle = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+            m_renderer.addLabel(middle, to_string(w), 20, sf::Color::White, false);
+        };
+        addEdge(0, 1, 4); addEdge(0, 2, 1); addEdge(1, 3, 1);
+        addEdge(2, 1, 2); addEdge(2, 4, 5); addEdge(3, 5, 3);
+        addEdge(4, 5, 1); addEdge(5, 6, 2);
+        m_graph = Graph(positions.size(), edges, false);
+    }
+    m_engine = make_unique<DeltaStepping>(m_graph);
+}
+
+// Times a plain run, then records one for the replay
+void DeltaSteppingVisualizer::runSearch() {
+    m_phases.clear();
+    m_phase = 0;
+    m_distances.assign(m_graph.getNodeCount(), DeltaStepping::UNREACHED);
+    m_settled.assign(m_graph.getNodeCount(), false);
+    m_isVisualizing = false;
+    m_isDone = false;
+
+    auto startTime = chrono::steady_clock::now();
+    if (!m_engine->run(0, m_delta, m_threads)) {
+        m_isDone = true;
+        return;
+    }
+    m_runMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_engine->run(0, m_delta, m_threads, &m_phases);
+    m_distances[0] = 0;
+
+    // Light edges are relaxed in rounds, heavy ones once per bucket
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            m_renderer.setEdgeColor(m_graph.getEdgeId(arc), m_graph.getWeight(arc) > m_delta ? HEAVY_EDGE_COLOR : sf::Color::White);
+        }
+    }
+    const DeltaSteppingStats& stats = m_engine->getStats();
+    cout << "Delta-stepping with delta " << m_delta << " on " << m_threads << " thread(s): " << m_runMs << " ms, "
+         << stats.buckets << " buckets, " << stats.phases << " rounds, " << stats.relaxations << " relaxations, "
+         << stats.updates << " updates." << endl;
+}
+
+sf::Color DeltaSteppingVisualizer::getBucketColor(int64_t bucket) const {
+    static const sf::Color palette[] = {
+        sf::Color(255, 160, 60), sf::Color(220, 120, 220), sf::Color(80, 200, 220), sf::Color(200, 200, 90)
+    };
+    return palette[bucket % 4];
+}
+
+void DeltaSteppingVisualizer::reset() {
+    buildGraph();
+    m_delta = DeltaStepping::suggestDelta(m_graph);
+    runSearch();
+    cout << "Delta-stepping reset. Press SPACE to start." << endl;
+}
+
+void DeltaSteppingVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
+void DeltaSteppingVisualizer::handleEvent(sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed) {
+        if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
+        if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::Up) {
+            m_delta *= 2;
+            runSearch();
+        }
+        if (event.key.code == sf::Keyboard::Down && m_delta > 1) {
+            m_delta /= 2;
+            runSearch();
+        }
+        if (event.key.code == sf::Keyboard::T) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            runSearch();
+        }
+        if (event.key.code == sf::Keyboard::Right) {
+            m_isVisualizing = true;
+            step();
+            m_isVisualizing = false;
+        }
+    }
+}
+
+bool DeltaSteppingVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+
+    if (m_phase >= m_phases.size()) {
+        m_isDone = true; m_isVisualizing = false;
+        return true;
+    }
+    const DeltaSteppingPhase& phase = m_phases[m_phase++];
+    for (const auto& update : phase.updates) m_distances[update.first] = update.second;
+    if (phase.heavy) {
+        for (int u : phase.frontier) m_settled[u] = true;
+    }
+    return true;
+}
+
+void DeltaSteppingVisualizer::draw() {
+    m_window->clear(sf::Color(30, 30, 30));
+    const DeltaSteppingPhase* phase = m_phase > 0 ? &m_phases[m_phase - 1] : nullptr;
+    int64_t current = phase ? phase->bucket : 0;
+
+    // Waiting nodes per bucket, for the strip
+    vector<vector<int>> buckets(SHOWN_BUCKETS);
+    vector<size_t> bucketSizes(SHOWN_BUCKETS, 0);
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        if (m_distances[u] == DeltaStepping::UNREACHED) m_renderer.setNodeColor(u, NODE_COLOR);
+        else if (m_settled[u]) m_renderer.setNodeColor(u, sf::Color::Green);
+        else {
+            int64_t bucket = m_distances[u] / m_delta;
+            m_renderer.setNodeColor(u, getBucketColor(bucket));
+            if (bucket >= current && bucket - current < SHOWN_BUCKETS) {
+                bucketSizes[bucket - current]++;
+                if (buckets[bucket - current].size() < 6) buckets[bucket - current].push_back(u);
+            }
+        }
+
+        if (m_distLabels.empty()) continue; // Too many nodes to label
+        m_renderer.setLabelText(m_distLabels[u], m_distances[u] == DeltaStepping::UNREACHED ? "inf" : to_string(m_distances[u]));
+    }
+    if (phase && !m_isDone) {
+        for (int u : phase->frontier) m_renderer.setNodeColor(u, sf::Color::Yellow);
+    }
+    m_renderer.draw(*m_window, m_font);
+
+    // Bucket strip along the bottom
+    float width = (getCanvasSize().x - 20.f) / SHOWN_BUCKETS;
+    float top = getCanvasSize().y - 52.f;
+    for (int b = 0; b < SHOWN_BUCKETS; ++b) {
+        int64_t bucket = current + b;
+        sf::RectangleShape box(sf::Vector2f(width - 6.f, 44.f));
+        box.setPosition(10.f + b * width, top);
+        box.setFillColor(sf::Color(45, 45, 45));
+        box.setOutlineThickness(2.f);
+        box.setOutlineColor(getBucketColor(bucket));
+        m_window->draw(box);
+
+        string contents;
+        for (int u : buckets[b]) contents += to_string(u) + " ";
+        if (bucketSizes[b] > buckets[b].size()) contents = to_string(bucketSizes[b]) + " nodes";
+        sf::Text text("[" + to_string(bucket * m_delta) + ", " + to_string((bucket + 1) * m_delta) + ")\n" + contents, m_font, 14);
+        text.setPosition(16.f + b * width, top + 3.f);
+        m_window->draw(text);
+    }
+
+    std::string status = m_isDone ? "Complete!" : (m_isVisualizing ? "Visualizing..." : "Paused.");
+    std::string round = phase ? (phase->heavy ? " | Bucket " + to_string(current) + ": heavy edges" : " | Bucket " + to_string(current) + ": light round") : "";
+    sf::Text infoText("Delta-Stepping | " + status + " | Round " + to_string(m_phase) + "/" + to_string(m_phases.size()) + round, m_font, 20);
+    infoText.setPosition(10, 10);
+    m_window->draw(infoText);
+
+    const DeltaSteppingStats& stats = m_engine->getStats();
+    ostringstream run;
+    run << "Up/Down delta: " << m_delta << " | T threads: " << m_threads << " | ";
+    if (m_phases.empty() && m_isDone) run << "Needs non-negative weights";
+    else run << fixed << setprecision(2) << m_runMs << " ms | " << stats.relaxations << " relaxations | " << stats.updates << " updates";
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 38);
+    m_window->draw(runText);
+}
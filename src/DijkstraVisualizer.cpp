@@ -1,112 +1,489 @@
 #include "DijkstraVisualizer.h"
+#include "GraphLoader.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
+#include <iterator>
+#include <sstream>
 
 using namespace std;
 
-DijkstraVisualizer::DijkstraVisualizer(sf::RenderWindow& window)
-    : Visualizer(window), m_isVisualizing(false), m_isDone(false) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) cerr << "Error loading font" << endl;
+namespace {
+    const sf::Color NODE_COLOR(100, 100, 250);
+    const sf::Color BACKWARD_SETTLED_COLOR(255, 140, 0);
+    const sf::Color FORWARD_FRONTIER_COLOR(150, 230, 150);
+    const sf::Color BACKWARD_FRONTIER_COLOR(255, 200, 130);
+
+    // Distances are kept as 64-bit while searching and stored as int in the trace
+    int traceValue(int64_t distance) {
+        return static_cast<int>(max<int64_t>(min<int64_t>(distance, numeric_limits<int>::max()), numeric_limits<int>::min()));
+    }
+}
+
+DijkstraVisualizer::DijkstraVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_highlightedEdge(-1), m_mode(QueryMode::FullTree), m_source(0), m_target(-1), m_isPathShown(false),
+      m_heapKind(HeapKind::FourAry), m_usedHeap(HeapKind::FourAry), m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.6); // One step every 0.6s by default
 }
 
 void DijkstraVisualizer::buildGraph() {
-    m_nodes.clear(); m_edges.clear(); m_edgeWeights.clear();
+    m_distLabels.clear(); m_renderer.clear();
+    m_highlightedEdge = -1;
+    m_pathEdges.clear();
+    m_isPathShown = false;
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, NODE_COLOR);
+        m_graph = Graph(file->nodeCount, file->edges, file->directed);
+        m_reverse = m_graph.isDirected() ? m_graph.reversed() : Graph();
+        if (file->nodeCount <= GraphRenderer::MAX_LABELLED_NODES) {
+            for (int u = 0; u < file->nodeCount; ++u) {
+                sf::Vector2f below(0, m_renderer.getNodeRadius() + 5);
+                m_distLabels.push_back(m_renderer.addLabel(m_renderer.getNodePosition(u) + below, "inf", 18, sf::Color::White, false));
+            }
+        }
+        return;
+    }
     map<int, sf::Vector2f> positions = {
         {0, {150, 360}}, {1, {350, 200}}, {2, {350, 520}},
         {3, {650, 200}}, {4, {650, 520}}, {5, {850, 360}}, {6, {1050, 360}}
     };
     for(const auto& p : positions) {
-        Node node;
-        node.shape.setRadius(30.f); node.shape.setOrigin(30.f, 30.f);
-        node.shape.setPosition(p.second);
-        node.label.setFont(m_font); node.label.setString(to_string(p.first));
-        node.label.setCharacterSize(24);
-        sf::FloatRect r = node.label.getLocalBounds();
-        node.label.setOrigin(r.left + r.width/2.f, r.top + r.height/2.f);
-        node.label.setPosition(p.second);
-        node.distLabel.setFont(m_font); node.distLabel.setCharacterSize(18);
-        m_nodes[p.first] = node;
+        m_renderer.addNode(p.second, NODE_COLOR);
+        m_renderer.addLabel(p.second, to_string(p.first), 24);
+        m_distLabels.push_back(m_renderer.addLabel(p.second + sf::Vector2f(0, 35), "inf", 18, sf::Color::White, false));
     }
+    vector<GraphEdge> edges;
     auto addEdge = [&](int u, int v, int w) {
-        m_nodes[u].adj.push_back({v, w});
-        m_nodes[v].adj.push_back({u, w}); // Undirected
-        sf::VertexArray line(sf::Lines, 2);
-        line[0] = {m_nodes[u].shape.getPosition(), sf::Color::White};
-        line[1] = {m_nodes[v].shape.getPosition(), sf::Color::White};
-        m_edges.push_back(line);
-        sf::Text weightText(to_string(w), m_font, 20);
-        weightText.setPosition((line[0].position + line[1].position) / 2.f);
-        m_edgeWeights[{min(u,v), max(u,v)}] = weightText;
+        edges.push_back({u, v, w});
+        m_renderer.addEdge(u, v);
+        sf::Vector2f middle = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+        m_renderer.addLabel(middle, to_string(w), 20, sf::Color::White, false);
     };
     addEdge(0, 1, 4); addEdge(0, 2, 1); addEdge(1, 3, 1);
     addEdge(2, 1, 2); addEdge(2, 4, 5); addEdge(3, 5, 3);
     addEdge(4, 5, 1); addEdge(5, 6, 2);
+    m_graph = Graph(positions.size(), edges, false);
+    m_reverse = Graph();
+}
+
+string DijkstraVisualizer::getTraceLabel() const {
+    switch (m_mode) {
+        case QueryMode::FullTree:      return "Dijkstra " + to_string(m_source);
+        case QueryMode::Bidirectional: return "Bidirectional Dijkstra " + to_string(m_source) + " " + to_string(m_target);
+        case QueryMode::AStar:         return "A* " + to_string(m_source) + " " + to_string(m_target);
+    }
+    return "";
+}
+
+// Runs the current mode to completion, recording every settle and relaxation
+void DijkstraVisualizer::recordTrace() {
+    int n = m_graph.getNodeCount();
+    bool bidirectional = m_mode == QueryMode::Bidirectional;
+    TraceState initial;
+    initial.values.assign(bidirectional ? 2 * n : n, numeric_limits<int>::max());
+    initial.states.assign(n, UNSETTLED);
+    initial.values[m_source] = 0;
+    if (bidirectional) initial.values[n + m_target] = 0;
+    m_trace = Trace(initial);
+    m_trace.setLabel(getTraceLabel());
+    setPathShown(false);
+    m_pathEdges.clear();
+
+    m_usedHeap = m_heapKind;
+    if (m_usedHeap == HeapKind::Radix) {
+        for (size_t arc = 0; arc < m_graph.getArcCount(); ++arc) {
+            if (m_graph.getWeight(arc) < 0) {
+                cerr << "The radix heap needs non-negative weights; using the 4-ary heap." << endl;
+                m_usedHeap = HeapKind::FourAry;
+                break;
+            }
+        }
+    }
+    switch (m_usedHeap) {
+        case HeapKind::Lazy:    recordWith<LazyHeap>(); break;
+        case HeapKind::FourAry: recordWith<IndexedDaryHeap<4>>(); break;
+        case HeapKind::Radix:   recordWith<RadixHeap>(); break;
+    }
+    m_player.load(m_trace);
+    cout << m_trace.getLabel() << " using the " << heapKindName(m_usedHeap) << ": max size " << m_heapStats.maxSize
+         << ", " << m_heapStats.pushes << " pushes, " << m_heapStats.decreaseKeys << " decrease-keys, "
+         << m_heapStats.pops << " pops, " << m_heapStats.stalePops << " stale pops." << endl;
+    cout << m_querySummary << endl;
+}
+
+template <typename Heap>
+void DijkstraVisualizer::recordWith() {
+    if (m_mode == QueryMode::FullTree) {
+        QueryResult tree = runDijkstra<Heap>(m_source, -1, true);
+        m_querySummary = "Full tree from " + to_string(m_source) + " | settled " + to_string(tree.settled) +
+                         " of " + to_string(m_graph.getNodeCount());
+        return;
+    }
+    QueryResult query = m_mode == QueryMode::Bidirectional ? runBidirectional<Heap>() : runAStar<Heap>();
+    QueryResult plain = runDijkstra<Heap>(m_source, m_target, false);
+    ostringstream summary;
+    summary << "Query " << m_source << " -> " << m_target << " | ";
+    if (query.distance == NO_PATH) summary << "unreachable";
+    else summary << "distance " << query.distance;
+    summary << " | settled " << query.settled << " vs " << plain.settled << " with Dijkstra";
+    if (plain.settled > 0) summary << " (" << lround(100.0 * query.settled / plain.settled) << "%)";
+    m_querySummary = summary.str();
+    if (query.distance != plain.distance) cerr << "Query distance differs from plain Dijkstra (negative weights?)" << endl;
+}
+
+template <typename Heap>
+DijkstraVisualizer::QueryResult DijkstraVisualizer::runDijkstra(int source, int target, bool record) {
+    int n = m_graph.getNodeCount();
+    vector<int64_t> distances(n, NO_PATH);
+    vector<bool> settled(n, false);
+    vector<size_t> parentArc(n, SIZE_MAX);
+    Heap heap(n);
+    distances[source] = 0;
+    heap.update(source, 0);
+
+    QueryResult result{0, NO_PATH};
+    int u;
+    int64_t key;
+    while (heap.pop(u, key)) {
+        settled[u] = true;
+        result.settled++;
+        if (record) m_trace.nodeState(u, SETTLED);
+        if (u == target) break;
+
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = m_graph.getTarget(arc);
+            int64_t distance = distances[u] + m_graph.getWeight(arc);
+            if (distance < distances[v]) {
+                if (record) m_trace.relax(u, v, traceValue(distance));
+                distances[v] = distance;
+                parentArc[v] = arc;
+                if (!settled[v]) heap.update(v, distance); // Only a negative weight reaches a settled node
+            }
+        }
+    }
+    if (record) m_heapStats = heap.getStats();
+    if (target >= 0) {
+        result.distance = distances[target];
+        if (record && result.distance != NO_PATH) addPath(parentArc, m_graph, source, target);
+    }
+    return result;
+}
+
+// Searches forwards from the source and backwards from the target, always
+// expanding the side with the smaller queue minimum. Once the two minima
+// add up to at least the best source -> target distance seen where the
+// searches meet, no shorter path can remain.
+template <typename Heap>
+DijkstraVisualizer::QueryResult DijkstraVisualizer::runBidirectional() {
+    int n = m_graph.getNodeCount();
+    const Graph& reverse = m_graph.isDirected() ? m_reverse : m_graph;
+    Heap heaps[2] = { Heap(n), Heap(n) };
+    vector<int64_t> distances[2] = { vector<int64_t>(n, NO_PATH), vector<int64_t>(n, NO_PATH) };
+    vector<size_t> parentArcs[2] = { vector<size_t>(n, SIZE_MAX), vector<size_t>(n, SIZE_MAX) };
+    const Graph* graphs[2] = { &m_graph, &reverse };
+    const int marks[2] = { SETTLED, SETTLED_BACKWARD };
+    vector<int> states(n, UNSETTLED);
+
+    distances[0][m_source] = 0;
+    distances[1][m_target] = 0;
+    heaps[0].update(m_source, 0);
+    heaps[1].update(m_target, 0);
+    QueryResult result{0, m_source == m_target ? 0 : NO_PATH};
+    int meeting = m_source == m_target ? m_source : -1;
+
+    int64_t minimum[2];
+    while (heaps[0].peekKey(minimum[0]) && heaps[1].peekKey(minimum[1])) {
+        if (result.distance != NO_PATH && minimum[0] + minimum[1] >= result.distance) break;
+        int side = minimum[0] <= minimum[1] ? 0 : 1;
+        const Graph& graph = *graphs[side];
+        vector<int64_t>& distance = distances[side];
+        const vector<int64_t>& other = distances[1 - side];
+        int offset = side * n; // Backward distances follow the forward ones in the trace
+
+        int u;
+        int64_t key;
+        if (!heaps[side].pop(u, key)) break;
+        states[u] |= marks[side];
+        result.settled++;
+        m_trace.nodeState(u, states[u]);
+
+        for (size_t arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.getTarget(arc);
+            int64_t candidate = distance[u] + graph.getWeight(arc);
+            if (candidate >= distance[v]) continue;
+            m_trace.relax(offset + u, offset + v, traceValue(candidate));
+            distance[v] = candidate;
+            parentArcs[side][v] = arc;
+            if (!(states[v] & marks[side])) heaps[side].update(v, candidate);
+            if (other[v] != NO_PATH && candidate + other[v] < result.distance) {
+                result.distance = candidate + other[v];
+                meeting = v;
+            }
+        }
+    }
+
+    m_heapStats = heaps[0].getStats();
+    const HeapStats& backward = heaps[1].getStats();
+    m_heapStats.pushes += backward.pushes;
+    m_heapStats.decreaseKeys += backward.decreaseKeys;
+    m_heapStats.pops += backward.pops;
+    m_heapStats.stalePops += backward.stalePops;
+    m_heapStats.maxSize += backward.maxSize;
+    if (meeting >= 0) {
+        addPath(parentArcs[0], m_graph, m_source, meeting);
+        addPath(parentArcs[1], reverse, m_target, meeting);
+    }
+    return result;
+}
+
+// Dijkstra on keys g(v) + h(v), where h is the straight-line distance to the
+// target in screen units times the smallest weight per unit length of any
+// edge. That scale keeps h consistent (h(u) <= w(u, v) + h(v)) whatever the
+// weights mean, so nodes are still settled at most once.
+template <typename Heap>
+DijkstraVisualizer::QueryResult DijkstraVisualizer::runAStar() {
+    int n = m_graph.getNodeCount();
+    auto length = [&](int u, int v) {
+        sf::Vector2f d = m_renderer.getNodePosition(u) - m_renderer.getNodePosition(v);
+        return sqrt(static_cast<double>(d.x) * d.x + static_cast<double>(d.y) * d.y);
+    };
+    double scale = numeric_limits<double>::infinity();
+    for (int u = 0; u < n; ++u) {
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            double l = length(u, m_graph.getTarget(arc));
+            if (l > 0) scale = min(scale, m_graph.getWeight(arc) / l);
+        }
+    }
+    scale = isfinite(scale) && scale > 0 ? scale * (1 - 1e-9) : 0; // Margin for rounding
+    auto heuristic = [&](int v) { return static_cast<int64_t>(scale * length(v, m_target)); };
+
+    vector<int64_t> distances(n, NO_PATH);
+    vector<bool> settled(n, false);
+    vector<size_t> parentArc(n, SIZE_MAX);
+    Heap heap(n);
+    distances[m_source] = 0;
+    heap.update(m_source, heuristic(m_source));
+
+    QueryResult result{0, NO_PATH};
+    int u;
+    int64_t key;
+    while (heap.pop(u, key)) {
+        settled[u] = true;
+        result.settled++;
+        m_trace.nodeState(u, SETTLED);
+        if (u == m_target) break;
+
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = m_graph.getTarget(arc);
+            int64_t distance = distances[u] + m_graph.getWeight(arc);
+            if (distance < distances[v]) {
+                m_trace.relax(u, v, traceValue(distance));
+                distances[v] = distance;
+                parentArc[v] = arc;
+                if (!settled[v]) heap.update(v, distance + heuristic(v));
+            }
+        }
+    }
+    m_heapStats = heap.getStats();
+    result.distance = distances[m_target];
+    if (result.distance != NO_PATH) addPath(parentArc, m_graph, m_source, m_target);
+    return result;
+}
+
+// Follows parent arcs from node back to `from`, adding their edges to the path
+void DijkstraVisualizer::addPath(const vector<size_t>& parentArc, const Graph& graph, int from, int node) {
+    for (int hops = 0; node != from && parentArc[node] != SIZE_MAX && hops < graph.getNodeCount(); ++hops) {
+        m_pathEdges.push_back(graph.getEdgeId(parentArc[node]));
+        node = graph.getSource(parentArc[node]);
+    }
+}
+
+sf::Color DijkstraVisualizer::getEdgeColor(int edge) const {
+    if (edge == m_highlightedEdge) return sf::Color::Yellow;
+    if (m_isPathShown && find(m_pathEdges.begin(), m_pathEdges.end(), edge) != m_pathEdges.end()) return sf::Color::Cyan;
+    return sf::Color::White;
+}
+
+void DijkstraVisualizer::setPathShown(bool shown) {
+    if (shown == m_isPathShown) return;
+    m_isPathShown = shown;
+    for (int edge : m_pathEdges) m_renderer.setEdgeColor(edge, getEdgeColor(edge));
+}
+
+// The node drawn under a point, if any; the nearest one wins
+int DijkstraVisualizer::findNodeAt(sf::Vector2f position) const {
+    float reach = max(m_renderer.getNodeRadius(), 8.f); // Tiny nodes are still clickable
+    int nearest = -1;
+    float nearestSquared = reach * reach;
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        sf::Vector2f d = m_renderer.getNodePosition(u) - position;
+        float squared = d.x * d.x + d.y * d.y;
+        if (squared <= nearestSquared) {
+            nearest = u;
+            nearestSquared = squared;
+        }
+    }
+    return nearest;
+}
+
+void DijkstraVisualizer::requery() {
+    recordTrace();
+    m_isVisualizing = false;
+    m_isDone = false;
+}
+
+void DijkstraVisualizer::loadTrace() {
+    Trace loaded;
+    if (!loaded.loadFromFile(TRACE_FILE)) return;
+
+    // The label names the mode and the query, e.g. "A* 0 6"
+    istringstream label(loaded.getLabel());
+    string name;
+    label >> name;
+    QueryMode mode = QueryMode::FullTree;
+    if (name == "Bidirectional") {
+        mode = QueryMode::Bidirectional;
+        label >> name;
+    } else if (name == "A*") {
+        mode = QueryMode::AStar;
+        name = "Dijkstra"; // Same operands follow
+    }
+    int n = m_graph.getNodeCount();
+    int source = -1, target = m_target;
+    label >> source;
+    if (mode != QueryMode::FullTree) label >> target;
+    size_t valueCount = mode == QueryMode::Bidirectional ? 2 * n : n;
+    if (name != "Dijkstra" || label.fail() || source < 0 || source >= n || target < 0 || target >= n ||
+        loaded.getValueCount() != valueCount || loaded.getStateCount() != static_cast<size_t>(n)) {
+        cerr << TRACE_FILE << " does not match this graph." << endl;
+        return;
+    }
+    m_mode = mode;
+    m_source = source;
+    m_target = target;
+    setPathShown(false);
+    m_pathEdges.clear(); // Not stored in the trace
+    m_querySummary = "Loaded " + loaded.getLabel();
+    m_trace = move(loaded);
+    m_player.load(m_trace);
+    m_isVisualizing = false;
+    m_isDone = m_player.atEnd();
+    cout << "Loaded " << m_trace.getLabel() << " trace from " << TRACE_FILE << ": " << m_trace.size() << " steps." << endl;
 }
 
 void DijkstraVisualizer::reset() {
     buildGraph();
-    int n = m_nodes.size();
-    m_distances.assign(n, numeric_limits<int>::max());
-    m_visited.assign(n, false);
-    while(!m_pq.empty()) m_pq.pop();
-
-    m_distances[0] = 0;
-    m_pq.push({0, 0}); // {distance, node}
+    int n = m_graph.getNodeCount();
+    if (m_source >= n) m_source = 0;
+    if (m_target < 0 || m_target >= n) m_target = n - 1;
+    recordTrace();
     m_isVisualizing = false;
     m_isDone = false;
     cout << "Dijkstra's reset. Press SPACE to start." << endl;
 }
 
+void DijkstraVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
 void DijkstraVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::S && m_trace.saveToFile(TRACE_FILE)) cout << "Trace saved to " << TRACE_FILE << "." << endl;
+        if (event.key.code == sf::Keyboard::L) loadTrace();
+        if (event.key.code == sf::Keyboard::H) {
+            m_heapKind = static_cast<HeapKind>((static_cast<int>(m_heapKind) + 1) % size(ALL_HEAP_KINDS));
+            requery();
+        }
+        if (event.key.code == sf::Keyboard::Q) {
+            m_mode = static_cast<QueryMode>((static_cast<int>(m_mode) + 1) % 3);
+            requery();
+        }
+        if (event.key.code == sf::Keyboard::Right) {
+            m_isVisualizing = false;
+            m_player.stepForward();
+            m_isDone = m_player.atEnd();
+        }
+        if (event.key.code == sf::Keyboard::Left) {
+            m_isVisualizing = false;
+            m_player.stepBackward();
+            m_isDone = false;
+        }
+    }
+    // Left click picks the source, right click the target
+    if (event.type == sf::Event::MouseButtonPressed &&
+        (event.mouseButton.button == sf::Mouse::Left || event.mouseButton.button == sf::Mouse::Right)) {
+        int node = findNodeAt(m_window->mapPixelToCoords({event.mouseButton.x, event.mouseButton.y}));
+        if (node < 0) return;
+        if (event.mouseButton.button == sf::Mouse::Left) m_source = node;
+        else m_target = node;
+        requery();
     }
 }
 
-void DijkstraVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+bool DijkstraVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
 
-    if (m_pq.empty()) {
-        m_isDone = true; m_isVisualizing = false; return;
+    if (!m_player.stepForward()) {
+        m_isDone = true; m_isVisualizing = false;
     }
+    return true;
+}
 
-    int u = m_pq.top().second;
-    m_pq.pop();
-
-    if (m_visited[u]) return;
-    m_visited[u] = true;
+void DijkstraVisualizer::draw() {
+    m_window->clear(sf::Color(30, 30, 30));
+    const TraceState& state = m_player.getState();
+    const TraceEvent* last = m_player.getLastEvent();
+    int n = m_graph.getNodeCount();
+    bool bidirectional = state.values.size() == 2 * static_cast<size_t>(n);
+    const int unreached = numeric_limits<int>::max();
 
-    for (const auto& edge : m_nodes[u].adj) {
-        int v = edge.first;
-        int weight = edge.second;
-        if (m_distances[u] + weight < m_distances[v]) {
-            m_distances[v] = m_distances[u] + weight;
-            m_pq.push({m_distances[v], v});
-        }
+    // Highlight the edge just relaxed; a backward relaxation u -> v walks the edge v -> u
+    int highlighted = -1;
+    if (last && last->type == TraceEvent::Type::EdgeRelax) {
+        highlighted = last->a < n ? m_graph.findEdgeId(last->a, last->b) : m_graph.findEdgeId(last->b - n, last->a - n);
     }
-}
+    if (highlighted != m_highlightedEdge) {
+        int previous = m_highlightedEdge;
+        m_highlightedEdge = highlighted;
+        if (previous >= 0) m_renderer.setEdgeColor(previous, getEdgeColor(previous));
+        if (highlighted >= 0) m_renderer.setEdgeColor(highlighted, getEdgeColor(highlighted));
+    }
+    setPathShown(m_player.atEnd());
 
-void DijkstraVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for (const auto& edge : m_edges) m_window.draw(edge);
-    for (const auto& pair : m_edgeWeights) m_window.draw(pair.second);
-
-    for (auto& pair : m_nodes) {
-        if (m_visited[pair.first]) pair.second.shape.setFillColor(sf::Color::Green);
-        else pair.second.shape.setFillColor(sf::Color(100, 100, 250));
-        
-        string distStr = (m_distances[pair.first] == numeric_limits<int>::max()) ? "inf" : to_string(m_distances[pair.first]);
-        pair.second.distLabel.setString(distStr);
-        pair.second.distLabel.setPosition(pair.second.shape.getPosition() + sf::Vector2f(0, 35));
-        
-        m_window.draw(pair.second.shape);
-        m_window.draw(pair.second.label);
-        m_window.draw(pair.second.distLabel);
+    for (int u = 0; u < n; ++u) {
+        bool reachedBackward = bidirectional && state.values[n + u] != unreached;
+        if (last && last->type == TraceEvent::Type::NodeState && last->a == u) m_renderer.setNodeColor(u, sf::Color::Yellow);
+        else if (state.states[u] & SETTLED) m_renderer.setNodeColor(u, sf::Color::Green);
+        else if (state.states[u] & SETTLED_BACKWARD) m_renderer.setNodeColor(u, BACKWARD_SETTLED_COLOR);
+        else if (state.values[u] != unreached) m_renderer.setNodeColor(u, FORWARD_FRONTIER_COLOR);
+        else if (reachedBackward) m_renderer.setNodeColor(u, BACKWARD_FRONTIER_COLOR);
+        else m_renderer.setNodeColor(u, NODE_COLOR);
+
+        if (m_distLabels.empty()) continue; // Too many nodes to label
+        string distStr = "inf";
+        if (state.values[u] != unreached) distStr = to_string(state.values[u]);
+        else if (reachedBackward) distStr = "b" + to_string(state.values[n + u]); // Distance to the target
+        m_renderer.setLabelText(m_distLabels[u], distStr);
     }
+    m_renderer.draw(*m_window, m_font);
+    const char* title = m_mode == QueryMode::Bidirectional ? "Bidirectional Dijkstra" : (m_mode == QueryMode::AStar ? "A* Search" : "Dijkstra's Algorithm");
     std::string status = m_isDone ? "Complete!" : (m_isVisualizing ? "Visualizing..." : "Paused.");
-    sf::Text infoText(std::string("Dijkstra's Algorithm | ") + status, m_font, 20); 
+    sf::Text infoText(std::string(title) + " | " + status + " | Step " + to_string(m_player.getPosition()) + "/" + to_string(m_player.getLength()) + " | Left/Right to step | S/L save/load", m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    sf::Text heapText("H: " + string(heapKindName(m_usedHeap)) + " | max size " + to_string(m_heapStats.maxSize) +
+                      " | pushes " + to_string(m_heapStats.pushes) + " | decrease-keys " + to_string(m_heapStats.decreaseKeys) +
+                      " | pops " + to_string(m_heapStats.pops) + " (+" + to_string(m_heapStats.stalePops) + " stale)", m_font, 18);
+    heapText.setFillColor(sf::Color(200, 200, 200));
+    heapText.setPosition(10, 38);
+    m_window->draw(heapText);
+
+    sf::Text queryText(m_querySummary + " | Q: mode | click: source, right click: target", m_font, 18);
+    queryText.setFillColor(sf::Color(200, 200, 200));
+    queryText.setPosition(10, 62);
+    m_window->draw(queryText);
 }
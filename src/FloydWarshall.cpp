@@ -0,0 +1,208 @@
+#include "FloydWarshall.h"
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#if HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    // c[j] = min(c[j], a + b[j]) for j < length, where a < INF. An INF b[j]
+    // must not count as a path, which only a negative a can make it look like.
+    // Every entry stays in [-INF, INF], so a + b[j] cannot overflow, and only
+    // a negative a can take it below -INF, where it is clamped: around a
+    // negative cycle distances would otherwise halve past INT_MIN.
+    void relaxRow(int* c, const int* b, int a, int length) {
+        if (a >= 0) {
+            for (int j = 0; j < length; ++j) c[j] = min(c[j], a + b[j]);
+        } else {
+            for (int j = 0; j < length; ++j) {
+                if (b[j] != FloydWarshall::INF) c[j] = min(c[j], max(a + b[j], -FloydWarshall::INF));
+            }
+        }
+    }
+
+    // Classic order, k outermost, so c may be a or b (diagonal and panel tiles)
+    void relaxTileScalar(int* c, const int* a, const int* b, int block, size_t stride) {
+        for (int k = 0; k < block; ++k) {
+            const int* bRow = b + k * stride;
+            for (int i = 0; i < block; ++i) {
+                int aik = a[i * stride + k];
+                if (aik != FloydWarshall::INF) relaxRow(c + i * stride, bRow, aik, block);
+            }
+        }
+    }
+
+    // c is distinct from a and b, so each row of c is finished in one go
+    void multiplyTileScalar(int* c, const int* a, const int* b, int block, size_t stride) {
+        for (int i = 0; i < block; ++i) {
+            int* cRow = c + i * stride;
+            const int* aRow = a + i * stride;
+            for (int k = 0; k < block; ++k) {
+                if (aRow[k] != FloydWarshall::INF) relaxRow(cRow, b + k * stride, aRow[k], block);
+            }
+        }
+    }
+
+#if HAS_AVX2_KERNELS
+    AVX2_TARGET void relaxRowAvx2(int* c, const int* b, int a, int length) {
+        const __m256i av = _mm256_set1_epi32(a);
+        int j = 0;
+        if (a >= 0) {
+            for (; j + 8 <= length; j += 8) {
+                __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+                __m256i cv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epi32(cv, _mm256_add_epi32(av, bv)));
+            }
+        } else {
+            const __m256i inf = _mm256_set1_epi32(FloydWarshall::INF);
+            const __m256i floor = _mm256_set1_epi32(-FloydWarshall::INF);
+            for (; j + 8 <= length; j += 8) {
+                __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+                __m256i cv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+                __m256i sum = _mm256_max_epi32(_mm256_add_epi32(av, bv), floor);
+                sum = _mm256_blendv_epi8(sum, inf, _mm256_cmpeq_epi32(bv, inf));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epi32(cv, sum));
+            }
+        }
+        for (; j < length; ++j) {
+            if (b[j] != FloydWarshall::INF) c[j] = min(c[j], max(a + b[j], -FloydWarshall::INF));
+        }
+    }
+
+    AVX2_TARGET void relaxTileAvx2(int* c, const int* a, const int* b, int block, size_t stride) {
+        for (int k = 0; k < block; ++k) {
+            const int* bRow = b + k * stride;
+            for (int i = 0; i < block; ++i) {
+                int aik = a[i * stride + k];
+                if (aik != FloydWarshall::INF) relaxRowAvx2(c + i * stride, bRow, aik, block);
+            }
+        }
+    }
+
+    // 64 ints of a row of c stay in registers across all k
+    AVX2_TARGET void multiplyTileAvx2(int* c, const int* a, const int* b, int block, size_t stride) {
+        if (block % 64 != 0) {
+            for (int i = 0; i < block; ++i) {
+                for (int k = 0; k < block; ++k) {
+                    int aik = a[i * stride + k];
+                    if (aik != FloydWarshall::INF) relaxRowAvx2(c + i * stride, b + k * stride, aik, block);
+                }
+            }
+            return;
+        }
+        const __m256i inf = _mm256_set1_epi32(FloydWarshall::INF);
+        const __m256i floor = _mm256_set1_epi32(-FloydWarshall::INF);
+        for (int i = 0; i < block; ++i) {
+            int* cRow = c + i * stride;
+            const int* aRow = a + i * stride;
+            for (int j = 0; j < block; j += 64) {
+                __m256i acc[8];
+                for (int v = 0; v < 8; ++v) acc[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cRow + j + 8 * v));
+                for (int k = 0; k < block; ++k) {
+                    if (aRow[k] == FloydWarshall::INF) continue;
+                    const __m256i av = _mm256_set1_epi32(aRow[k]);
+                    const int* bRow = b + k * stride + j;
+                    if (aRow[k] >= 0) {
+                        for (int v = 0; v < 8; ++v) {
+                            __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 8 * v));
+                            acc[v] = _mm256_min_epi32(acc[v], _mm256_add_epi32(av, bv));
+                        }
+                    } else {
+                        for (int v = 0; v < 8; ++v) {
+                            __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bRow + 8 * v));
+                            __m256i sum = _mm256_max_epi32(_mm256_add_epi32(av, bv), floor);
+                            sum = _mm256_blendv_epi8(sum, inf, _mm256_cmpeq_epi32(bv, inf));
+                            acc[v] = _mm256_min_epi32(acc[v], sum);
+                        }
+                    }
+                }
+                for (int v = 0; v < 8; ++v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(cRow + j + 8 * v), acc[v]);
+            }
+        }
+    }
+#endif
+}
+
+FloydWarshall::FloydWarshall(int nodeCount, int block)
+    : m_nodeCount(nodeCount), m_block(max(block, 1)), m_stride((max(nodeCount, 1) + m_block - 1) / m_block * m_block) {
+    size_t cells = static_cast<size_t>(m_stride) * m_stride;
+    m_dist.reset(static_cast<int*>(::operator new[](cells * sizeof(int), align_val_t(ALIGNMENT))));
+    fill(m_dist.get(), m_dist.get() + cells, INF);
+    for (int i = 0; i < m_stride; ++i) m_dist[static_cast<size_t>(i) * m_stride + i] = 0; // Padding nodes stay isolated
+}
+
+void FloydWarshall::addEdge(int u, int v, int weight) {
+    int& cell = m_dist[static_cast<size_t>(u) * m_stride + v];
+    cell = min(cell, max(weight, -INF));
+}
+
+void FloydWarshall::relaxTile(int* c, const int* a, const int* b) const {
+#if HAS_AVX2_KERNELS
+    if (hasAvx2()) return relaxTileAvx2(c, a, b, m_block, m_stride);
+#endif
+    relaxTileScalar(c, a, b, m_block, m_stride);
+}
+
+void FloydWarshall::multiplyTile(int* c, const int* a, const int* b) const {
+#if HAS_AVX2_KERNELS
+    if (hasAvx2()) return multiplyTileAvx2(c, a, b, m_block, m_stride);
+#endif
+    multiplyTileScalar(c, a, b, m_block, m_stride);
+}
+
+void FloydWarshall::runPhase(int round, FloydWarshallPhase phase, unsigned threads) {
+    int blocks = getBlockCount();
+    int* diagonal = tile(round, round);
+    switch (phase) {
+        case FloydWarshallPhase::Diagonal:
+            relaxTile(diagonal, diagonal, diagonal);
+            break;
+        case FloydWarshallPhase::Panels:
+            // Tasks [0, blocks) are row-panel tiles, [blocks, 2 * blocks) column-panel tiles
+            ThreadPool::getInstance().parallelFor(2 * blocks, 1, [&](size_t begin, size_t end) {
+                for (size_t task = begin; task < end; ++task) {
+                    int other = static_cast<int>(task % blocks);
+                    if (other == round) continue;
+                    if (task < static_cast<size_t>(blocks)) {
+                        int* c = tile(round, other);
+                        relaxTile(c, diagonal, c);
+                    } else {
+                        int* c = tile(other, round);
+                        relaxTile(c, c, diagonal);
+                    }
+                }
+            }, threads);
+            break;
+        case FloydWarshallPhase::Remainder:
+            ThreadPool::getInstance().parallelFor(static_cast<size_t>(blocks) * blocks, 1, [&](size_t begin, size_t end) {
+                for (size_t task = begin; task < end; ++task) {
+                    int row = static_cast<int>(task / blocks), col = static_cast<int>(task % blocks);
+                    if (row == round || col == round) continue;
+                    multiplyTile(tile(row, col), tile(row, round), tile(round, col));
+                }
+            }, threads);
+            break;
+    }
+}
+
+void FloydWarshall::run(unsigned threads) {
+    for (int round = 0; round < getBlockCount(); ++round) {
+        runPhase(round, FloydWarshallPhase::Diagonal, threads);
+        runPhase(round, FloydWarshallPhase::Panels, threads);
+        runPhase(round, FloydWarshallPhase::Remainder, threads);
+    }
+}
+
+bool FloydWarshall::hasNegativeCycle() const {
+    for (int i = 0; i < m_nodeCount; ++i) {
+        if (getDistance(i, i) < 0) return true;
+    }
+    return false;
+}
+
+const char* FloydWarshall::getKernelName() {
+    return hasAvx2() ? "AVX2" : "scalar";
+}
@@ -1,34 +1,140 @@
 #include "FloydWarshallVisualizer.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
-#include <limits>
+#include <sstream>
 
 using namespace std;
 
-const int INF = 1e9;
-
-FloydWarshallVisualizer::FloydWarshallVisualizer(sf::RenderWindow& window)
-    : Visualizer(window), m_isVisualizing(false), m_isDone(false), m_k(0), m_i(0), m_j(0) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) cerr << "Error loading font" << endl;
+FloydWarshallVisualizer::FloydWarshallVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_nodeCount(0), m_useJohnson(false), m_reweighted(false), m_nextSource(0), m_batchStart(0), m_tiles(sf::Quads), m_replaying(false), m_replayStep(0), m_isVisualizing(false), m_isDone(false), m_negativeCycle(false), m_round(0),
+      m_phase(FloydWarshallPhase::Diagonal), m_hasRun(false), m_threads(ThreadPool::getInstance().getThreadCount()), m_runMs(0.0) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.5); // One phase every 0.5s by default
 }
 
 void FloydWarshallVisualizer::buildGraph() {
-    m_nodeCount = 5;
-    m_distMatrix.assign(m_nodeCount, vector<int>(m_nodeCount, INF));
-    for (int i = 0; i < m_nodeCount; ++i) m_distMatrix[i][i] = 0;
-    auto addEdge = [&](int u, int v, int w) { m_distMatrix[u][v] = w; };
-    addEdge(0, 1, 3); addEdge(0, 2, 8); addEdge(0, 4, -4);
-    addEdge(1, 3, 1); addEdge(1, 4, 7); addEdge(2, 1, 4);
-    addEdge(3, 0, 2); addEdge(3, 2, -5); addEdge(4, 3, 6);
+    const GraphFile* file = getWorkloadGraph();
+    if (file && file->nodeCount > MAX_MATRIX_NODES) {
+        cerr << "Error: Floyd-Warshall keeps an n x n matrix; " << file->nodeCount << " nodes is more than "
+             << MAX_MATRIX_NODES << ", showing the example instead" << endl;
+        file = nullptr;
+    }
+    int block;
+    if (file) {
+        m_nodeCount = file->nodeCount;
+        block = m_nodeCount <= MAX_SHOWN_NODES ? 2 : (m_nodeCount <= 512 ? 8 : FloydWarshall::DEFAULT_BLOCK);
+        m_graph = Graph(m_nodeCount, file->edges, file->directed);
+    } else {
+        // Blocks of 2 nodes, so even the example has tiles to show
+        m_nodeCount = 5;
+        block = 2;
+        vector<GraphEdge> edges = {
+            {0, 1, 3}, {0, 2, 8}, {0, 4, -4}, {1, 3, 1}, {1, 4, 7},
+            {2, 1, 4}, {3, 0, 2}, {3, 2, -5}, {4, 3, 6}
+        };
+        m_graph = Graph(m_nodeCount, edges, true);
+    }
+    m_engine = make_unique<FloydWarshall>(m_nodeCount, block);
+    addEdges(*m_engine);
+    m_johnson = make_unique<Johnson>(m_graph);
+}
+
+void FloydWarshallVisualizer::addEdges(FloydWarshall& engine) const {
+    for (int u = 0; u < m_nodeCount; ++u) {
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) engine.addEdge(u, m_graph.getTarget(arc), m_graph.getWeight(arc));
+    }
+}
+
+// Runs a second engine through every phase, recording what each one changed
+void FloydWarshallVisualizer::recordTrace() {
+    m_trace = Trace();
+    m_phaseEnds.clear();
+    if (m_nodeCount > MAX_TRACED_NODES) return;
+    FloydWarshall engine(m_nodeCount, m_engine->getBlock());
+    addEdges(engine);
+    TraceState initial;
+    initial.values.resize(static_cast<size_t>(m_nodeCount) * m_nodeCount);
+    for (int u = 0; u < m_nodeCount; ++u) {
+        for (int v = 0; v < m_nodeCount; ++v) initial.values[u * m_nodeCount + v] = engine.getDistance(u, v);
+    }
+    initial.states.assign(1, 0);
+    vector<int> distances = initial.values;
+    m_trace = Trace(move(initial));
+    m_trace.setLabel("Floyd-Warshall " + to_string(m_nodeCount) + " " + to_string(engine.getBlock()));
+
+    for (int round = 0; round < engine.getBlockCount(); ++round) {
+        m_trace.markKeyframe();
+        for (FloydWarshallPhase phase : { FloydWarshallPhase::Diagonal, FloydWarshallPhase::Panels, FloydWarshallPhase::Remainder }) {
+            engine.runPhase(round, phase, m_threads);
+            m_trace.nodeState(0, round * 3 + static_cast<int>(phase) + 1);
+            for (int u = 0; u < m_nodeCount; ++u) {
+                for (int v = 0; v < m_nodeCount; ++v) {
+                    int& distance = distances[u * m_nodeCount + v];
+                    if (engine.getDistance(u, v) == distance) continue;
+                    distance = engine.getDistance(u, v);
+                    m_trace.write(u * m_nodeCount + v, distance);
+                }
+            }
+        }
+    }
+    findPhaseEnds();
+}
+
+// Every phase starts with the event naming it
+void FloydWarshallVisualizer::findPhaseEnds() {
+    m_phaseEnds.clear();
+    TracePlayer scan;
+    scan.load(m_trace);
+    while (scan.stepForward()) {
+        if (scan.getLastEvent()->type == TraceEvent::Type::NodeState && scan.getPosition() > 1) m_phaseEnds.push_back(scan.getPosition() - 1);
+    }
+    if (scan.getPosition() > 0) m_phaseEnds.push_back(scan.getPosition());
+    m_player.load(m_trace);
+}
+
+void FloydWarshallVisualizer::loadTrace() {
+    Trace loaded;
+    if (!loaded.loadFromFile(TRACE_FILE)) return;
+
+    // The label is "Floyd-Warshall <nodes> <block>"
+    istringstream label(loaded.getLabel());
+    string name;
+    int nodes = -1, block = -1;
+    label >> name >> nodes >> block;
+    size_t cells = static_cast<size_t>(m_nodeCount) * m_nodeCount;
+    if (name != "Floyd-Warshall" || label.fail() || nodes != m_nodeCount || block != m_engine->getBlock() ||
+        loaded.getValueCount() != cells || loaded.getStateCount() != 1) {
+        cerr << TRACE_FILE << " does not match this graph." << endl;
+        return;
+    }
+    m_trace = move(loaded);
+    findPhaseEnds();
+    if (m_phaseEnds.size() != 3 * static_cast<size_t>(m_engine->getBlockCount())) {
+        cerr << TRACE_FILE << " does not hold a whole run." << endl;
+        recordTrace();
+        return;
+    }
+    m_useJohnson = false;
+    resetProgress();
+    m_replaying = true;
+    cout << "Loaded " << m_trace.getLabel() << " trace from " << TRACE_FILE << ": " << m_phaseEnds.size() << " phases, "
+         << m_trace.size() << " events. Press SPACE to replay." << endl;
 }
 
 void FloydWarshallVisualizer::setupText() {
     m_matrixText.clear();
+    if (m_nodeCount > MAX_SHOWN_NODES) return; // Drawn as tiles
+    float cellWidth = min(100.f, (getCanvasSize().x - 350.f) / m_nodeCount);
+    float cellHeight = min(80.f, (getCanvasSize().y - 250.f) / m_nodeCount);
     for (int r = 0; r < m_nodeCount; ++r) {
         for (int c = 0; c < m_nodeCount; ++c) {
             sf::Text text;
             text.setFont(m_font);
-            text.setCharacterSize(24);
-            text.setPosition(300 + c * 100, 200 + r * 80);
+            text.setCharacterSize(cellHeight >= 60.f ? 24 : 16);
+            text.setPosition(300 + c * cellWidth, 200 + r * cellHeight);
             m_matrixText.push_back(text);
         }
     }
@@ -37,59 +143,219 @@ void FloydWarshallVisualizer::setupText() {
 void FloydWarshallVisualizer::reset() {
     buildGraph();
     setupText();
+    resetProgress();
+    if (m_useJohnson) {
+        cout << "Johnson reset (" << m_nodeCount << " nodes, " << m_graph.getArcCount() << " arcs). Press SPACE to start." << endl;
+        return;
+    }
+    recordTrace();
+    cout << "Floyd-Warshall reset (" << m_nodeCount << " nodes, " << m_engine->getBlockCount() << " x "
+         << m_engine->getBlockCount() << " tiles, " << FloydWarshall::getKernelName() << " kernel). Press SPACE to start." << endl;
+}
+
+void FloydWarshallVisualizer::resetProgress() {
+    m_replaying = false;
+    m_replayStep = 0;
     m_isVisualizing = false;
     m_isDone = false;
-    m_k = 0; m_i = 0; m_j = 0;
-    cout << "Floyd-Warshall reset. Press SPACE to start." << endl;
+    m_negativeCycle = false;
+    m_round = 0;
+    m_phase = FloydWarshallPhase::Diagonal;
+    m_hasRun = false;
+    m_runMs = 0.0;
+    m_reweighted = false;
+    m_nextSource = 0;
+    m_batchStart = 0;
+}
+
+void FloydWarshallVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
 }
 
 void FloydWarshallVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::S) {
+            if (m_useJohnson || m_trace.size() == 0) cerr << "Only Floyd-Warshall runs of up to " << MAX_TRACED_NODES << " nodes are traced." << endl;
+            else if (m_trace.saveToFile(TRACE_FILE)) cout << "Trace saved to " << TRACE_FILE << "." << endl;
+        }
+        if (event.key.code == sf::Keyboard::L) loadTrace();
+        if (event.key.code == sf::Keyboard::J) {
+            m_useJohnson = !m_useJohnson;
+            reset();
+        }
+        if (event.key.code == sf::Keyboard::T) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            reset();
+        }
     }
 }
 
-void FloydWarshallVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+// About 64 steps for any graph, one source per step for small ones
+int FloydWarshallVisualizer::getBatchSize() const {
+    return max(1, (m_nodeCount + 63) / 64);
+}
+
+int FloydWarshallVisualizer::getDistance(int u, int v) const {
+    if (m_replaying) return m_player.getState().values[static_cast<size_t>(u) * m_nodeCount + v];
+    return m_useJohnson ? m_johnson->getDistance(u, v) : m_engine->getDistance(u, v);
+}
+
+bool FloydWarshallVisualizer::hasNegativeCycle() const {
+    if (!m_replaying) return m_engine->hasNegativeCycle();
+    for (int v = 0; v < m_nodeCount; ++v) {
+        if (getDistance(v, v) < 0) return true;
+    }
+    return false;
+}
 
-    if (m_k < m_nodeCount) {
-        if (m_distMatrix[m_i][m_k] != INF && m_distMatrix[m_k][m_j] != INF &&
-            m_distMatrix[m_i][m_k] + m_distMatrix[m_k][m_j] < m_distMatrix[m_i][m_j]) {
-            m_distMatrix[m_i][m_j] = m_distMatrix[m_i][m_k] + m_distMatrix[m_k][m_j];
+bool FloydWarshallVisualizer::stepJohnson() {
+    auto startTime = chrono::steady_clock::now();
+    if (!m_reweighted) {
+        m_reweighted = true;
+        if (!m_johnson->reweight()) {
+            m_negativeCycle = true;
+            m_isDone = true; m_isVisualizing = false;
+            cout << "Johnson: negative cycle of " << m_johnson->getNegativeCycle().size() << " arcs found while reweighting." << endl;
         }
-        m_j++;
-        if (m_j >= m_nodeCount) {
-            m_j = 0; m_i++;
-            if (m_i >= m_nodeCount) {
-                m_i = 0; m_k++;
-            }
+    } else {
+        m_batchStart = m_nextSource;
+        m_nextSource = min(m_nodeCount, m_nextSource + getBatchSize());
+        m_johnson->runSources(m_batchStart, m_nextSource, m_threads);
+        if (m_nextSource == m_nodeCount) {
+            m_isDone = true; m_isVisualizing = false;
         }
+    }
+    m_runMs += chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_hasRun = true;
+    if (m_isDone && !m_negativeCycle) cout << "Johnson done in " << m_runMs << " ms." << endl;
+    return true;
+}
+
+bool FloydWarshallVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+    if (m_useJohnson) return stepJohnson();
+
+    if (m_replaying) {
+        m_player.seek(m_phaseEnds[m_replayStep++]);
     } else {
-        m_isDone = true; m_isVisualizing = false;
+        auto startTime = chrono::steady_clock::now();
+        m_engine->runPhase(m_round, m_phase, m_threads);
+        m_runMs += chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    }
+    advancePhase();
+    return true;
+}
+
+// Moves past the phase that just ran or was replayed
+void FloydWarshallVisualizer::advancePhase() {
+    m_hasRun = true;
+    if (m_phase != FloydWarshallPhase::Remainder) {
+        m_phase = static_cast<FloydWarshallPhase>(static_cast<int>(m_phase) + 1);
+        return;
     }
+    m_phase = FloydWarshallPhase::Diagonal;
+    if (++m_round < m_engine->getBlockCount()) return;
+    m_negativeCycle = hasNegativeCycle();
+    m_isDone = true; m_isVisualizing = false;
+    if (m_replaying) cout << "Replay of " << m_trace.getLabel() << " done";
+    else cout << "Floyd-Warshall done in " << m_runMs << " ms";
+    cout << (m_negativeCycle ? "; negative cycle found." : ".") << endl;
+}
+
+// Tiles of the last phase are highlighted, the rest of the current round's
+// row and column dimmed; Transparent for any other tile
+sf::Color FloydWarshallVisualizer::getTileColor(int row, int col) const {
+    if (m_isDone) return m_negativeCycle ? sf::Color::Red : sf::Color::Green;
+    if (!m_hasRun) return sf::Color::Transparent;
+    int round = m_phase == FloydWarshallPhase::Diagonal ? m_round - 1 : m_round;
+    FloydWarshallPhase last = m_phase == FloydWarshallPhase::Diagonal ? FloydWarshallPhase::Remainder
+                                                                      : static_cast<FloydWarshallPhase>(static_cast<int>(m_phase) - 1);
+    bool diagonal = row == round && col == round;
+    bool panel = (row == round) != (col == round);
+    switch (last) {
+        case FloydWarshallPhase::Diagonal:  return diagonal ? sf::Color::Yellow : sf::Color::Transparent;
+        case FloydWarshallPhase::Panels:    return panel ? sf::Color::Cyan : (diagonal ? sf::Color(140, 140, 60) : sf::Color::Transparent);
+        case FloydWarshallPhase::Remainder: return diagonal || panel ? sf::Color(60, 120, 120) : sf::Color(80, 140, 255);
+    }
+    return sf::Color::Transparent;
+}
+
+// Johnson fills whole rows: the last batch is highlighted
+sf::Color FloydWarshallVisualizer::getRowColor(int node) const {
+    if (m_isDone) return m_negativeCycle ? sf::Color::Red : sf::Color::Green;
+    if (node >= m_batchStart && node < m_nextSource) return sf::Color::Yellow;
+    return node < m_nextSource ? sf::Color(80, 140, 255) : sf::Color::Transparent;
 }
 
 void FloydWarshallVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for (int r = 0; r < m_nodeCount; ++r) {
-        for (int c = 0; c < m_nodeCount; ++c) {
-            int index = r * m_nodeCount + c;
-            string val = (m_distMatrix[r][c] == INF) ? "inf" : to_string(m_distMatrix[r][c]);
-            m_matrixText[index].setString(val);
-            m_matrixText[index].setFillColor(sf::Color::White);
-            if (m_isVisualizing && !m_isDone) {
-                if (r == m_i && c == m_j) m_matrixText[index].setFillColor(sf::Color::Yellow); // Cell being updated
-                if (r == m_i || c == m_k) m_matrixText[index].setFillColor(sf::Color::Cyan); // Row i
-                if (c == m_j || r == m_k) m_matrixText[index].setFillColor(sf::Color::Cyan); // Col j
+    m_window->clear(sf::Color(30, 30, 30));
+    int block = m_engine->getBlock();
+    int blocks = m_engine->getBlockCount();
+    if (!m_matrixText.empty()) {
+        // Tile backgrounds behind the distances
+        float cellWidth = m_nodeCount > 1 ? m_matrixText[1].getPosition().x - m_matrixText[0].getPosition().x : 100.f;
+        float cellHeight = m_nodeCount > 1 ? m_matrixText[m_nodeCount].getPosition().y - m_matrixText[0].getPosition().y : 80.f;
+        for (int r = 0; r < blocks; ++r) {
+            for (int c = 0; c < blocks; ++c) {
+                int rows = min(block, m_nodeCount - r * block), cols = min(block, m_nodeCount - c * block);
+                sf::RectangleShape box(sf::Vector2f(cols * cellWidth - 8.f, rows * cellHeight - 8.f));
+                box.setPosition(292.f + c * block * cellWidth, 192.f + r * block * cellHeight);
+                box.setFillColor(sf::Color(45, 45, 45));
+                box.setOutlineThickness(2.f);
+                sf::Color color = m_useJohnson ? sf::Color::Transparent : getTileColor(r, c);
+                box.setOutlineColor(color == sf::Color::Transparent ? sf::Color(80, 80, 80) : color);
+                m_window->draw(box);
             }
-            if (m_isDone) m_matrixText[index].setFillColor(sf::Color::Green);
-            m_window.draw(m_matrixText[index]);
         }
+        for (int r = 0; r < m_nodeCount; ++r) {
+            for (int c = 0; c < m_nodeCount; ++c) {
+                int index = r * m_nodeCount + c;
+                int distance = getDistance(r, c);
+                m_matrixText[index].setString(distance == FloydWarshall::INF ? "inf" : to_string(distance));
+                sf::Color color = m_useJohnson ? getRowColor(r) : getTileColor(r / block, c / block);
+                m_matrixText[index].setFillColor(color == sf::Color::Transparent ? sf::Color::White : color);
+                m_window->draw(m_matrixText[index]);
+            }
+        }
+    } else {
+        sf::FloatRect area = getGraphArea();
+        float side = min(area.width, area.height);
+        float tileSide = side / blocks;
+        float boxSide = max(tileSide - 1.f, 1.f);
+        m_tiles.resize(static_cast<size_t>(blocks) * blocks * 4);
+        for (int r = 0; r < blocks; ++r) {
+            for (int c = 0; c < blocks; ++c) {
+                sf::Color color = m_useJohnson ? getRowColor(min(m_nodeCount, (r + 1) * block) - 1) : getTileColor(r, c);
+                if (color == sf::Color::Transparent) color = sf::Color(70, 70, 70);
+                float x = area.left + (area.width - side) / 2.f + c * tileSide, y = area.top + r * tileSide;
+                sf::Vertex* quad = &m_tiles[(static_cast<size_t>(r) * blocks + c) * 4];
+                quad[0].position = sf::Vector2f(x, y);
+                quad[1].position = sf::Vector2f(x + boxSide, y);
+                quad[2].position = sf::Vector2f(x + boxSide, y + boxSide);
+                quad[3].position = sf::Vector2f(x, y + boxSide);
+                quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+            }
+        }
+        m_window->draw(m_tiles);
     }
-    string status = m_isDone ? "Complete!" : "k=" + to_string(m_k);
-    sf::Text infoText("Floyd-Warshall | " + status, m_font, 20);
+
+    string status;
+    if (m_isDone) status = m_negativeCycle ? "Negative Cycle Detected!" : "Complete!";
+    else if (m_useJohnson) status = !m_reweighted ? "Next: Bellman-Ford reweighting" : "Sources " + to_string(m_nextSource) + "/" + to_string(m_nodeCount);
+    else status = string(m_replaying ? "Replay | " : "") + "Round " + to_string(m_round + 1) + "/" + to_string(blocks) + ": " + floydWarshallPhaseName(m_phase);
+    sf::Text infoText(string(m_useJohnson ? "Johnson" : "Floyd-Warshall") + " | " + status, m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    ostringstream run;
+    run << "J: " << (m_useJohnson ? "Johnson" : "blocked Floyd-Warshall") << " | " << m_nodeCount << " nodes, " << m_graph.getArcCount() << " arcs | ";
+    if (m_useJohnson) run << "Dijkstra from " << getBatchSize() << " source(s) per step";
+    else run << block << " x " << block << " tiles, " << FloydWarshall::getKernelName() << " kernel";
+    run << " | T threads: " << m_threads << " | " << fixed << setprecision(2) << m_runMs << " ms | S/L save/load";
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 38);
+    m_window->draw(runText);
 }
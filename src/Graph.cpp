@@ -0,0 +1,75 @@
+#include "Graph.h"
+#include <algorithm>
+
+using namespace std;
+
+Graph::Graph() : m_nodeCount(0), m_edgeCount(0), m_directed(true), m_offsets(1, 0) {}
+
+Graph::Graph(int nodeCount, const vector<GraphEdge>& edges, bool directed)
+    : m_nodeCount(nodeCount), m_edgeCount(edges.size()), m_directed(directed), m_offsets(nodeCount + 1, 0) {
+    // Counting sort by source: count degrees, prefix-sum them into offsets,
+    // then drop each arc into the next free slot of its source
+    for (const GraphEdge& edge : edges) {
+        m_offsets[edge.from + 1]++;
+        if (!directed) m_offsets[edge.to + 1]++;
+    }
+    for (int u = 0; u < nodeCount; ++u) m_offsets[u + 1] += m_offsets[u];
+
+    size_t arcs = m_offsets[nodeCount];
+    m_targets.resize(arcs);
+    m_weights.resize(arcs);
+    m_edgeIds.resize(arcs);
+
+    vector<size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+    auto place = [&](int from, int to, int weight, int id) {
+        size_t arc = next[from]++;
+        m_targets[arc] = to;
+        m_weights[arc] = weight;
+        m_edgeIds[arc] = id;
+    };
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const GraphEdge& edge = edges[i];
+        place(edge.from, edge.to, edge.weight, static_cast<int>(i));
+        if (!directed) place(edge.to, edge.from, edge.weight, static_cast<int>(i));
+    }
+}
+
+int Graph::getSource(size_t arc) const {
+    return static_cast<int>(upper_bound(m_offsets.begin(), m_offsets.end(), arc) - m_offsets.begin()) - 1;
+}
+
+Graph Graph::reversed() const {
+    if (!m_directed) return *this;
+    Graph reverse;
+    reverse.m_nodeCount = m_nodeCount;
+    reverse.m_edgeCount = m_edgeCount;
+    reverse.m_offsets.assign(m_nodeCount + 1, 0);
+    for (int target : m_targets) reverse.m_offsets[target + 1]++;
+    for (int u = 0; u < m_nodeCount; ++u) reverse.m_offsets[u + 1] += reverse.m_offsets[u];
+    reverse.m_targets.resize(m_targets.size());
+    reverse.m_weights.resize(m_weights.size());
+    reverse.m_edgeIds.resize(m_edgeIds.size());
+
+    vector<size_t> next(reverse.m_offsets.begin(), reverse.m_offsets.end() - 1);
+    for (int u = 0; u < m_nodeCount; ++u) {
+        for (size_t arc = arcBegin(u); arc < arcEnd(u); ++arc) {
+            size_t slot = next[m_targets[arc]]++;
+            reverse.m_targets[slot] = u;
+            reverse.m_weights[slot] = m_weights[arc];
+            reverse.m_edgeIds[slot] = m_edgeIds[arc];
+        }
+    }
+    return reverse;
+}
+
+int Graph::findEdgeId(int from, int to) const {
+    for (size_t arc = arcBegin(from); arc < arcEnd(from); ++arc) {
+        if (m_targets[arc] == to) return m_edgeIds[arc];
+    }
+    return -1;
+}
+
+size_t Graph::getMemoryBytes() const {
+    return m_offsets.capacity() * sizeof(size_t)
+         + (m_targets.capacity() + m_weights.capacity() + m_edgeIds.capacity()) * sizeof(int);
+}
@@ -0,0 +1,260 @@
+#include "GraphLoader.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+using namespace std;
+
+namespace {
+    const size_t CHUNK_BYTES = 1 << 20; // Text parsed per task
+
+    unique_ptr<GraphFile> g_workloadGraph;
+
+    // Edges parsed from one chunk of the file
+    struct ChunkResult {
+        vector<GraphEdge> edges;
+        int64_t maxNode = -1;
+        size_t errorOffset = SIZE_MAX; // File offset of the first bad line
+        string error;
+    };
+
+    // How the edge lines of a file are to be read, from its header
+    struct Layout {
+        size_t bodyStart = 0;
+        int64_t nodeCount = -1; // -1: one past the largest id seen
+        bool pattern = false;   // Matrix Market entries without a value
+    };
+
+    const char* skipSpaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p;
+    }
+
+    bool parseInteger(const char*& p, const char* end, int64_t& value) {
+        p = skipSpaces(p, end);
+        auto result = from_chars(p, end, value);
+        if (result.ec != errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+
+    bool parseWeight(const char*& p, const char* end, int& weight) {
+        p = skipSpaces(p, end);
+        double value;
+        auto result = from_chars(p, end, value);
+        if (result.ec != errc() || !(fabs(value) <= INT_MAX)) return false;
+        p = result.ptr;
+        weight = static_cast<int>(lround(value));
+        return true;
+    }
+
+    const char* lineEnd(const char* p, const char* end) {
+        const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+        return newline ? newline : end;
+    }
+
+    // Parses one line into `out`; blank and comment lines add nothing
+    bool parseLine(GraphFormat format, const Layout& layout, const char* p, const char* end, ChunkResult& out) {
+        p = skipSpaces(p, end);
+        if (p == end) return true;
+
+        int64_t base = 0; // Ids in the file that map to node 0
+        switch (format) {
+            case GraphFormat::EdgeList:
+                if (*p == '#' || *p == '%') return true;
+                break;
+            case GraphFormat::Dimacs:
+                if (*p == 'c' || *p == 'p') return true;
+                if (*p != 'a') {
+                    out.error = "expected an 'a' arc line";
+                    return false;
+                }
+                ++p;
+                base = 1;
+                break;
+            case GraphFormat::MatrixMarket:
+                if (*p == '%') return true;
+                base = 1;
+                break;
+        }
+
+        int64_t u, v;
+        int weight = 1;
+        if (!parseInteger(p, end, u) || !parseInteger(p, end, v)) {
+            out.error = "expected two node ids";
+            return false;
+        }
+        bool needsWeight = format == GraphFormat::Dimacs || (format == GraphFormat::MatrixMarket && !layout.pattern);
+        p = skipSpaces(p, end);
+        if ((needsWeight || p < end) && !parseWeight(p, end, weight)) {
+            out.error = "expected a weight";
+            return false;
+        }
+        u -= base;
+        v -= base;
+        if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX) {
+            out.error = "node id out of range";
+            return false;
+        }
+        out.edges.push_back({static_cast<int>(u), static_cast<int>(v), weight});
+        out.maxNode = max(out.maxNode, max(u, v));
+        return true;
+    }
+
+    // Reads the header lines that come before the edges
+    bool parseHeader(GraphFormat format, const char* begin, const char* end, Layout& layout, GraphFile& file, string& error) {
+        if (format == GraphFormat::EdgeList) return true;
+
+        const char* p = begin;
+        if (format == GraphFormat::Dimacs) {
+            // Comments, then "p <type> <nodes> <arcs>"
+            for (; p < end; p = lineEnd(p, end) + 1) {
+                const char* q = skipSpaces(p, end);
+                if (q == end || *q == '\n' || *q == 'c') continue;
+                if (*q != 'p') break;
+                q = skipSpaces(q + 1, end);
+                while (q < end && *q != ' ' && *q != '\t') ++q; // Problem type, e.g. "sp"
+                int64_t arcs;
+                if (!parseInteger(q, end, layout.nodeCount) || !parseInteger(q, end, arcs)) break;
+                file.edges.reserve(static_cast<size_t>(clamp<int64_t>(arcs, 0, (end - begin) / 4))); // A line takes 4+ bytes
+                layout.bodyStart = lineEnd(p, end) + 1 - begin;
+                return true;
+            }
+            error = "missing 'p' problem line";
+            return false;
+        }
+
+        // "%%MatrixMarket matrix coordinate <field> <symmetry>"
+        const char* bannerEnd = lineEnd(p, end);
+        string banner(p, bannerEnd);
+        transform(banner.begin(), banner.end(), banner.begin(), [](unsigned char c) { return tolower(c); });
+        if (banner.rfind("%%matrixmarket matrix coordinate", 0) != 0) {
+            error = "not a Matrix Market coordinate file";
+            return false;
+        }
+        if (banner.find("complex") != string::npos) {
+            error = "complex matrices are not supported";
+            return false;
+        }
+        layout.pattern = banner.find("pattern") != string::npos;
+        file.directed = banner.find("general") != string::npos;
+
+        // Comments, then "<rows> <columns> <entries>"
+        for (p = bannerEnd + 1; p < end; p = lineEnd(p, end) + 1) {
+            const char* q = skipSpaces(p, end);
+            if (q == end || *q == '\n' || *q == '%') continue;
+            int64_t rows, columns, entries;
+            if (!parseInteger(q, end, rows) || !parseInteger(q, end, columns) || !parseInteger(q, end, entries)) break;
+            layout.nodeCount = max(rows, columns);
+            file.edges.reserve(static_cast<size_t>(clamp<int64_t>(entries, 0, (end - begin) / 4)));
+            layout.bodyStart = lineEnd(p, end) + 1 - begin;
+            return true;
+        }
+        error = "missing size line";
+        return false;
+    }
+}
+
+GraphFormat graphFormatForPath(const string& path) {
+    auto endsWith = [&](const string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".gr")) return GraphFormat::Dimacs;
+    if (endsWith(".mtx")) return GraphFormat::MatrixMarket;
+    return GraphFormat::EdgeList;
+}
+
+bool loadGraphFile(const string& path, GraphFile& file) {
+    auto startTime = chrono::steady_clock::now();
+    MappedFile mapped;
+    if (!mapped.open(path)) return false;
+    const char* begin = reinterpret_cast<const char*>(mapped.data());
+    const char* end = begin + mapped.size();
+
+    file = GraphFile();
+    file.path = path;
+    file.format = graphFormatForPath(path);
+
+    Layout layout;
+    string error;
+    if (!parseHeader(file.format, begin, end, layout, file, error)) {
+        cerr << "Error loading graph '" << path << "': " << error << endl;
+        return false;
+    }
+
+    // Each chunk parses the lines that start inside it
+    size_t bodySize = mapped.size() - min(layout.bodyStart, mapped.size());
+    size_t chunkCount = (bodySize + CHUNK_BYTES - 1) / CHUNK_BYTES;
+    vector<ChunkResult> chunks(chunkCount);
+    ThreadPool::getInstance().parallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            const char* chunkBegin = begin + layout.bodyStart + c * CHUNK_BYTES;
+            const char* chunkEnd = min(chunkBegin + CHUNK_BYTES, end);
+            const char* p = chunkBegin;
+            if (c > 0 && p[-1] != '\n') p = lineEnd(p, end) + 1; // That line belongs to the previous chunk
+            ChunkResult& result = chunks[c];
+            while (p < chunkEnd) {
+                const char* eol = lineEnd(p, end);
+                if (!parseLine(file.format, layout, p, eol, result)) {
+                    result.errorOffset = p - begin;
+                    break;
+                }
+                p = eol + 1;
+            }
+        }
+    });
+
+    int64_t maxNode = -1;
+    vector<size_t> firstEdge(chunkCount + 1, 0);
+    for (size_t c = 0; c < chunkCount; ++c) {
+        if (chunks[c].errorOffset != SIZE_MAX) {
+            size_t line = 1 + count(begin, begin + chunks[c].errorOffset, '\n');
+            cerr << "Error loading graph '" << path << "', line " << line << ": " << chunks[c].error << endl;
+            return false;
+        }
+        maxNode = max(maxNode, chunks[c].maxNode);
+        firstEdge[c + 1] = firstEdge[c] + chunks[c].edges.size();
+    }
+
+    int64_t nodeCount = layout.nodeCount >= 0 ? layout.nodeCount : maxNode + 1;
+    if (maxNode >= nodeCount) {
+        cerr << "Error loading graph '" << path << "': node " << maxNode + 1 << " exceeds the declared " << nodeCount << " nodes" << endl;
+        return false;
+    }
+    if (nodeCount <= 0 || nodeCount > INT_MAX) {
+        cerr << "Error loading graph '" << path << "': " << (nodeCount <= 0 ? "no nodes" : "too many nodes") << endl;
+        return false;
+    }
+    file.nodeCount = static_cast<int>(nodeCount);
+
+    file.edges.resize(firstEdge[chunkCount]);
+    ThreadPool::getInstance().parallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            copy(chunks[c].edges.begin(), chunks[c].edges.end(), file.edges.begin() + firstEdge[c]);
+            vector<GraphEdge>().swap(chunks[c].edges);
+        }
+    });
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    cout << "Loaded graph '" << path << "': " << file.nodeCount << " nodes, " << file.edges.size()
+         << (file.directed ? " directed" : " undirected") << " edges in " << ms << " ms" << endl;
+    return true;
+}
+
+const GraphFile* getWorkloadGraph() {
+    return g_workloadGraph.get();
+}
+
+bool setWorkloadGraph(const string& path) {
+    auto file = make_unique<GraphFile>();
+    if (!loadGraphFile(path, *file)) return false;
+    g_workloadGraph = move(file);
+    return true;
+}
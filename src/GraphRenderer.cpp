@@ -0,0 +1,242 @@
+#include "GraphRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+    const unsigned DISC_TEXTURE_SIZE = 64;
+    const size_t MIN_LABEL_CAPACITY = 4; // Glyphs reserved per label, so short labels can grow in place
+
+    void setQuad(sf::Vertex* quad, sf::FloatRect rect, sf::FloatRect texture, sf::Color color) {
+        quad[0] = sf::Vertex({rect.left, rect.top}, color, {texture.left, texture.top});
+        quad[1] = sf::Vertex({rect.left + rect.width, rect.top}, color, {texture.left + texture.width, texture.top});
+        quad[2] = sf::Vertex({rect.left + rect.width, rect.top + rect.height}, color,
+                             {texture.left + texture.width, texture.top + texture.height});
+        quad[3] = sf::Vertex({rect.left, rect.top + rect.height}, color, {texture.left, texture.top + texture.height});
+    }
+}
+
+// --- Batch ---
+
+GraphRenderer::Batch::Batch(sf::PrimitiveType type, size_t stride)
+    : m_type(type), m_stride(stride), m_buffer(type, sf::VertexBuffer::Dynamic), m_allDirty(true) {}
+
+void GraphRenderer::Batch::clear() {
+    m_vertices.clear();
+    m_dirty.clear();
+    m_isDirty.clear();
+    m_allDirty = true;
+}
+
+size_t GraphRenderer::Batch::add(size_t count) {
+    size_t first = size();
+    m_vertices.resize(m_vertices.size() + count * m_stride);
+    m_isDirty.resize(size(), 0);
+    m_allDirty = true; // The buffer has to grow anyway
+    return first;
+}
+
+void GraphRenderer::Batch::markDirty(size_t index) {
+    if (m_allDirty || m_isDirty[index]) return;
+    // Past a quarter of the elements a single full upload is cheaper
+    if (m_dirty.size() * 4 >= size()) {
+        m_allDirty = true;
+        return;
+    }
+    m_isDirty[index] = 1;
+    m_dirty.push_back(index);
+}
+
+void GraphRenderer::Batch::draw(sf::RenderTarget& target, const sf::RenderStates& states) {
+    if (m_vertices.empty()) return;
+    if (!sf::VertexBuffer::isAvailable()) {
+        target.draw(m_vertices.data(), m_vertices.size(), m_type, states);
+        return;
+    }
+
+    if (m_allDirty) {
+        if (m_buffer.getVertexCount() != m_vertices.size()) m_buffer.create(m_vertices.size());
+        m_buffer.update(m_vertices.data());
+        m_allDirty = false;
+    } else {
+        for (size_t index : m_dirty) {
+            m_buffer.update(&m_vertices[index * m_stride], m_stride, static_cast<unsigned>(index * m_stride));
+        }
+    }
+    for (size_t index : m_dirty) m_isDirty[index] = 0;
+    m_dirty.clear();
+    target.draw(m_buffer, states);
+}
+
+// --- GraphRenderer ---
+
+GraphRenderer::GraphRenderer()
+    : m_radius(30.f), m_outlineThickness(0.f), m_outlineColor(sf::Color::White),
+      m_edges(sf::Lines, 2), m_nodes(sf::Quads, 8), m_hasDiscTexture(false) {}
+
+void GraphRenderer::clear() {
+    m_nodePositions.clear();
+    m_nodeColors.clear();
+    m_edgeColors.clear();
+    m_labels.clear();
+    m_dirtyLabels.clear();
+    m_edges.clear();
+    m_nodes.clear();
+    m_glyphs.clear();
+}
+
+void GraphRenderer::setNodeStyle(float radius, float outlineThickness, sf::Color outlineColor) {
+    m_radius = radius;
+    m_outlineThickness = outlineThickness;
+    m_outlineColor = outlineColor;
+}
+
+int GraphRenderer::addNode(sf::Vector2f position, sf::Color color) {
+    size_t node = m_nodes.add();
+    m_nodePositions.push_back(position);
+    m_nodeColors.push_back(color);
+
+    const float t = static_cast<float>(DISC_TEXTURE_SIZE);
+    const sf::FloatRect texture(0.f, 0.f, t, t);
+    float outer = m_radius + m_outlineThickness;
+    sf::Color outline = m_outlineThickness > 0.f ? m_outlineColor : sf::Color::Transparent;
+    setQuad(m_nodes.element(node), {position.x - outer, position.y - outer, 2 * outer, 2 * outer}, texture, outline);
+    setQuad(m_nodes.element(node) + 4, {position.x - m_radius, position.y - m_radius, 2 * m_radius, 2 * m_radius}, texture, color);
+    return static_cast<int>(node);
+}
+
+int GraphRenderer::addEdge(int from, int to, sf::Color color) {
+    size_t edge = m_edges.add();
+    m_edgeColors.push_back(color);
+    sf::Vertex* line = m_edges.element(edge);
+    line[0] = sf::Vertex(m_nodePositions[from], color);
+    line[1] = sf::Vertex(m_nodePositions[to], color);
+    return static_cast<int>(edge);
+}
+
+int GraphRenderer::addLabel(sf::Vector2f position, const string& text, unsigned characterSize, sf::Color color, bool centered) {
+    Batch& glyphs = m_glyphs.emplace(characterSize, Batch(sf::Quads, 4)).first->second;
+    size_t capacity = max(text.size(), MIN_LABEL_CAPACITY);
+    m_labels.push_back({position, text, characterSize, color, centered, glyphs.add(capacity), capacity, true});
+    m_dirtyLabels.push_back(m_labels.size() - 1);
+    return static_cast<int>(m_labels.size() - 1);
+}
+
+void GraphRenderer::addGraph(int nodeCount, const vector<GraphEdge>& edges, sf::FloatRect area, bool weightLabels,
+                             sf::Color nodeColor, sf::Color labelColor) {
+    int columns = max(1, static_cast<int>(ceil(sqrt(nodeCount * area.width / area.height))));
+    int rows = (nodeCount + columns - 1) / columns;
+    sf::Vector2f cell(area.width / columns, area.height / max(rows, 1));
+    bool labelled = nodeCount <= MAX_LABELLED_NODES;
+    setNodeStyle(clamp(min(cell.x, cell.y) * 0.3f, 1.f, 30.f), m_outlineThickness, m_outlineColor);
+
+    for (int u = 0; u < nodeCount; ++u) {
+        sf::Vector2f position(area.left + (u % columns + 0.5f) * cell.x, area.top + (u / columns + 0.5f) * cell.y);
+        addNode(position, nodeColor);
+        if (labelled) addLabel(position, to_string(u), static_cast<unsigned>(min(24.f, m_radius)), labelColor);
+    }
+    for (const GraphEdge& edge : edges) addEdge(edge.from, edge.to);
+    if (weightLabels && labelled && edges.size() <= MAX_LABELLED_EDGES) {
+        for (const GraphEdge& edge : edges) {
+            sf::Vector2f middle = (m_nodePositions[edge.from] + m_nodePositions[edge.to]) / 2.f;
+            addLabel(middle, to_string(edge.weight), 16, sf::Color::White, false);
+        }
+    }
+}
+
+void GraphRenderer::setNodeColor(int node, sf::Color color) {
+    if (m_nodeColors[node] == color) return;
+    m_nodeColors[node] = color;
+    sf::Vertex* fill = m_nodes.element(node) + 4;
+    for (int k = 0; k < 4; ++k) fill[k].color = color;
+    m_nodes.markDirty(node);
+}
+
+void GraphRenderer::setEdgeColor(int edge, sf::Color color) {
+    if (m_edgeColors[edge] == color) return;
+    m_edgeColors[edge] = color;
+    sf::Vertex* line = m_edges.element(edge);
+    line[0].color = line[1].color = color;
+    m_edges.markDirty(edge);
+}
+
+void GraphRenderer::setLabelText(int index, const string& text) {
+    Label& label = m_labels[index];
+    if (label.text == text) return;
+    label.text = text;
+    if (text.size() > label.capacity) {
+        // Outgrew its slot: blank the old glyphs and move to the end of the batch
+        Batch& glyphs = m_glyphs.at(label.characterSize);
+        for (size_t k = 0; k < label.capacity; ++k) {
+            fill(glyphs.element(label.first + k), glyphs.element(label.first + k) + 4, sf::Vertex());
+            glyphs.markDirty(label.first + k);
+        }
+        label.capacity = text.size() * 2;
+        label.first = glyphs.add(label.capacity);
+    }
+    if (!label.dirty) {
+        label.dirty = true;
+        m_dirtyLabels.push_back(index);
+    }
+}
+
+void GraphRenderer::createDiscTexture() {
+    // An anti-aliased white disc; vertex colors tint it per node
+    sf::Image image;
+    image.create(DISC_TEXTURE_SIZE, DISC_TEXTURE_SIZE, sf::Color::Transparent);
+    const float center = DISC_TEXTURE_SIZE / 2.f;
+    for (unsigned y = 0; y < DISC_TEXTURE_SIZE; ++y) {
+        for (unsigned x = 0; x < DISC_TEXTURE_SIZE; ++x) {
+            float distance = hypot(x + 0.5f - center, y + 0.5f - center);
+            float coverage = clamp(center - distance, 0.f, 1.f);
+            image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(coverage * 255)));
+        }
+    }
+    m_discTexture.loadFromImage(image);
+    m_discTexture.setSmooth(true);
+    m_hasDiscTexture = true;
+}
+
+// Writes the glyph quads of a label; needs the font's glyphs, so only runs while drawing
+void GraphRenderer::layoutLabel(Label& label, const sf::Font& font) {
+    Batch& glyphs = m_glyphs.at(label.characterSize);
+
+    float width = 0.f;
+    for (size_t k = 0; k < label.text.size(); ++k) {
+        if (k > 0) width += font.getKerning(label.text[k - 1], label.text[k], label.characterSize);
+        width += font.getGlyph(label.text[k], label.characterSize, false).advance;
+    }
+    // Centered labels sit on the middle of a digit's height, like centerOrigin()
+    float x = label.centered ? label.position.x - width / 2.f : label.position.x;
+    float baseline = label.position.y + label.characterSize * (label.centered ? 0.36f : 1.f);
+
+    for (size_t k = 0; k < label.capacity; ++k) {
+        sf::Vertex* quad = glyphs.element(label.first + k);
+        if (k < label.text.size()) {
+            if (k > 0) x += font.getKerning(label.text[k - 1], label.text[k], label.characterSize);
+            const sf::Glyph& glyph = font.getGlyph(label.text[k], label.characterSize, false);
+            sf::FloatRect texture(static_cast<float>(glyph.textureRect.left), static_cast<float>(glyph.textureRect.top),
+                                  static_cast<float>(glyph.textureRect.width), static_cast<float>(glyph.textureRect.height));
+            setQuad(quad, {x + glyph.bounds.left, baseline + glyph.bounds.top, glyph.bounds.width, glyph.bounds.height},
+                    texture, label.color);
+            x += glyph.advance;
+        } else {
+            fill(quad, quad + 4, sf::Vertex()); // Unused capacity
+        }
+        glyphs.markDirty(label.first + k);
+    }
+    label.dirty = false;
+}
+
+void GraphRenderer::draw(sf::RenderTarget& target, const sf::Font& font) {
+    if (!m_hasDiscTexture) createDiscTexture();
+    for (size_t index : m_dirtyLabels) layoutLabel(m_labels[index], font);
+    m_dirtyLabels.clear();
+
+    m_edges.draw(target, sf::RenderStates::Default);
+    m_nodes.draw(target, sf::RenderStates(&m_discTexture));
+    for (auto& [size, glyphs] : m_glyphs) {
+        glyphs.draw(target, sf::RenderStates(&font.getTexture(size)));
+    }
+}
@@ -1,20 +1,29 @@
 #include "GraphVisualizer.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iomanip>
 #include <iostream>
-#include <algorithm> // for std::reverse
+#include <sstream>
 
 using namespace std;
 
-GraphVisualizer::GraphVisualizer(sf::RenderWindow& window, TraversalType type)
-    : Visualizer(window), m_traversalType(type), m_isVisualizing(false), m_isDone(false), m_componentCheckIndex(0) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) {
-        cerr << "Error loading font in GraphVisualizer" << endl;
-    }
+GraphVisualizer::GraphVisualizer(sf::RenderWindow* window, TraversalType type)
+    : Visualizer(window), m_traversalType(type), m_bfsMode(BfsMode::DirectionOptimizing),
+      m_threads(ThreadPool::getInstance().getThreadCount()), m_colorByWorker(false), m_engineMs(0.0), m_engineInspected(0),
+      m_topDownInspected(0), m_isVisualizing(false), m_isDone(false), m_componentCheckIndex(0) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.5); // One step every 0.5s by default
     m_traversalName = (type == TraversalType::DFS) ? "DFS" : "BFS";
 }
 
 void GraphVisualizer::buildGraph() {
-    m_adjList.clear();
-    m_edges.clear();
+    m_renderer.clear();
+    m_renderer.setNodeStyle(30.f, 2.f, sf::Color::White);
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), false, sf::Color(100, 100, 250));
+        m_graph = Graph(file->nodeCount, file->edges, file->directed);
+        return;
+    }
     
     // --- Component 1 ---
     map<int, sf::Vector2f> positions;
@@ -29,33 +38,16 @@ void GraphVisualizer::buildGraph() {
     positions[6] = {1000, 600};
 
 
+    // Keys are 0..n-1 in order, so renderer indices match the node ids
     for(const auto& pair : positions){
-        Node node;
-        node.shape.setRadius(30.f);
-        node.shape.setOrigin(node.shape.getRadius(), node.shape.getRadius());
-        node.shape.setPosition(pair.second);
-        node.shape.setOutlineThickness(2.f);
-        node.shape.setOutlineColor(sf::Color::White);
-
-        node.label.setFont(m_font);
-        node.label.setString(to_string(pair.first));
-        node.label.setCharacterSize(24);
-        node.label.setFillColor(sf::Color::White);
-        sf::FloatRect textRect = node.label.getLocalBounds();
-        node.label.setOrigin(textRect.left + textRect.width/2.0f, textRect.top + textRect.height/2.0f);
-        node.label.setPosition(pair.second);
-        
-        m_adjList[pair.first] = node;
+        m_renderer.addNode(pair.second, sf::Color(100, 100, 250));
+        m_renderer.addLabel(pair.second, to_string(pair.first), 24);
     }
 
+    vector<GraphEdge> edges;
     auto addEdge = [&](int u, int v) {
-        m_adjList[u].adj.push_back(v);
-        sf::VertexArray line(sf::Lines, 2);
-        line[0].position = m_adjList[u].shape.getPosition();
-        line[0].color = sf::Color::White;
-        line[1].position = m_adjList[v].shape.getPosition();
-        line[1].color = sf::Color::White;
-        m_edges.push_back(line);
+        edges.push_back({u, v, 1});
+        m_renderer.addEdge(u, v);
     };
 
     // Edges for Component 1
@@ -67,25 +59,50 @@ void GraphVisualizer::buildGraph() {
     // Edges for Component 2
     addEdge(4, 5);
     addEdge(4, 6);
+
+    m_graph = Graph(positions.size(), edges, true);
 }
 
 void GraphVisualizer::resetNodeStates() {
-    for (auto& pair : m_adjList) {
-        pair.second.state = Node::State::Unvisited;
-    }
+    m_states.assign(m_graph.getNodeCount(), NodeState::Unvisited);
+    m_bottomUp.assign(m_graph.getNodeCount(), false);
+}
+
+// Times a full BFS in the chosen mode and counts a top-down one's arcs
+void GraphVisualizer::runEngine() {
+    BreadthFirstSearch topDown(m_graph);
+    topDown.setMode(BfsMode::TopDown);
+    topDown.run();
+    m_topDownInspected = topDown.getStats().inspected;
+
+    m_bfs = make_unique<BreadthFirstSearch>(m_graph);
+    m_bfs->setMode(m_bfsMode);
+    m_bfs->setThreads(m_threads);
+    auto startTime = chrono::steady_clock::now();
+    m_bfs->run();
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_engineInspected = m_bfs->getStats().inspected;
+    cout << "BFS (" << bfsModeName(m_bfsMode) << ", " << m_threads << " threads): " << m_engineMs << " ms, " << m_bfs->getStats().levels << " levels ("
+         << m_bfs->getStats().bottomUpLevels << " bottom-up), " << m_engineInspected << " arcs inspected, top-down: "
+         << m_topDownInspected << ", " << (m_engineMs > 0 ? m_graph.getEdgeCount() / (m_engineMs / 1000.0) : 0.0) << " edges/s." << endl;
+    m_bfs->clear();
 }
 
 // Finds the next unvisited node and starts a traversal from it.
 // Returns true if a new traversal was started, false otherwise.
 bool GraphVisualizer::startNextTraversal() {
-    for (int i = m_componentCheckIndex; i < m_adjList.size(); ++i) {
-        if (m_adjList[i].state == Node::State::Unvisited) {
-            if (m_traversalType == TraversalType::DFS) {
-                m_dfsStack.push(i);
-            } else {
-                m_bfsQueue.push(i);
-            }
-            m_adjList[i].state = Node::State::Visiting;
+    if (m_traversalType == TraversalType::BFS) {
+        int source = m_bfs->findUnvisited(m_componentCheckIndex);
+        if (source < 0) return false;
+        m_bfs->start(source);
+        m_states[source] = NodeState::Visiting;
+        m_componentCheckIndex = source + 1;
+        return true;
+    }
+    for (int i = m_componentCheckIndex; i < m_graph.getNodeCount(); ++i) {
+        if (m_states[i] == NodeState::Unvisited) {
+            m_dfsStack.push(i);
+            m_states[i] = NodeState::Visiting;
             m_componentCheckIndex = i + 1;
             return true;
         }
@@ -96,9 +113,9 @@ bool GraphVisualizer::startNextTraversal() {
 void GraphVisualizer::reset() {
     buildGraph();
     resetNodeStates();
+    if (m_traversalType == TraversalType::BFS) runEngine();
     
     while(!m_dfsStack.empty()) m_dfsStack.pop();
-    while(!m_bfsQueue.empty()) m_bfsQueue.pop();
 
     m_isVisualizing = false;
     m_isDone = false;
@@ -109,6 +126,10 @@ void GraphVisualizer::reset() {
     cout << "Graph " << m_traversalName << " Visualizer reset. Press SPACE to start." << endl;
 }
 
+void GraphVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
 void GraphVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) {
@@ -117,14 +138,24 @@ void GraphVisualizer::handleEvent(sf::Event& event) {
         if (event.key.code == sf::Keyboard::R) {
             reset();
         }
+        if (event.key.code == sf::Keyboard::M && m_traversalType == TraversalType::BFS) {
+            m_bfsMode = static_cast<BfsMode>((static_cast<int>(m_bfsMode) + 1) % size(ALL_BFS_MODES));
+            reset();
+        }
+        if (event.key.code == sf::Keyboard::T && m_traversalType == TraversalType::BFS) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            reset();
+        }
+        if (event.key.code == sf::Keyboard::W && m_traversalType == TraversalType::BFS) {
+            m_colorByWorker = !m_colorByWorker;
+        }
     }
 }
 
-void GraphVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) {
-        return;
+bool GraphVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) {
+        return false;
     }
-    m_clock.restart();
 
     if (m_traversalType == TraversalType::DFS) {
         if (m_dfsStack.empty()) {
@@ -134,63 +165,65 @@ void GraphVisualizer::update() {
                 m_isVisualizing = false;
                 cout << "DFS traversal complete!" << endl;
             }
-            return;
+            return true;
         }
         int u = m_dfsStack.top();
         m_dfsStack.pop();
-        m_adjList[u].state = Node::State::Visited;
+        m_states[u] = NodeState::Visited;
 
-        vector<int> neighbors = m_adjList[u].adj;
-        reverse(neighbors.begin(), neighbors.end());
-
-        for (int v : neighbors) {
-            if (m_adjList[v].state == Node::State::Unvisited) {
-                m_adjList[v].state = Node::State::Visiting;
+        // Push in reverse so the first neighbour is popped first
+        for (size_t arc = m_graph.arcEnd(u); arc-- > m_graph.arcBegin(u);) {
+            int v = m_graph.getTarget(arc);
+            if (m_states[v] == NodeState::Unvisited) {
+                m_states[v] = NodeState::Visiting;
                 m_dfsStack.push(v);
             }
         }
     } 
     else // BFS
     {
-        if (m_bfsQueue.empty()) {
-            // Current component is done, look for the next one
-            if (!startNextTraversal()) {
-                m_isDone = true;
-                m_isVisualizing = false;
-                cout << "BFS traversal complete!" << endl;
-            }
-            return;
-        }
-        int u = m_bfsQueue.front();
-        m_bfsQueue.pop();
-        m_adjList[u].state = Node::State::Visited;
-        
-        for (int v : m_adjList[u].adj) {
-            if (m_adjList[v].state == Node::State::Unvisited) {
-                m_adjList[v].state = Node::State::Visiting;
-                m_bfsQueue.push(v);
-            }
+        return stepBfs();
+    }
+    return true;
+}
+
+// Expands one whole level, then moves on to the next component
+bool GraphVisualizer::stepBfs() {
+    if (!m_bfs->stepLevel()) {
+        if (!startNextTraversal()) {
+            m_isDone = true;
+            m_isVisualizing = false;
+            cout << "BFS traversal complete!" << endl;
         }
+        return true;
+    }
+    bool bottomUp = m_bfs->getLevels().back().direction == BfsDirection::BottomUp;
+    for (int v : m_bfs->getPreviousFrontier()) m_states[v] = NodeState::Visited;
+    for (int v : m_bfs->getFrontier()) {
+        m_states[v] = NodeState::Visiting;
+        m_bottomUp[v] = bottomUp;
     }
+    return true;
 }
 
 void GraphVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
+    m_window->clear(sf::Color(30, 30, 30));
 
-    for (const auto& edge : m_edges) {
-        m_window.draw(edge);
-    }
-
-    for (auto& pair : m_adjList) {
-        Node& node = pair.second;
-        switch (node.state) {
-            case Node::State::Unvisited: node.shape.setFillColor(sf::Color(100, 100, 250)); break;
-            case Node::State::Visiting:  node.shape.setFillColor(sf::Color::Yellow); break;
-            case Node::State::Visited:   node.shape.setFillColor(sf::Color::Green); break;
+    static const sf::Color workerColors[] = {
+        {240, 90, 90}, {90, 200, 90}, {240, 170, 60}, {190, 110, 240},
+        {60, 200, 210}, {240, 120, 200}, {200, 200, 90}, {140, 160, 240}
+    };
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        switch (m_states[u]) {
+            case NodeState::Unvisited: m_renderer.setNodeColor(u, sf::Color(100, 100, 250)); break;
+            case NodeState::Visiting:  m_renderer.setNodeColor(u, sf::Color::Yellow); break;
+            case NodeState::Visited:
+                if (m_colorByWorker) m_renderer.setNodeColor(u, workerColors[m_bfs->getWorker(u) % size(workerColors)]);
+                else m_renderer.setNodeColor(u, m_bottomUp[u] ? sf::Color(0, 200, 220) : sf::Color::Green);
+                break;
         }
-        m_window.draw(node.shape);
-        m_window.draw(node.label);
     }
+    m_renderer.draw(*m_window, m_font);
     
     sf::Text infoText;
     infoText.setFont(m_font);
@@ -200,5 +233,29 @@ void GraphVisualizer::draw() {
     string status = m_isDone ? "Complete!" : (m_isVisualizing ? "Visualizing..." : "Paused.");
     infoText.setString("Graph " + m_traversalName + " | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    if (m_traversalType != TraversalType::BFS) return;
+    ostringstream controls;
+    controls << "M: " << bfsModeName(m_bfsMode) << " | T threads: " << m_threads << " | W colours: "
+             << (m_colorByWorker ? "worker" : "direction (green top-down, cyan bottom-up)");
+    const vector<BfsLevel>& levels = m_bfs->getLevels();
+    ostringstream level;
+    if (!levels.empty()) {
+        const BfsLevel& last = levels.back();
+        level << "Level " << last.depth << ": " << (last.direction == BfsDirection::TopDown ? "top-down" : "bottom-up")
+              << ", " << last.frontier << " expanded, " << last.discovered << " reached, " << last.inspected << " arcs";
+    }
+    double edgesPerSecond = m_engineMs > 0 ? m_graph.getEdgeCount() / (m_engineMs / 1000.0) : 0.0;
+    ostringstream run;
+    run << "Full run: " << fixed << setprecision(2) << m_engineMs << " ms, " << edgesPerSecond / 1e6
+        << " M edges/s, " << m_engineInspected << " arcs inspected (top-down: " << m_topDownInspected << ")";
+
+    const string lines[] = { controls.str(), run.str(), level.str() };
+    for (int i = 0; i < 3; ++i) {
+        sf::Text text(lines[i], m_font, 18);
+        text.setFillColor(sf::Color(200, 200, 200));
+        text.setPosition(10, 38 + 24 * i);
+        m_window->draw(text);
+    }
 }
@@ -0,0 +1,128 @@
+#include "HeadlessRunner.h"
+#include "CommandLine.h"
+#include "DataGenerator.h"
+#include "GraphLoader.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    // Silences std::cout (the visualizers' progress messages) while alive
+    class ScopedSilence {
+    private:
+        streambuf* m_saved;
+        ostringstream m_sink;
+    public:
+        explicit ScopedSilence(bool enabled) : m_saved(nullptr) {
+            if (enabled) m_saved = cout.rdbuf(m_sink.rdbuf());
+        }
+        ~ScopedSilence() {
+            if (m_saved) cout.rdbuf(m_saved);
+        }
+    };
+
+    struct RunResult {
+        unsigned long long steps = 0;
+        double seconds = 0.0;
+        bool finished = true;
+    };
+
+    RunResult runOnce(const VisualizerEntry& entry, unsigned long long maxSteps, bool verbose) {
+        RunResult result;
+        ScopedSilence silence(!verbose);
+
+        unique_ptr<Visualizer> visualizer = entry.factory(nullptr);
+        visualizer->reset();
+
+        auto begin = chrono::steady_clock::now();
+        visualizer->start();
+        while (visualizer->step()) {
+            if (++result.steps >= maxSteps) {
+                result.finished = false;
+                break;
+            }
+        }
+        result.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        return result;
+    }
+
+    void printUsage() {
+        cerr << "Usage: --headless [options]\n"
+                "  --filter <text>     only run entries whose name contains <text>\n"
+                "  --max-steps <n>     stop a run after n steps (default 1e9)\n"
+                "  --repeat <n>        run each entry n times and report the best time\n"
+                "  --seed <n>          seed for the generated inputs\n"
+                "  --graph <path>      run the graph visualizers on this file\n"
+                "  --verbose           keep the visualizers' own console messages\n"
+                "  --list              print the registered names and exit" << endl;
+    }
+}
+
+int runHeadless(const vector<VisualizerEntry>& registry, const vector<string>& args) {
+    string filter;
+    unsigned long long maxSteps = 1000000000ULL;
+    int repeat = 1;
+    unsigned long long seed = 0;
+    bool verbose = false;
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const string& arg = args[i];
+        bool hasValue = i + 1 < args.size();
+        bool valid = true;
+        if (arg == "--filter" && hasValue) filter = args[++i];
+        else if (arg == "--max-steps" && hasValue) valid = parseOption(arg, args[++i], maxSteps);
+        else if (arg == "--repeat" && hasValue) valid = parseOption(arg, args[++i], repeat);
+        else if (arg == "--seed" && hasValue) {
+            if ((valid = parseOption(arg, args[++i], seed))) setWorkloadSeed(seed);
+        }
+        else if (arg == "--graph" && hasValue) {
+            if (!setWorkloadGraph(args[++i])) return 1;
+        }
+        else if (arg == "--verbose") verbose = true;
+        else if (arg == "--list") {
+            for (const auto& entry : registry) {
+                cout << entry.name << (entry.factory ? "" : "  (interactive only)") << endl;
+            }
+            return 0;
+        } else {
+            cerr << "Unknown headless option '" << arg << "'" << endl;
+            valid = false;
+        }
+        if (!valid) {
+            printUsage();
+            return 1;
+        }
+    }
+    repeat = max(1, repeat);
+
+    getWorkloadSeed(); // Reports the seed before the visualizers use it
+    cout << left << setw(32) << "Visualizer" << right << setw(14) << "Steps"
+         << setw(14) << "Time (ms)" << setw(16) << "Steps/s" << endl;
+    int runCount = 0;
+    for (const auto& entry : registry) {
+        if (!filter.empty() && entry.name.find(filter) == string::npos) continue;
+        if (!entry.factory) continue; // Needs interactive input before it can run
+
+        RunResult best;
+        for (int r = 0; r < repeat; ++r) {
+            RunResult result = runOnce(entry, maxSteps, verbose);
+            if (r == 0 || result.seconds < best.seconds) best = result;
+        }
+        double stepsPerSecond = best.seconds > 0.0 ? best.steps / best.seconds : 0.0;
+        cout << left << setw(32) << entry.name << right << setw(14) << best.steps
+             << fixed << setprecision(3) << setw(14) << best.seconds * 1000.0
+             << setprecision(0) << setw(16) << stepsPerSecond
+             << (best.finished ? "" : "  (stopped at --max-steps)") << endl;
+        ++runCount;
+    }
+
+    if (runCount == 0) {
+        cerr << "No visualizer matched the filter '" << filter << "'" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,43 +1,34 @@
 #include "HeapSortVisualizer.h"
-#include <random>
 #include <algorithm>
 #include <iostream>
 
 using namespace std;
 
-HeapSortVisualizer::HeapSortVisualizer(sf::RenderWindow& window)
+HeapSortVisualizer::HeapSortVisualizer(sf::RenderWindow* window)
     : Visualizer(window), m_phase(Phase::IDLE), m_isSorting(false), m_isSorted(false) {}
 
-void HeapSortVisualizer::initializeData() {
-    m_data.clear();
-    int numElements = m_window.getSize().x / 8;
-    m_data.reserve(numElements);
-
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> distrib(10, m_window.getSize().y - 50);
-
-    for (int k = 0; k < numElements; ++k) {
-        m_data.push_back(distrib(gen));
-    }
-}
-
 void HeapSortVisualizer::reset() {
-    initializeData();
+    m_data = generateBarData(getCanvasSize().x / 8, 50);
     m_phase = Phase::IDLE;
     m_isSorting = false;
     m_isSorted = false;
     cout << "Heap Sort Visualizer reset. Press SPACE to start sorting." << endl;
 }
 
+void HeapSortVisualizer::start() {
+    if (m_isSorted) return;
+    m_isSorting = true;
+    if (m_phase == Phase::IDLE) {
+        m_phase = Phase::BUILDING;
+        m_heapifyIndex = m_data.size() / 2 - 1;
+    }
+}
+
 void HeapSortVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isSorted) {
-            m_isSorting = !m_isSorting;
-            if (m_isSorting && m_phase == Phase::IDLE) {
-                m_phase = Phase::BUILDING;
-                m_heapifyIndex = m_data.size() / 2 - 1;
-            }
+            if (m_isSorting) m_isSorting = false;
+            else start();
         }
         if (event.key.code == sf::Keyboard::R) {
             reset();
@@ -53,8 +44,8 @@ void HeapSortVisualizer::startHeapify(int n, int i) {
     // The actual heapify logic is in update()
 }
 
-void HeapSortVisualizer::update() {
-    if (!m_isSorting || m_isSorted) return;
+bool HeapSortVisualizer::step() {
+    if (!m_isSorting || m_isSorted) return false;
 
     if (m_phase == Phase::BUILDING) {
         if (m_heapifyIndex >= 0) {
@@ -91,38 +82,31 @@ void HeapSortVisualizer::update() {
             m_phase = (m_heapifyIndex >= 0) ? Phase::BUILDING : Phase::SORTING;
         }
     }
+    return true;
 }
 
 void HeapSortVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-
-    float barWidth = static_cast<float>(m_window.getSize().x) / m_data.size();
-    sf::Font font;
-    font.loadFromFile("assets/arial.ttf");
-
-    for (size_t k = 0; k < m_data.size(); ++k) {
-        sf::RectangleShape bar;
-        bar.setSize(sf::Vector2f(barWidth - 1, m_data[k]));
-        bar.setPosition(k * barWidth, m_window.getSize().y - m_data[k]);
+    m_window->clear(sf::Color(30, 30, 30));
 
+    m_bars.update(m_data, getCanvasSize(), [&](size_t k) {
         if (m_isSorted) {
-            bar.setFillColor(sf::Color::Green);
+            return sf::Color::Green;
         } else if (m_phase == Phase::HEAPIFYING && (k == (size_t)m_heapifyRoot || k == (size_t)m_heapifyLargest)) {
-            bar.setFillColor(sf::Color::Red);
+            return sf::Color::Red;
         } else if (m_phase == Phase::SORTING && k >= (size_t)m_heapSize) {
-            bar.setFillColor(sf::Color(100, 255, 100)); // Sorted portion
+            return sf::Color(100, 255, 100); // Sorted portion
         } else {
-            bar.setFillColor(sf::Color::Cyan);
+            return sf::Color::Cyan;
         }
-        m_window.draw(bar);
-    }
+    });
+    m_bars.draw(*m_window);
 
     sf::Text infoText;
-    infoText.setFont(font);
+    infoText.setFont(m_font);
     infoText.setCharacterSize(20);
     infoText.setFillColor(sf::Color::White);
     string status = m_isSorted ? "Sorted!" : (m_isSorting ? "Sorting..." : "Paused.");
     infoText.setString("Heap Sort | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
 }
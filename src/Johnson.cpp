@@ -0,0 +1,88 @@
+#include "Johnson.h"
+#include "BellmanFord.h"
+#include "FloydWarshall.h"
+#include "PriorityQueues.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+Johnson::Johnson(const Graph& graph)
+    : m_graph(graph), m_potential(graph.getNodeCount(), 0),
+      m_distances(static_cast<size_t>(graph.getNodeCount()) * graph.getNodeCount(), FloydWarshall::INF) {}
+
+bool Johnson::reweight() {
+    int n = m_graph.getNodeCount();
+    m_potential.assign(n, 0);
+    m_cycle.clear();
+    m_stats = JohnsonStats();
+    bool negative = false;
+    for (size_t arc = 0; arc < m_graph.getArcCount() && !negative; ++arc) negative = m_graph.getWeight(arc) < 0;
+    if (!negative) return true;
+
+    // The arcs in CSR order, then one from the virtual source n to every
+    // node; the original arcs keep their indices
+    vector<GraphEdge> edges;
+    edges.reserve(m_graph.getArcCount() + n);
+    for (int u = 0; u < n; ++u) {
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) edges.push_back({u, m_graph.getTarget(arc), m_graph.getWeight(arc)});
+    }
+    for (int v = 0; v < n; ++v) edges.push_back({n, v, 0});
+    Graph augmented(n + 1, edges, true);
+
+    BellmanFord bellmanFord(augmented);
+    bool ok = bellmanFord.run(n, BellmanFordMode::Queue);
+    m_stats.bellmanFordRelaxations = bellmanFord.getStats().relaxations;
+    if (!ok) {
+        m_cycle = bellmanFord.getNegativeCycle();
+        return false;
+    }
+    for (int v = 0; v < n; ++v) m_potential[v] = bellmanFord.getDistances()[v];
+    return true;
+}
+
+void Johnson::runSources(int first, int last, unsigned threads) {
+    int n = m_graph.getNodeCount();
+    atomic<unsigned long long> examined{0};
+    ThreadPool::getInstance().parallelFor(last - first, GRAIN, [&](size_t begin, size_t end) {
+        // One heap and distance array per task, reused for its sources
+        IndexedDaryHeap<4> heap(n);
+        vector<int64_t> distances(n);
+        unsigned long long count = 0;
+        for (size_t s = begin; s < end; ++s) {
+            int source = first + static_cast<int>(s);
+            fill(distances.begin(), distances.end(), INT64_MAX);
+            distances[source] = 0;
+            heap.update(source, 0);
+            int u;
+            int64_t key;
+            while (heap.pop(u, key)) {
+                for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                    ++count;
+                    int v = m_graph.getTarget(arc);
+                    int64_t distance = key + m_graph.getWeight(arc) + m_potential[u] - m_potential[v];
+                    if (distance < distances[v]) {
+                        distances[v] = distance;
+                        heap.update(v, distance);
+                    }
+                }
+            }
+            int* row = &m_distances[static_cast<size_t>(source) * n];
+            for (int v = 0; v < n; ++v) {
+                row[v] = distances[v] == INT64_MAX ? FloydWarshall::INF
+                                                   : static_cast<int>(distances[v] - m_potential[source] + m_potential[v]);
+            }
+        }
+        examined.fetch_add(count, memory_order_relaxed);
+    }, threads);
+    m_stats.sources += last - first;
+    m_stats.relaxations += examined.load();
+}
+
+bool Johnson::run(unsigned threads) {
+    if (!reweight()) return false;
+    runSources(0, m_graph.getNodeCount(), threads);
+    return true;
+}
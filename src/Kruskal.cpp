@@ -0,0 +1,164 @@
+#include "Kruskal.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+using namespace std;
+
+Kruskal::Kruskal(int nodeCount, const vector<GraphEdge>& edges)
+    : m_nodeCount(nodeCount), m_edges(edges), m_baseCase(DEFAULT_BASE_CASE), m_events(nullptr), m_threads(0) {
+    assert(edges.size() <= static_cast<size_t>(INT_MAX)); // keyEdge() returns the id as an int
+}
+
+void Kruskal::sortKeys(uint64_t* keys, size_t count, unsigned threads) {
+    if (count < PARALLEL_MIN) {
+        sort(keys, keys + count);
+        return;
+    }
+    ThreadPool& pool = ThreadPool::getInstance();
+    size_t grain = max<size_t>(PARALLEL_MIN, count / (4 * pool.getThreadCount()));
+    size_t chunks = (count + grain - 1) / grain;
+
+    // Bytes on which all keys agree need no pass
+    vector<uint64_t> ors(chunks, 0), ands(chunks, ~0ull);
+    pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+        uint64_t o = 0, a = ~0ull;
+        for (size_t i = begin; i < end; ++i) { o |= keys[i]; a &= keys[i]; }
+        ors[begin / grain] = o;
+        ands[begin / grain] = a;
+    }, threads);
+    uint64_t allOr = 0, allAnd = ~0ull;
+    for (size_t c = 0; c < chunks; ++c) { allOr |= ors[c]; allAnd &= ands[c]; }
+    uint64_t varying = allOr ^ allAnd;
+
+    vector<uint64_t> buffer(count);
+    uint64_t* from = keys;
+    uint64_t* to = buffer.data();
+    vector<size_t> offsets(chunks * 256);
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xff) == 0) continue;
+        // Count each chunk's digits, then give every (digit, chunk) pair its
+        // slice of the output so chunks scatter independently and stably
+        pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+            size_t* histogram = &offsets[begin / grain * 256];
+            fill(histogram, histogram + 256, 0);
+            for (size_t i = begin; i < end; ++i) histogram[(from[i] >> shift) & 0xff]++;
+        }, threads);
+        size_t position = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            for (size_t c = 0; c < chunks; ++c) {
+                size_t n = offsets[c * 256 + digit];
+                offsets[c * 256 + digit] = position;
+                position += n;
+            }
+        }
+        pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+            size_t* next = &offsets[begin / grain * 256];
+            for (size_t i = begin; i < end; ++i) to[next[(from[i] >> shift) & 0xff]++] = from[i];
+        }, threads);
+        swap(from, to);
+    }
+    if (from != keys) memcpy(keys, from, count * sizeof(uint64_t));
+}
+
+// Kruskal proper over keys in ascending order
+void Kruskal::scan(const uint64_t* keys, size_t count) {
+    for (size_t i = 0; i < count && !isTreeComplete(); ++i) {
+        int edge = keyEdge(keys[i]);
+        bool added = m_sets.unite(m_edges[edge].from, m_edges[edge].to);
+        if (added) {
+            m_tree.push_back(edge);
+            m_stats.treeWeight += m_edges[edge].weight;
+        }
+        m_stats.scanned++;
+        if (m_events) m_events->push_back({edge, added ? KruskalOutcome::Added : KruskalOutcome::Rejected});
+    }
+}
+
+// Removes the keys of edges inside one component, keeping the order of the
+// rest; returns how many are left. Finds only read the union-find here.
+size_t Kruskal::filter(uint64_t* keys, size_t count) {
+    auto keep = [&](uint64_t key) {
+        const GraphEdge& edge = m_edges[keyEdge(key)];
+        return m_sets.findRoot(edge.from) != m_sets.findRoot(edge.to);
+    };
+    size_t kept = 0;
+    if (count < PARALLEL_MIN || m_events) {
+        for (size_t i = 0; i < count; ++i) {
+            if (keep(keys[i])) keys[kept++] = keys[i];
+            else if (m_events) m_events->push_back({keyEdge(keys[i]), KruskalOutcome::Filtered});
+        }
+    } else {
+        // Each chunk compacts itself, then the chunks are moved together
+        ThreadPool& pool = ThreadPool::getInstance();
+        size_t grain = max<size_t>(PARALLEL_MIN, count / (4 * pool.getThreadCount()));
+        vector<size_t> chunkKept((count + grain - 1) / grain);
+        pool.parallelFor(count, grain, [&](size_t begin, size_t end) {
+            size_t out = begin;
+            for (size_t i = begin; i < end; ++i) {
+                if (keep(keys[i])) keys[out++] = keys[i];
+            }
+            chunkKept[begin / grain] = out - begin;
+        }, m_threads);
+        for (size_t c = 0; c < chunkKept.size(); ++c) {
+            memmove(keys + kept, keys + c * grain, chunkKept[c] * sizeof(uint64_t));
+            kept += chunkKept[c];
+        }
+    }
+    m_stats.filtered += count - kept;
+    return kept;
+}
+
+void Kruskal::filterKruskal(uint64_t* first, uint64_t* last) {
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    // Recursion on the light half only; the heavy half continues the loop
+    while (first != last && !isTreeComplete()) {
+        size_t count = last - first;
+        uint64_t* middle = last;
+        if (count > m_baseCase) {
+            // Median of three sampled keys as the pivot
+            uint64_t sample[3];
+            for (uint64_t& s : sample) {
+                seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+                s = first[seed % count];
+            }
+            sort(sample, sample + 3);
+            middle = partition(first, last, [&](uint64_t key) { return key <= sample[1]; });
+        }
+        if (middle == last) { // Small enough, or the pivot split nothing off
+            sortKeys(first, count, m_threads);
+            m_stats.sorted += count;
+            scan(first, count);
+            return;
+        }
+        filterKruskal(first, middle);
+        if (isTreeComplete()) return;
+        last = middle + filter(middle, last - middle);
+        first = middle;
+    }
+}
+
+void Kruskal::run(KruskalMode mode, unsigned threads, vector<KruskalEvent>* events) {
+    m_sets.reset(m_nodeCount);
+    m_tree.clear();
+    m_events = events;
+    m_threads = threads;
+    m_stats = KruskalStats();
+    if (m_events) m_events->clear();
+
+    vector<uint64_t> keys(m_edges.size());
+    ThreadPool::getInstance().parallelFor(keys.size(), PARALLEL_MIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) keys[i] = packKey(m_edges[i].weight, static_cast<uint32_t>(i));
+    }, threads);
+
+    if (mode == KruskalMode::Filter) {
+        filterKruskal(keys.data(), keys.data() + keys.size());
+    } else {
+        sortKeys(keys.data(), keys.size(), threads);
+        m_stats.sorted = keys.size();
+        scan(keys.data(), keys.size());
+    }
+    m_events = nullptr;
+}
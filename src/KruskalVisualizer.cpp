@@ -1,100 +1,117 @@
 #include "KruskalVisualizer.h"
-#include <iostream>
+#include "GraphLoader.h"
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
 
 using namespace std;
 
-int KruskalVisualizer::findSet(int i) {
-    if (m_parent[i] == i) return i;
-    return m_parent[i] = findSet(m_parent[i]);
-}
-
-void KruskalVisualizer::unionSets(int i, int j) {
-    int set_i = findSet(i);
-    int set_j = findSet(j);
-    if (set_i != set_j) m_parent[set_i] = set_j;
-}
-
-KruskalVisualizer::KruskalVisualizer(sf::RenderWindow& window)
-    : Visualizer(window), m_isVisualizing(false), m_isDone(false), m_edgeIndex(0) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) cerr << "Error loading font" << endl;
+KruskalVisualizer::KruskalVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_nodeCount(0), m_mode(KruskalMode::Sorted), m_engineMs(0.0), m_eventIndex(0), m_testedEdge(-1),
+      m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 1.0); // One step every 1.0s by default
 }
 
 void KruskalVisualizer::buildGraph() {
-    m_nodes.clear(); m_edges.clear(); m_edgeWeights.clear();
+    m_edges.clear(); m_renderer.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, sf::Color::White, sf::Color::Black);
+        m_edges = file->edges;
+        m_nodeCount = file->nodeCount;
+        return;
+    }
     map<int, sf::Vector2f> positions = {
         {0, {150, 200}}, {1, {150, 500}}, {2, {450, 350}}, 
         {3, {750, 200}}, {4, {750, 500}}, {5, {1050, 350}}
     };
     for(const auto& p : positions) {
-        Node node;
-        node.shape.setRadius(30.f); node.shape.setOrigin(30.f, 30.f);
-        node.shape.setPosition(p.second);
-        node.label.setFont(m_font); node.label.setString(to_string(p.first));
-        node.label.setCharacterSize(24);
-        sf::FloatRect r = node.label.getLocalBounds();
-        node.label.setOrigin(r.left + r.width/2.f, r.top + r.height/2.f);
-        node.label.setPosition(p.second);
-        m_nodes[p.first] = node;
+        m_renderer.addNode(p.second, sf::Color::White);
+        m_renderer.addLabel(p.second, to_string(p.first), 24, sf::Color::Black);
     }
+    m_nodeCount = positions.size();
     auto addEdge = [&](int u, int v, int w) {
         m_edges.push_back({u, v, w});
-        sf::Text weightText(to_string(w), m_font, 20);
-        weightText.setPosition((m_nodes[u].shape.getPosition() + m_nodes[v].shape.getPosition()) / 2.f);
-        m_edgeWeights[{min(u,v), max(u,v)}] = weightText;
+        m_renderer.addEdge(u, v);
+        sf::Vector2f middle = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+        m_renderer.addLabel(middle, to_string(w), 20, sf::Color::White, false);
     };
     addEdge(0, 1, 7); addEdge(0, 2, 1); addEdge(1, 2, 5); addEdge(2, 3, 6);
     addEdge(2, 4, 2); addEdge(3, 4, 4); addEdge(3, 5, 3); addEdge(4, 5, 8);
 }
 
+// Times a plain run, then records one for the replay
+void KruskalVisualizer::runEngine() {
+    m_engine = make_unique<Kruskal>(m_nodeCount, m_edges);
+    m_engine->setBaseCase(max<size_t>(2, m_edges.size() / 8)); // Small enough for filter steps to show
+    auto startTime = chrono::steady_clock::now();
+    m_engine->run(m_mode);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+
+    const KruskalStats& stats = m_engine->getStats();
+    cout << "Kruskal (" << kruskalModeName(m_mode) << "): " << m_engineMs << " ms, " << m_engine->getTreeEdges().size()
+         << " tree edges of weight " << stats.treeWeight << ", " << stats.sorted << " sorted, " << stats.filtered << " filtered." << endl;
+    if (m_edges.size() > MAX_RECORDED_EDGES) {
+        cout << "Too many edges to replay; showing the result only." << endl;
+        m_events.clear();
+        for (int edge : m_engine->getTreeEdges()) m_events.push_back({edge, KruskalOutcome::Added});
+        return;
+    }
+    m_engine->run(m_mode, 0, &m_events);
+}
+
 void KruskalVisualizer::reset() {
     buildGraph();
-    sort(m_edges.begin(), m_edges.end(), [](const Edge& a, const Edge& b){ return a.weight < b.weight; });
-    m_parent.resize(m_nodes.size());
-    for(size_t i=0; i<m_nodes.size(); ++i) m_parent[i] = i;
+    runEngine();
+    m_edgeState.assign(m_edges.size(), -1);
+    m_eventIndex = 0;
+    m_testedEdge = -1;
     m_isVisualizing = false;
     m_isDone = false;
-    m_edgeIndex = 0;
     cout << "Kruskal's reset. Press SPACE to start." << endl;
 }
 
+void KruskalVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
+}
+
 void KruskalVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::M) {
+            m_mode = static_cast<KruskalMode>((static_cast<int>(m_mode) + 1) % size(ALL_KRUSKAL_MODES));
+            reset();
+        }
     }
 }
 
-void KruskalVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+bool KruskalVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
 
-    if (m_edgeIndex < m_edges.size()) {
-        for(auto& edge : m_edges) edge.isBeingTested = false;
-        m_edges[m_edgeIndex].isBeingTested = true;
-        if (findSet(m_edges[m_edgeIndex].u) != findSet(m_edges[m_edgeIndex].v)) {
-            m_edges[m_edgeIndex].inMst = true;
-            unionSets(m_edges[m_edgeIndex].u, m_edges[m_edgeIndex].v);
-        }
-        m_edgeIndex++;
+    if (m_eventIndex < m_events.size()) {
+        const KruskalEvent& event = m_events[m_eventIndex++];
+        m_testedEdge = event.edge;
+        m_edgeState[event.edge] = static_cast<int>(event.outcome);
     } else {
+        m_testedEdge = -1;
         m_isDone = true; m_isVisualizing = false;
     }
+    return true;
 }
 
 void KruskalVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for(const auto& edge : m_edges) {
-        sf::Vertex line[] = {m_nodes[edge.u].shape.getPosition(), m_nodes[edge.v].shape.getPosition()};
-        if (edge.inMst) line[0].color = line[1].color = sf::Color::Green;
-        else if (edge.isBeingTested) line[0].color = line[1].color = sf::Color::Yellow;
-        m_window.draw(line, 2, sf::Lines);
-    }
-    for (const auto& pair : m_edgeWeights) m_window.draw(pair.second);
-    for (auto& pair : m_nodes) {
-        m_window.draw(pair.second.shape);
-        m_window.draw(pair.second.label);
+    m_window->clear(sf::Color(30, 30, 30));
+    for (int i = 0; i < (int)m_edges.size(); ++i) {
+        sf::Color color = sf::Color::White;
+        if (i == m_testedEdge) color = sf::Color::Yellow;
+        else if (m_edgeState[i] == static_cast<int>(KruskalOutcome::Added)) color = sf::Color::Green;
+        else if (m_edgeState[i] == static_cast<int>(KruskalOutcome::Rejected)) color = sf::Color(90, 90, 90);
+        else if (m_edgeState[i] == static_cast<int>(KruskalOutcome::Filtered)) color = sf::Color(170, 80, 200);
+        m_renderer.setEdgeColor(i, color);
     }
+    m_renderer.draw(*m_window, m_font);
     std::string statusText;
     if (m_isDone)
         statusText = "Complete!";
@@ -104,5 +121,14 @@ void KruskalVisualizer::draw() {
         statusText = "Paused.";
     sf::Text infoText("Kruskal's Algorithm (MST) | " + statusText, m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    const KruskalStats& stats = m_engine->getStats();
+    ostringstream run;
+    run << "M: " << kruskalModeName(m_mode) << " | full run: " << fixed << setprecision(2) << m_engineMs << " ms, "
+        << stats.sorted << " sorted, " << stats.filtered << " filtered (purple), tree weight " << stats.treeWeight;
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 38);
+    m_window->draw(runText);
 }
@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_file(nullptr), m_mapping(nullptr) {}
+
+bool MappedFile::open(const string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        cerr << "Error opening '" << path << "'" << endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        cerr << "Error mapping '" << path << "': empty or unreadable file" << endl;
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        cerr << "Error mapping '" << path << "'" << endl;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+    m_data = nullptr;
+    m_size = 0;
+    m_file = nullptr;
+    m_mapping = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0) {}
+
+bool MappedFile::open(const string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Error opening '" << path << "'" << endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        cerr << "Error mapping '" << path << "': empty or unreadable file" << endl;
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (view == MAP_FAILED) {
+        cerr << "Error mapping '" << path << "'" << endl;
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
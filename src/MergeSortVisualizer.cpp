@@ -1,30 +1,15 @@
 #include "MergeSortVisualizer.h"
-#include <random>
 #include <algorithm>
 #include <iostream>
 
 using namespace std;
 
-MergeSortVisualizer::MergeSortVisualizer(sf::RenderWindow& window)
+MergeSortVisualizer::MergeSortVisualizer(sf::RenderWindow* window)
     : Visualizer(window), m_currentSize(0), m_leftStart(0), m_state(State::IDLE), m_isSorting(false) {}
 
-void MergeSortVisualizer::initializeData() {
-    m_data.clear();
-    int numElements = m_window.getSize().x / 8;
-    m_data.reserve(numElements);
-
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> distrib(10, m_window.getSize().y - 50);
-
-    for (int k = 0; k < numElements; ++k) {
-        m_data.push_back(distrib(gen));
-    }
-    m_aux_data = m_data;
-}
-
 void MergeSortVisualizer::reset() {
-    initializeData();
+    m_data = generateBarData(getCanvasSize().x / 8, 50);
+    m_aux_data = m_data;
     m_state = State::IDLE;
     m_isSorting = false;
     m_currentSize = 1;
@@ -32,6 +17,10 @@ void MergeSortVisualizer::reset() {
     cout << "Merge Sort Visualizer reset. Press SPACE to start sorting." << endl;
 }
 
+void MergeSortVisualizer::start() {
+    if (m_state != State::DONE) m_isSorting = true;
+}
+
 void MergeSortVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && m_state != State::DONE) {
@@ -43,15 +32,15 @@ void MergeSortVisualizer::handleEvent(sf::Event& event) {
     }
 }
 
-void MergeSortVisualizer::update() {
-    if (!m_isSorting || m_state == State::DONE) return;
+bool MergeSortVisualizer::step() {
+    if (!m_isSorting || m_state == State::DONE) return false;
 
     if (m_state == State::IDLE) {
         if (m_currentSize >= m_data.size()) {
             m_state = State::DONE;
             m_isSorting = false;
             cout << "Merge Sort complete!" << endl;
-            return;
+            return true;
         }
 
         m_merge_l = m_leftStart;
@@ -88,38 +77,31 @@ void MergeSortVisualizer::update() {
             m_state = State::IDLE;
         }
     }
+    return true;
 }
 
 void MergeSortVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-
-    float barWidth = static_cast<float>(m_window.getSize().x) / m_data.size();
-    sf::Font font;
-    font.loadFromFile("assets/arial.ttf");
-
-    for (size_t k = 0; k < m_data.size(); ++k) {
-        sf::RectangleShape bar;
-        bar.setSize(sf::Vector2f(barWidth - 1, m_data[k]));
-        bar.setPosition(k * barWidth, m_window.getSize().y - m_data[k]);
+    m_window->clear(sf::Color(30, 30, 30));
 
+    m_bars.update(m_data, getCanvasSize(), [&](size_t k) {
         if (m_state == State::DONE) {
-            bar.setFillColor(sf::Color::Green);
+            return sf::Color::Green;
         } else if (m_state == State::MERGING && k >= (size_t)m_merge_l && k <= (size_t)m_merge_r) {
-            bar.setFillColor(sf::Color::Red); // Current sub-array being merged
+            return sf::Color::Red; // Current sub-array being merged
         } else if (m_isSorting && k == (size_t)m_merge_k-1) {
-            bar.setFillColor(sf::Color::Yellow); // Last placed element
+            return sf::Color::Yellow; // Last placed element
         } else {
-            bar.setFillColor(sf::Color::Cyan);
+            return sf::Color::Cyan;
         }
-        m_window.draw(bar);
-    }
+    });
+    m_bars.draw(*m_window);
 
     sf::Text infoText;
-    infoText.setFont(font);
+    infoText.setFont(m_font);
     infoText.setCharacterSize(20);
     infoText.setFillColor(sf::Color::White);
     string status = m_state == State::DONE ? "Sorted!" : (m_isSorting ? "Sorting..." : "Paused.");
     infoText.setString("Merge Sort | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
 }
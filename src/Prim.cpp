@@ -0,0 +1,161 @@
+#include "Prim.h"
+#include "CpuFeatures.h"
+#include "PriorityQueues.h"
+#include <climits>
+#include <sstream>
+#if HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    int findMinKeyScalar(const int* keys, int count) {
+        int best = INT_MAX, bestIndex = -1;
+        for (int i = 0; i < count; ++i) {
+            if (keys[i] < best) {
+                best = keys[i];
+                bestIndex = i;
+            }
+        }
+        return bestIndex;
+    }
+
+#if HAS_AVX2_KERNELS
+    // Each lane keeps its smallest key and where it was; later positions
+    // only replace strictly smaller keys, so each lane keeps its first minimum
+    AVX2_TARGET int findMinKeyAvx2(const int* keys, int count) {
+        int best = INT_MAX, bestIndex = -1;
+        int i = 0;
+        if (count >= 8) {
+            __m256i minKeys = _mm256_set1_epi32(INT_MAX);
+            __m256i minIndices = _mm256_set1_epi32(-1);
+            __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i eight = _mm256_set1_epi32(8);
+            for (; i + 8 <= count; i += 8) {
+                __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                __m256i smaller = _mm256_cmpgt_epi32(minKeys, k);
+                minKeys = _mm256_min_epi32(minKeys, k);
+                minIndices = _mm256_blendv_epi8(minIndices, indices, smaller);
+                indices = _mm256_add_epi32(indices, eight);
+            }
+            alignas(32) int laneKeys[8], laneIndices[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(laneKeys), minKeys);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), minIndices);
+            for (int lane = 0; lane < 8; ++lane) {
+                if (laneKeys[lane] < best || (laneKeys[lane] == best && laneKeys[lane] < INT_MAX && laneIndices[lane] < bestIndex)) {
+                    best = laneKeys[lane];
+                    bestIndex = laneIndices[lane];
+                }
+            }
+        }
+        for (; i < count; ++i) {
+            if (keys[i] < best) {
+                best = keys[i];
+                bestIndex = i;
+            }
+        }
+        return bestIndex;
+    }
+#endif
+}
+
+Prim::Prim(const Graph& graph) : m_graph(graph), m_used(PrimMode::Sparse) {}
+
+int Prim::findMinKey(const int* keys, int count) {
+#if HAS_AVX2_KERNELS
+    if (hasAvx2()) return findMinKeyAvx2(keys, count);
+#endif
+    return findMinKeyScalar(keys, count);
+}
+
+// The crossover depends on the scan that will actually run
+PrimMode Prim::choose(const Graph& graph, string& reason) {
+    const double denseFraction = hasAvx2() ? 1.0 / 8 : 1.0 / 2;
+    double n = graph.getNodeCount();
+    double arcs = static_cast<double>(graph.getArcCount());
+    double threshold = denseFraction * n * n;
+    ostringstream text;
+    text << graph.getArcCount() << " arcs on " << graph.getNodeCount() << " nodes ("
+         << static_cast<int>(n > 1 ? 100.0 * arcs / (n * (n - 1)) : 100.0) << "% of complete) ";
+    PrimMode mode = arcs >= threshold ? PrimMode::Dense : PrimMode::Sparse;
+    if (mode == PrimMode::Dense) text << ">= n^2/" << static_cast<int>(1 / denseFraction) << ": scanning keys beats heap updates";
+    else text << "< n^2/" << static_cast<int>(1 / denseFraction) << ": the heap is cheaper than n^2 key scans";
+    text << " (" << (hasAvx2() ? "AVX2" : "scalar") << " scan)";
+    reason = text.str();
+    return mode;
+}
+
+// Keys of nodes in the tree are INT_MAX, so the scan skips them. When no
+// finite key is left, the next component is started from its lowest node.
+void Prim::runDense() {
+    int n = m_graph.getNodeCount();
+    vector<int> keys(n, INT_MAX);
+    vector<size_t> parentArc(n);
+    vector<char> inTree(n, false); // Bytes, as this is read for every arc
+    int nextRoot = 0;
+    for (int added = 0; added < n; ++added) {
+        m_stats.scans++;
+        int u = findMinKey(keys.data(), n);
+        if (u < 0) {
+            while (inTree[nextRoot]) nextRoot++;
+            u = nextRoot;
+        } else {
+            m_tree.push_back(m_graph.getEdgeId(parentArc[u]));
+            m_stats.treeWeight += keys[u];
+        }
+        inTree[u] = true;
+        keys[u] = INT_MAX;
+        m_stats.relaxations += m_graph.getDegree(u);
+        for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = m_graph.getTarget(arc);
+            if (!inTree[v] && m_graph.getWeight(arc) < keys[v]) {
+                keys[v] = m_graph.getWeight(arc);
+                parentArc[v] = arc;
+            }
+        }
+    }
+}
+
+void Prim::runSparse() {
+    int n = m_graph.getNodeCount();
+    vector<int> keys(n, INT_MAX);
+    vector<size_t> parentArc(n);
+    vector<char> inTree(n, false);
+    IndexedDaryHeap<4> heap(n);
+    for (int root = 0; root < n; ++root) {
+        if (inTree[root]) continue;
+        int u = root;
+        int64_t key;
+        do {
+            if (u != root) {
+                m_tree.push_back(m_graph.getEdgeId(parentArc[u]));
+                m_stats.treeWeight += keys[u];
+            }
+            inTree[u] = true;
+            m_stats.relaxations += m_graph.getDegree(u);
+            for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                int v = m_graph.getTarget(arc);
+                if (!inTree[v] && m_graph.getWeight(arc) < keys[v]) {
+                    keys[v] = m_graph.getWeight(arc);
+                    parentArc[v] = arc;
+                    heap.update(v, keys[v]);
+                }
+            }
+        } while (heap.pop(u, key));
+    }
+    m_stats.heapUpdates = heap.getStats().pushes + heap.getStats().decreaseKeys;
+}
+
+void Prim::run(PrimMode mode) {
+    m_tree.clear();
+    m_stats = PrimStats();
+    if (mode == PrimMode::Auto) {
+        m_used = choose(m_graph, m_reason);
+    } else {
+        m_used = mode;
+        m_reason = "chosen by hand";
+    }
+    if (m_used == PrimMode::Dense) runDense();
+    else runSparse();
+}
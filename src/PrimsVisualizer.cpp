@@ -1,62 +1,98 @@
 #include "PrimsVisualizer.h"
+#include "GraphLoader.h"
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <limits>
+#include <sstream>
 
 using namespace std;
 
-PrimsVisualizer::PrimsVisualizer(sf::RenderWindow& window)
-    : Visualizer(window), m_isVisualizing(false), m_isDone(false), m_currentNode(-1) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) cerr << "Error loading font" << endl;
+PrimsVisualizer::PrimsVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_heapKind(HeapKind::FourAry), m_useArrayScan(false), m_lazyHeap(0), m_fourAryHeap(0), m_engineMs(0.0),
+      m_isVisualizing(false), m_isDone(false), m_currentNode(-1) {
+    m_scheduler.setStepsPerSecond(1.0 / 1.0); // One step every 1.0s by default
 }
 
 void PrimsVisualizer::buildGraph() {
-    m_nodes.clear(); m_edgeWeights.clear(); m_mstEdges.clear();
+    m_mstEdges.clear(); m_renderer.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), true, sf::Color::White, sf::Color::Black);
+        m_graph = Graph(file->nodeCount, file->edges, false); // A spanning tree ignores direction
+        return;
+    }
     map<int, sf::Vector2f> positions = {
         {0, {150, 200}}, {1, {150, 500}}, {2, {450, 350}}, 
         {3, {750, 200}}, {4, {750, 500}}, {5, {1050, 350}}
     };
     for(const auto& p : positions) {
-        Node node;
-        node.shape.setRadius(30.f); node.shape.setOrigin(30.f, 30.f);
-        node.shape.setPosition(p.second);
-        node.label.setFont(m_font); node.label.setString(to_string(p.first));
-        node.label.setCharacterSize(24);
-        sf::FloatRect r = node.label.getLocalBounds();
-        node.label.setOrigin(r.left + r.width/2.f, r.top + r.height/2.f);
-        node.label.setPosition(p.second);
-        m_nodes[p.first] = node;
+        m_renderer.addNode(p.second, sf::Color::White);
+        m_renderer.addLabel(p.second, to_string(p.first), 24, sf::Color::Black);
     }
+    // One line per undirected edge, even though both endpoints list it
+    vector<GraphEdge> edges;
     auto addEdge = [&](int u, int v, int w) {
-        m_nodes[u].adj.push_back({v, w});
-        m_nodes[v].adj.push_back({u, w});
-        sf::Text weightText(to_string(w), m_font, 20);
-        weightText.setPosition((m_nodes[u].shape.getPosition() + m_nodes[v].shape.getPosition()) / 2.f);
-        m_edgeWeights[{min(u,v), max(u,v)}] = weightText;
+        edges.push_back({u, v, w});
+        m_renderer.addEdge(u, v);
+        sf::Vector2f middle = (m_renderer.getNodePosition(u) + m_renderer.getNodePosition(v)) / 2.f;
+        m_renderer.addLabel(middle, to_string(w), 20, sf::Color::White, false);
     };
     addEdge(0, 1, 7); addEdge(0, 2, 1); addEdge(1, 2, 5); addEdge(2, 3, 6);
     addEdge(2, 4, 2); addEdge(3, 4, 4); addEdge(3, 5, 3); addEdge(4, 5, 8);
+    m_graph = Graph(positions.size(), edges, false);
+}
+
+void PrimsVisualizer::runEngine() {
+    m_engine = make_unique<Prim>(m_graph);
+    auto startTime = chrono::steady_clock::now();
+    m_engine->run(PrimMode::Auto);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    cout << "Prim (auto): " << primModeName(m_engine->getUsedMode()) << " because " << m_engine->getReason() << "; "
+         << m_engineMs << " ms, tree weight " << m_engine->getStats().treeWeight << "." << endl;
 }
 
 void PrimsVisualizer::reset() {
     buildGraph();
-    m_inMst.assign(m_nodes.size(), false);
-    while(!m_pq.empty()) m_pq.pop();
+    runEngine();
+    startFrom(0);
+    cout << "Prim's reset. Press SPACE to start." << endl;
+}
+
+void PrimsVisualizer::startFrom(int root) {
+    int n = m_graph.getNodeCount();
+    m_mstEdges.clear();
+    m_inMst.assign(n, false);
+    m_bestWeight.assign(n, numeric_limits<int>::max());
+    m_parentArc.assign(n, 0);
+    m_scanKeys.assign(n, numeric_limits<int>::max());
+    m_lazyHeap = LazyHeap(n);
+    m_fourAryHeap = IndexedDaryHeap<4>(n);
     m_isVisualizing = false;
     m_isDone = false;
-    m_currentNode = 0;
-    addEdges(m_currentNode);
-    cout << "Prim's reset. Press SPACE to start." << endl;
+    addEdges(root);
+}
+
+const HeapStats& PrimsVisualizer::getHeapStats() const {
+    return m_heapKind == HeapKind::Lazy ? m_lazyHeap.getStats() : m_fourAryHeap.getStats();
+}
+
+void PrimsVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
 }
 
 void PrimsVisualizer::addEdges(int u) {
     m_inMst[u] = true;
+    m_scanKeys[u] = numeric_limits<int>::max();
     m_currentNode = u;
-    for (const auto& edge : m_nodes[u].adj) {
-        int v = edge.first;
-        int weight = edge.second;
-        if (!m_inMst[v]) {
-            m_pq.push({weight, u, v});
-        }
+    for (size_t arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+        int v = m_graph.getTarget(arc);
+        int weight = m_graph.getWeight(arc);
+        if (m_inMst[v] || weight >= m_bestWeight[v]) continue;
+        m_bestWeight[v] = weight;
+        m_parentArc[v] = arc;
+        if (m_useArrayScan) m_scanKeys[v] = weight;
+        else if (m_heapKind == HeapKind::Lazy) m_lazyHeap.update(v, weight);
+        else m_fourAryHeap.update(v, weight);
     }
 }
 
@@ -64,51 +100,77 @@ void PrimsVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::H) {
+            if (m_useArrayScan) {
+                m_useArrayScan = false;
+                m_heapKind = HeapKind::Lazy;
+            } else if (m_heapKind == HeapKind::Lazy) {
+                m_heapKind = HeapKind::FourAry;
+            } else {
+                m_useArrayScan = true;
+            }
+            startFrom(0);
+        }
     }
 }
 
-void PrimsVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+bool PrimsVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
 
-    if (m_pq.empty()) {
-        m_isDone = true; m_isVisualizing = false; return;
+    int v;
+    int64_t weight;
+    bool popped;
+    if (m_useArrayScan) {
+        v = Prim::findMinKey(m_scanKeys.data(), m_graph.getNodeCount());
+        popped = v >= 0;
+    } else {
+        popped = (m_heapKind == HeapKind::Lazy) ? m_lazyHeap.pop(v, weight) : m_fourAryHeap.pop(v, weight);
     }
-
-    int u, v, w;
-    do {
-        if(m_pq.empty()) { m_isDone = true; m_isVisualizing = false; return; }
-        auto top = m_pq.top();
-        m_pq.pop();
-        w = get<0>(top); u = get<1>(top); v = get<2>(top);
-    } while (m_inMst[v]);
-    
-    m_mstEdges.push_back({u, v});
+    if (!popped) {
+        m_isDone = true; m_isVisualizing = false; return true;
+    }
+    m_mstEdges.push_back(m_graph.getEdgeId(m_parentArc[v]));
     addEdges(v);
+    return true;
 }
 
 void PrimsVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for(auto const& [key, val] : m_nodes) {
-        for(auto const& edge : val.adj) {
-            sf::Vertex line[] = {m_nodes[key].shape.getPosition(), m_nodes[edge.first].shape.getPosition()};
-            m_window.draw(line, 2, sf::Lines);
-        }
-    }
-    for(const auto& edge : m_mstEdges) {
-        sf::Vertex line[] = {m_nodes[edge.first].shape.getPosition(), m_nodes[edge.second].shape.getPosition()};
-        line[0].color = line[1].color = sf::Color::Green;
-        m_window.draw(line, 2, sf::Lines);
-    }
-    for (const auto& pair : m_edgeWeights) m_window.draw(pair.second);
-    for (auto& pair : m_nodes) {
-        if(m_inMst[pair.first]) pair.second.shape.setFillColor(sf::Color::Green);
-        if(m_currentNode == pair.first) pair.second.shape.setFillColor(sf::Color::Yellow);
-        m_window.draw(pair.second.shape);
-        m_window.draw(pair.second.label);
+    m_window->clear(sf::Color(30, 30, 30));
+    for(int edge : m_mstEdges) m_renderer.setEdgeColor(edge, sf::Color::Green);
+    for (int u = 0; u < m_graph.getNodeCount(); ++u) {
+        if(m_currentNode == u) m_renderer.setNodeColor(u, sf::Color::Yellow);
+        else if(m_inMst[u]) m_renderer.setNodeColor(u, sf::Color::Green);
+        else m_renderer.setNodeColor(u, sf::Color::White);
     }
+    m_renderer.draw(*m_window, m_font);
     std::string status = m_isDone ? "Complete!" : (m_isVisualizing ? "Visualizing..." : "Paused.");
     sf::Text infoText("Prim's Algorithm (MST) | " + status, m_font, 20);
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    string variant;
+    if (m_useArrayScan) {
+        int waiting = 0;
+        for (int key : m_scanKeys) waiting += key != numeric_limits<int>::max();
+        variant = "H: array scan | " + to_string(waiting) + " keys waiting | " + to_string(m_mstEdges.size()) + " scans of " +
+                  to_string(m_graph.getNodeCount()) + " keys";
+    } else {
+        const HeapStats& stats = getHeapStats();
+        size_t size = (m_heapKind == HeapKind::Lazy) ? m_lazyHeap.size() : m_fourAryHeap.size();
+        variant = "H: " + string(heapKindName(m_heapKind)) + " | size " + to_string(size) + " (max " + to_string(stats.maxSize) +
+                  ") | pushes " + to_string(stats.pushes) + " | decrease-keys " + to_string(stats.decreaseKeys) +
+                  " | pops " + to_string(stats.pops) + " (+" + to_string(stats.stalePops) + " stale)";
+    }
+    sf::Text heapText(variant, m_font, 18);
+    heapText.setFillColor(sf::Color(200, 200, 200));
+    heapText.setPosition(10, 38);
+    m_window->draw(heapText);
+
+    ostringstream engine;
+    engine << "Auto: " << primModeName(m_engine->getUsedMode()) << ", " << m_engine->getReason() << " | "
+           << fixed << setprecision(2) << m_engineMs << " ms";
+    sf::Text engineText(engine.str(), m_font, 18);
+    engineText.setFillColor(sf::Color(200, 200, 200));
+    engineText.setPosition(10, 62);
+    m_window->draw(engineText);
 }
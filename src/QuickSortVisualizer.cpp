@@ -1,29 +1,14 @@
 #include "QuickSortVisualizer.h"
-#include <random>
 #include <algorithm>
 #include <iostream>
 
 using namespace std;
 
-QuickSortVisualizer::QuickSortVisualizer(sf::RenderWindow& window)
+QuickSortVisualizer::QuickSortVisualizer(sf::RenderWindow* window)
     : Visualizer(window), m_low(0), m_high(0), m_pivotValue(0), m_pivotIndex(0), m_partitionIndex(0), m_scanIndex(0), m_state(State::IDLE), m_isSorting(false) {}
 
-void QuickSortVisualizer::initializeData() {
-    m_data.clear();
-    int numElements = m_window.getSize().x / 8;
-    m_data.reserve(numElements);
-
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_int_distribution<> distrib(10, m_window.getSize().y - 50);
-
-    for (int k = 0; k < numElements; ++k) {
-        m_data.push_back(distrib(gen));
-    }
-}
-
 void QuickSortVisualizer::reset() {
-    initializeData();
+    m_data = generateBarData(getCanvasSize().x / 8, 50);
     while(!m_stack.empty()) m_stack.pop();
     m_stack.push({0, (int)m_data.size() - 1});
     m_state = State::IDLE;
@@ -31,6 +16,10 @@ void QuickSortVisualizer::reset() {
     cout << "Quick Sort Visualizer reset. Press SPACE to start sorting." << endl;
 }
 
+void QuickSortVisualizer::start() {
+    if (m_state != State::DONE) m_isSorting = true;
+}
+
 void QuickSortVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && m_state != State::DONE) {
@@ -42,15 +31,15 @@ void QuickSortVisualizer::handleEvent(sf::Event& event) {
     }
 }
 
-void QuickSortVisualizer::update() {
-    if (!m_isSorting || m_state == State::DONE) return;
+bool QuickSortVisualizer::step() {
+    if (!m_isSorting || m_state == State::DONE) return false;
 
     if (m_state == State::IDLE) {
         if (m_stack.empty()) {
             m_state = State::DONE;
             m_isSorting = false;
             cout << "Quick Sort complete!" << endl;
-            return;
+            return true;
         }
 
         pair<int, int> subArray = m_stack.top();
@@ -88,42 +77,35 @@ void QuickSortVisualizer::update() {
             m_state = State::IDLE; // Ready for next partition
         }
     }
+    return true;
 }
 
 void QuickSortVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-
-    float barWidth = static_cast<float>(m_window.getSize().x) / m_data.size();
-    sf::Font font;
-    font.loadFromFile("assets/arial.ttf");
-
-    for (size_t k = 0; k < m_data.size(); ++k) {
-        sf::RectangleShape bar;
-        bar.setSize(sf::Vector2f(barWidth - 1, m_data[k]));
-        bar.setPosition(k * barWidth, m_window.getSize().y - m_data[k]);
+    m_window->clear(sf::Color(30, 30, 30));
 
+    m_bars.update(m_data, getCanvasSize(), [&](size_t k) {
         if (m_state == State::DONE) {
-            bar.setFillColor(sf::Color::Green);
+            return sf::Color::Green;
         } else if (m_state == State::PARTITIONING && k == (size_t)m_pivotIndex) {
-            bar.setFillColor(sf::Color::Magenta); // Pivot
+            return sf::Color::Magenta; // Pivot
         } else if (m_state == State::PARTITIONING && k == (size_t)m_scanIndex) {
-            bar.setFillColor(sf::Color::Blue); // Current scanning element
+            return sf::Color::Blue; // Current scanning element
         } else if (m_state == State::PARTITIONING && k == (size_t)m_partitionIndex) {
-            bar.setFillColor(sf::Color::Yellow); // Partition index (where the pivot will go)
+            return sf::Color::Yellow; // Partition index (where the pivot will go)
         } else if (m_state == State::PARTITIONING && k >= (size_t)m_low && k <= (size_t)m_high) {
-            bar.setFillColor(sf::Color::Red); // Current sub-array
+            return sf::Color::Red; // Current sub-array
         } else {
-            bar.setFillColor(sf::Color::Cyan);
+            return sf::Color::Cyan;
         }
-        m_window.draw(bar);
-    }
+    });
+    m_bars.draw(*m_window);
 
     sf::Text infoText;
-    infoText.setFont(font);
+    infoText.setFont(m_font);
     infoText.setCharacterSize(20);
     infoText.setFillColor(sf::Color::White);
     string status = m_state == State::DONE ? "Sorted!" : (m_isSorting ? "Sorting..." : "Paused.");
     infoText.setString("Quick Sort | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
 }
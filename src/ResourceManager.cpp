@@ -0,0 +1,51 @@
+#include "ResourceManager.h"
+#include <iostream>
+
+using namespace std;
+
+ResourceManager& ResourceManager::getInstance() {
+    static ResourceManager instance;
+    return instance;
+}
+
+bool ResourceManager::loadFont(const string& path) {
+    auto it = m_fonts.find(path);
+    if (it != m_fonts.end()) return it->second != nullptr;
+
+    auto font = make_unique<sf::Font>();
+    if (!font->loadFromFile(path)) {
+        cerr << "Error loading font '" << path << "'" << endl;
+        m_fonts[path] = nullptr; // Remember the failure so we do not retry every call
+        return false;
+    }
+    m_fonts[path] = move(font);
+    return true;
+}
+
+const sf::Font& ResourceManager::getFont(const string& path) {
+    if (loadFont(path)) return *m_fonts[path];
+
+    static const sf::Font emptyFont;
+    return emptyFont;
+}
+
+const sf::Texture& ResourceManager::getTexture(const string& path) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) return *it->second;
+
+    auto texture = make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        cerr << "Error loading texture '" << path << "'" << endl;
+    }
+    const sf::Texture& result = *texture;
+    m_textures[path] = move(texture);
+    return result;
+}
+
+void ResourceManager::prewarmGlyphs(const sf::Font& font, const vector<unsigned int>& characterSizes, bool bold) {
+    for (unsigned int size : characterSizes) {
+        for (sf::Uint32 c = 32; c < 127; ++c) {
+            font.getGlyph(c, size, bold);
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#include "SortTraceVisualizer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    // Events take a few bytes each, but O(n^2) sorts still produce tens of
+    // millions of them, so cap the input per complexity class
+    const int MAX_QUADRATIC_ELEMENTS = 4096;
+    const int MAX_ELEMENTS = 1 << 18;
+    const int MIN_ELEMENTS = 8;
+
+    const char* TRACE_FILE = "sort.trace";
+}
+
+SortTraceVisualizer::SortTraceVisualizer(sf::RenderWindow* window)
+    : Visualizer(window), m_algorithm(SortAlgorithm::Quick), m_elementCount(getCanvasSize().x / 8),
+      m_isPlaying(false), m_isReversed(false), m_isScrubbing(false), m_isLoaded(false), m_recordMillis(0.0) {}
+
+int SortTraceVisualizer::getMaxElementCount() const {
+    return isQuadraticSort(m_algorithm) ? MAX_QUADRATIC_ELEMENTS : MAX_ELEMENTS;
+}
+
+void SortTraceVisualizer::record() {
+    m_elementCount = clamp(m_elementCount, MIN_ELEMENTS, getMaxElementCount());
+
+    TraceState initial;
+    initial.values = generateBarData(m_elementCount, 100);
+
+    vector<int> data = initial.values;
+    m_trace = Trace(move(initial));
+    m_trace.setLabel(sortAlgorithmName(m_algorithm));
+    m_isLoaded = false;
+
+    auto begin = chrono::steady_clock::now();
+    runSortEngine(m_algorithm, data, m_trace);
+    m_recordMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    m_player.load(m_trace);
+    cout << sortAlgorithmName(m_algorithm) << " trace recorded: " << m_trace.size() << " events for "
+         << m_elementCount << " elements in " << m_recordMillis << " ms (" << m_trace.getMemoryBytes() / 1024
+         << " KB, " << m_trace.getKeyframeCount() << " keyframes)." << endl;
+}
+
+void SortTraceVisualizer::saveTrace() {
+    if (m_trace.saveToFile(TRACE_FILE)) {
+        cout << "Trace saved to " << TRACE_FILE << " (" << m_trace.getMemoryBytes() / 1024 << " KB)." << endl;
+    }
+}
+
+void SortTraceVisualizer::loadTrace() {
+    Trace loaded;
+    if (!loaded.loadFromFile(TRACE_FILE)) return;
+
+    const SortAlgorithm* match = find_if(begin(ALL_SORT_ALGORITHMS), end(ALL_SORT_ALGORITHMS),
+                                         [&](SortAlgorithm a) { return sortAlgorithmName(a) == loaded.getLabel(); });
+    if (match == end(ALL_SORT_ALGORITHMS) || loaded.getStateCount() != 0) {
+        cerr << TRACE_FILE << " does not hold a sort trace ('" << loaded.getLabel() << "')." << endl;
+        return;
+    }
+    m_algorithm = *match;
+    m_elementCount = static_cast<int>(loaded.getValueCount());
+    m_trace = move(loaded);
+    m_player.load(m_trace);
+    m_isLoaded = true;
+    m_isPlaying = false;
+    m_isReversed = false;
+    cout << "Loaded " << m_trace.getLabel() << " trace from " << TRACE_FILE << ": " << m_trace.size() << " events." << endl;
+}
+
+void SortTraceVisualizer::reset() {
+    record();
+    m_isPlaying = false;
+    m_isReversed = false;
+    m_isScrubbing = false;
+    cout << "Sort Trace Player reset. Press SPACE to play." << endl;
+}
+
+void SortTraceVisualizer::start() {
+    if (!m_isReversed && m_player.atEnd()) m_player.seek(0);
+    m_isPlaying = true;
+}
+
+sf::FloatRect SortTraceVisualizer::getTimelineRect() const {
+    return sf::FloatRect(10.f, 62.f, getCanvasSize().x - 20.f, 8.f);
+}
+
+void SortTraceVisualizer::scrubTo(float x) {
+    sf::FloatRect timeline = getTimelineRect();
+    float fraction = clamp((x - timeline.left) / timeline.width, 0.f, 1.f);
+    m_player.seek(static_cast<size_t>(fraction * m_player.getLength()));
+}
+
+void SortTraceVisualizer::handleEvent(sf::Event& event) {
+    if (event.type == sf::Event::KeyPressed) {
+        switch (event.key.code) {
+            case sf::Keyboard::Space:
+                if (m_isPlaying) m_isPlaying = false;
+                else start();
+                break;
+            case sf::Keyboard::B: m_isReversed = !m_isReversed; break;
+            case sf::Keyboard::Right: m_isPlaying = false; m_player.stepForward(); break;
+            case sf::Keyboard::Left:  m_isPlaying = false; m_player.stepBackward(); break;
+            case sf::Keyboard::Home:  m_player.seek(0); break;
+            case sf::Keyboard::End:   m_player.seek(m_player.getLength()); break;
+            case sf::Keyboard::Up:    m_elementCount *= 2; reset(); break;
+            case sf::Keyboard::Down:  m_elementCount /= 2; reset(); break;
+            case sf::Keyboard::R:     reset(); break;
+            case sf::Keyboard::S:     saveTrace(); break;
+            case sf::Keyboard::L:     loadTrace(); break;
+            default:
+                if (event.key.code >= sf::Keyboard::Num1 && event.key.code <= sf::Keyboard::Num6) {
+                    m_algorithm = ALL_SORT_ALGORITHMS[event.key.code - sf::Keyboard::Num1];
+                    reset();
+                }
+                break;
+        }
+    }
+    if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        sf::Vector2f pos = m_window->mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
+        sf::FloatRect hitArea = getTimelineRect();
+        hitArea.top -= 6.f; hitArea.height += 12.f; // Easier to grab than the thin bar itself
+        if (hitArea.contains(pos)) {
+            m_isScrubbing = true;
+            m_isPlaying = false;
+            scrubTo(pos.x);
+        }
+    }
+    if (event.type == sf::Event::MouseMoved && m_isScrubbing) {
+        scrubTo(m_window->mapPixelToCoords({event.mouseMove.x, event.mouseMove.y}).x);
+    }
+    if (event.type == sf::Event::MouseButtonReleased) m_isScrubbing = false;
+}
+
+bool SortTraceVisualizer::step() {
+    if (!m_isPlaying) return false;
+    bool moved = m_isReversed ? m_player.stepBackward() : m_player.stepForward();
+    if (!moved) m_isPlaying = false;
+    return moved;
+}
+
+void SortTraceVisualizer::draw() {
+    m_window->clear(sf::Color(30, 30, 30));
+
+    const TraceEvent* last = m_player.getLastEvent();
+    bool finished = m_player.atEnd();
+    m_bars.update(m_player.getState().values, getCanvasSize(), [&](size_t k) {
+        int index = static_cast<int>(k);
+        if (finished) {
+            return sf::Color::Green;
+        } else if (last && last->type == TraceEvent::Type::Compare && (index == last->a || index == last->b)) {
+            return sf::Color::Yellow; // Compared pair
+        } else if (last && last->type == TraceEvent::Type::Swap && (index == last->a || index == last->b)) {
+            return sf::Color::Red; // Swapped pair
+        } else if (last && last->type == TraceEvent::Type::Write && index == last->a) {
+            return sf::Color::Red; // Written element
+        } else {
+            return sf::Color::Cyan;
+        }
+    });
+    m_bars.draw(*m_window);
+
+    sf::FloatRect timeline = getTimelineRect();
+    sf::RectangleShape track({timeline.width, timeline.height});
+    track.setPosition(timeline.left, timeline.top);
+    track.setFillColor(sf::Color(70, 70, 70));
+    m_window->draw(track);
+    float progress = m_player.getLength() ? static_cast<float>(m_player.getPosition()) / m_player.getLength() : 0.f;
+    sf::RectangleShape filled({timeline.width * progress, timeline.height});
+    filled.setPosition(timeline.left, timeline.top);
+    filled.setFillColor(sf::Color(0, 150, 255));
+    m_window->draw(filled);
+
+    string status = m_isPlaying ? (m_isReversed ? "Rewinding..." : "Playing...") : (finished ? "Sorted!" : "Paused.");
+    ostringstream info;
+    info << sortAlgorithmName(m_algorithm) << " Trace | " << status << " | Step " << m_player.getPosition()
+         << " / " << m_player.getLength() << " | n=" << m_elementCount;
+    if (m_isLoaded) info << ", loaded from " << TRACE_FILE;
+    else info << ", recorded in " << static_cast<int>(m_recordMillis + 0.5) << " ms";
+    info << ", " << m_trace.getMemoryBytes() / 1024 << " KB";
+    sf::Text infoText(info.str(), m_font, 20);
+    infoText.setPosition(10, 10);
+    m_window->draw(infoText);
+
+    sf::Text helpText("1-6 algorithm | Up/Down size | Left/Right step | B reverse | Home/End | drag timeline | S/L save/load | ESC for menu", m_font, 16);
+    helpText.setFillColor(sf::Color(170, 170, 170));
+    helpText.setPosition(10, 36);
+    m_window->draw(helpText);
+}
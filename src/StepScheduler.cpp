@@ -0,0 +1,116 @@
+#include "StepScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    // Preset speeds in steps per second, cycled through with +/-
+    const double SPEED_PRESETS[] = {
+        0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 60, 120, 300,
+        1000, 3000, 10000, 30000, 100000, 300000, 1000000
+    };
+    const size_t PRESET_COUNT = sizeof(SPEED_PRESETS) / sizeof(SPEED_PRESETS[0]);
+
+    // A long stall (window drag, breakpoint) must not turn into a burst of steps
+    const float MAX_FRAME_SECONDS = 0.25f;
+}
+
+StepScheduler::StepScheduler(double stepsPerSecond)
+    : m_stepsPerSecond(stepsPerSecond), m_unbounded(false), m_pendingSteps(0.0), m_frameBudget(sf::milliseconds(10)) {
+    setStepsPerSecond(stepsPerSecond);
+}
+
+void StepScheduler::setStepsPerSecond(double stepsPerSecond) {
+    m_stepsPerSecond = max(stepsPerSecond, MIN_STEPS_PER_SECOND);
+    m_pendingSteps = 0.0;
+}
+
+void StepScheduler::setUnbounded(bool unbounded) {
+    m_unbounded = unbounded;
+    m_pendingSteps = 0.0;
+}
+
+void StepScheduler::faster() {
+    if (m_unbounded) return;
+    for (size_t i = 0; i < PRESET_COUNT; ++i) {
+        if (SPEED_PRESETS[i] > m_stepsPerSecond * 1.0001) {
+            setStepsPerSecond(SPEED_PRESETS[i]);
+            return;
+        }
+    }
+    setUnbounded(true); // Past the fastest preset
+}
+
+void StepScheduler::slower() {
+    if (m_unbounded) {
+        setUnbounded(false);
+        setStepsPerSecond(SPEED_PRESETS[PRESET_COUNT - 1]);
+        return;
+    }
+    for (size_t i = PRESET_COUNT; i-- > 0;) {
+        if (SPEED_PRESETS[i] < m_stepsPerSecond * 0.9999) {
+            setStepsPerSecond(SPEED_PRESETS[i]);
+            return;
+        }
+    }
+}
+
+void StepScheduler::handleEvent(const sf::Event& event) {
+    if (event.type != sf::Event::KeyPressed) return;
+    switch (event.key.code) {
+        case sf::Keyboard::Add:
+        case sf::Keyboard::Equal:    faster(); break;
+        case sf::Keyboard::Subtract:
+        case sf::Keyboard::Hyphen:   slower(); break;
+        case sf::Keyboard::F:        setUnbounded(!m_unbounded); break;
+        default: break;
+    }
+}
+
+string StepScheduler::getSpeedLabel() const {
+    if (m_unbounded) return "max";
+    ostringstream label;
+    if (m_stepsPerSecond < 1.0) label << fixed << setprecision(1) << m_stepsPerSecond;
+    else label << static_cast<long long>(round(m_stepsPerSecond));
+    return label.str() + " steps/s";
+}
+
+size_t StepScheduler::run(const function<bool()>& step) {
+    float elapsed = min(m_frameClock.restart().asSeconds(), MAX_FRAME_SECONDS);
+
+    double allowed;
+    if (m_unbounded) {
+        allowed = numeric_limits<double>::infinity();
+    } else {
+        m_pendingSteps += m_stepsPerSecond * elapsed;
+        allowed = floor(m_pendingSteps);
+    }
+
+    sf::Clock budgetClock;
+    size_t executed = 0;
+    bool outOfTime = false;
+    while (executed < allowed) {
+        if (!step()) {
+            // Paused or finished: don't bank time for a burst on resume
+            m_pendingSteps = 0.0;
+            return executed;
+        }
+        ++executed;
+        // Reading the clock costs about as much as a cheap step, so sample it
+        if ((executed & 15) == 0 && budgetClock.getElapsedTime() >= m_frameBudget) {
+            outOfTime = true;
+            break;
+        }
+    }
+
+    if (!m_unbounded) {
+        m_pendingSteps -= executed;
+        // Steps that did not fit in the budget are dropped, not owed
+        if (outOfTime) m_pendingSteps = min(m_pendingSteps, 1.0);
+    }
+    return executed;
+}
@@ -0,0 +1,98 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+namespace {
+thread_local unsigned t_workerIndex = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount) : m_stopping(false) {
+    for (unsigned t = 1; t < max(1u, threadCount); ++t) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, t);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (thread& worker : m_threads) worker.join();
+}
+
+ThreadPool& ThreadPool::getInstance() {
+    static ThreadPool instance(max(1u, thread::hardware_concurrency()));
+    return instance;
+}
+
+unsigned ThreadPool::getWorkerIndex() {
+    return t_workerIndex;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    t_workerIndex = index;
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty()) return; // Stopping with nothing left to do
+            task = move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_tasks.push_back(move(task));
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const function<void(size_t, size_t)>& body, unsigned maxThreads) {
+    if (count == 0) return;
+    grain = max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    unsigned threads = maxThreads ? min(maxThreads, getThreadCount()) : getThreadCount();
+    if (chunks == 1 || threads == 1) {
+        for (size_t begin = 0; begin < count; begin += grain) body(begin, min(count, begin + grain));
+        return;
+    }
+
+    // Shared with helpers that may only start after the loop has finished
+    struct Job {
+        atomic<size_t> nextChunk{0};
+        atomic<size_t> doneChunks{0};
+        mutex doneMutex;
+        condition_variable finished;
+    };
+    auto job = make_shared<Job>();
+
+    // Claims chunks until none are left. `body` is only touched while a chunk
+    // is outstanding, i.e. before parallelFor returns.
+    auto work = [job, chunks, count, grain, &body] {
+        size_t chunk;
+        while ((chunk = job->nextChunk.fetch_add(1)) < chunks) {
+            size_t begin = chunk * grain;
+            body(begin, min(count, begin + grain));
+            if (job->doneChunks.fetch_add(1) + 1 == chunks) {
+                lock_guard<mutex> lock(job->doneMutex);
+                job->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = min<size_t>(threads - 1, chunks - 1);
+    for (size_t h = 0; h < helpers; ++h) submit(work);
+    work();
+
+    unique_lock<mutex> lock(job->doneMutex);
+    job->finished.wait(lock, [&] { return job->doneChunks.load() == chunks; });
+}
@@ -1,148 +1,218 @@
 #include "TopoSortVisualizer.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
 
 using namespace std;
 
-TopoSortVisualizer::TopoSortVisualizer(sf::RenderWindow& window, AlgoType type)
-    : Visualizer(window), m_algoType(type), m_isVisualizing(false), m_isDone(false) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) {
-        cerr << "Error loading font in TopoSortVisualizer" << endl;
-    }
+TopoSortVisualizer::TopoSortVisualizer(sf::RenderWindow* window, AlgoType type)
+    : Visualizer(window), m_algoType(type), m_withCycle(false), m_threads(ThreadPool::getInstance().getThreadCount()),
+      m_engineMs(0.0), m_isVisualizing(false), m_isDone(false) {
+    m_scheduler.setStepsPerSecond(1.0 / 0.8); // One step every 0.8s by default
+    m_mode = (type == AlgoType::DFS_BASED) ? TopoMode::DepthFirst : TopoMode::Kahn;
     m_algoName = (type == AlgoType::DFS_BASED) ? "Topo Sort (DFS)" : "Topo Sort (Kahn's)";
 }
 
+// Edges are dependencies, from -> to, also for graph files marked undirected
 void TopoSortVisualizer::buildGraph() {
-    m_adjList.clear();
-    m_edges.clear();
+    m_renderer.clear();
+    if (const GraphFile* file = getWorkloadGraph()) {
+        m_renderer.addGraph(file->nodeCount, file->edges, getGraphArea(), false, sf::Color(100, 100, 250));
+        m_graph = Graph(file->nodeCount, file->edges, true);
+        return;
+    }
     map<int, sf::Vector2f> positions = {
         {0, {200, 150}}, {1, {200, 350}}, {2, {400, 250}},
         {3, {600, 150}}, {4, {600, 350}}, {5, {800, 250}}
     };
     for(const auto& p : positions) {
-        Node node;
-        node.shape.setRadius(30.f);
-        node.shape.setOrigin(30.f, 30.f);
-        node.shape.setPosition(p.second);
-        node.label.setFont(m_font);
-        node.label.setString(to_string(p.first));
-        node.label.setCharacterSize(24);
-        sf::FloatRect textRect = node.label.getLocalBounds();
-        node.label.setOrigin(textRect.left + textRect.width/2.0f, textRect.top + textRect.height/2.0f);
-        node.label.setPosition(p.second);
-        m_adjList[p.first] = node;
+        m_renderer.addNode(p.second, sf::Color(100, 100, 250));
+        m_renderer.addLabel(p.second, to_string(p.first), 24);
     }
+    vector<GraphEdge> edges;
     auto addEdge = [&](int u, int v) {
-        m_adjList[u].adj.push_back(v);
-        sf::VertexArray line(sf::Lines, 2);
-        line[0] = {m_adjList[u].shape.getPosition(), sf::Color::White};
-        line[1] = {m_adjList[v].shape.getPosition(), sf::Color::White};
-        m_edges.push_back(line);
+        edges.push_back({u, v, 1});
+        m_renderer.addEdge(u, v);
     };
     addEdge(0, 2); addEdge(1, 2); addEdge(2, 3);
     addEdge(2, 4); addEdge(3, 5); addEdge(4, 5);
+    if (m_withCycle) addEdge(5, 2); // 2 -> 3 -> 5 -> 2
+    m_graph = Graph(positions.size(), edges, true);
 }
 
-void TopoSortVisualizer::resetNodeStates() {
-    for (auto& pair : m_adjList) pair.second.state = Node::State::Unvisited;
+void TopoSortVisualizer::runEngine() {
+    TopologicalSort sort(m_graph);
+    sort.setThreads(m_threads);
+    auto startTime = chrono::steady_clock::now();
+    sort.run(m_mode);
+    m_engineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+    m_engineStats = sort.getStats();
+    cout << m_algoName << " (" << m_threads << " threads): " << m_engineMs << " ms, " << m_engineStats.sorted << " of "
+         << m_graph.getNodeCount() << " nodes sorted";
+    if (m_mode == TopoMode::Kahn) cout << ", " << m_engineStats.waves << " waves (widest " << m_engineStats.widestWave << ")";
+    else cout << ", deepest stack " << m_engineStats.deepestStack;
+    if (!m_engineStats.acyclic) cout << ", cycle of " << sort.getCycle().size() << " nodes";
+    cout << "." << endl;
 }
 
 void TopoSortVisualizer::reset() {
     buildGraph();
-    resetNodeStates();
-    m_sortedResult.clear();
+    runEngine();
+    m_sort = make_unique<TopologicalSort>(m_graph);
+    m_sort->setThreads(m_threads);
+    m_sort->start(m_mode);
+    if (m_mode == TopoMode::Kahn && m_sort->getWaveCount() > 0) paintWave(0, sf::Color::Yellow);
+    if (m_sort->isFinished()) paintCycle();
     m_isVisualizing = false;
     m_isDone = false;
-
-    if (m_algoType == AlgoType::DFS_BASED) {
-        while(!m_dfsStack.empty()) m_dfsStack.pop();
-    } else { // Kahn's
-        m_inDegree.assign(m_adjList.size(), 0);
-        for(const auto& pair : m_adjList) {
-            for(int neighbor : pair.second.adj) m_inDegree[neighbor]++;
-        }
-        while(!m_kahnQueue.empty()) m_kahnQueue.pop();
-        for(size_t i = 0; i < m_adjList.size(); ++i) {
-            if (m_inDegree[i] == 0) m_kahnQueue.push(i);
-        }
-    }
     cout << m_algoName << " reset. Press SPACE to start." << endl;
 }
 
-void TopoSortVisualizer::dfs(int u) {
-    m_adjList[u].state = Node::State::Visiting;
-    for (int v : m_adjList[u].adj) {
-        if (m_adjList[v].state == Node::State::Unvisited) dfs(v);
-    }
-    m_adjList[u].state = Node::State::Visited;
-    m_dfsStack.push(u);
+void TopoSortVisualizer::start() {
+    if (!m_isDone) m_isVisualizing = true;
 }
 
 void TopoSortVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isDone) m_isVisualizing = !m_isVisualizing;
         if (event.key.code == sf::Keyboard::R) reset();
+        if (event.key.code == sf::Keyboard::C && !getWorkloadGraph()) {
+            m_withCycle = !m_withCycle;
+            reset();
+        }
+        if (event.key.code == sf::Keyboard::T) {
+            m_threads = m_threads * 2 <= ThreadPool::getInstance().getThreadCount() ? m_threads * 2 : 1;
+            reset();
+        }
     }
 }
 
-void TopoSortVisualizer::update() {
-    if (!m_isVisualizing || m_isDone || m_clock.getElapsedTime().asSeconds() < m_delay) return;
-    m_clock.restart();
+void TopoSortVisualizer::paintWave(size_t wave, sf::Color color) {
+    const vector<int>& order = m_sort->getOrder();
+    for (size_t i = m_sort->getWaveStart(wave); i < m_sort->getWaveStart(wave + 1); ++i) m_renderer.setNodeColor(order[i], color);
+}
 
-    if (m_algoType == AlgoType::DFS_BASED) {
-        if (m_sortedResult.size() == m_adjList.size()) {
-            m_isDone = true; m_isVisualizing = false; return;
-        }
-        // Run full DFS at once, then pop from stack for visualization
-        if (m_dfsStack.empty()) {
-            for(size_t i = 0; i < m_adjList.size(); ++i) {
-                if (m_adjList[i].state == Node::State::Unvisited) dfs(i);
-            }
-        }
-        int u = m_dfsStack.top();
-        m_dfsStack.pop();
-        m_sortedResult.push_back(u);
-    } else { // Kahn's
-        if (m_kahnQueue.empty()) {
-            m_isDone = true; m_isVisualizing = false; return;
-        }
-        int u = m_kahnQueue.front();
-        m_kahnQueue.pop();
-        m_sortedResult.push_back(u);
-        m_adjList[u].state = Node::State::Visited;
-        for (int v : m_adjList[u].adj) {
-            m_inDegree[v]--;
-            if (m_inDegree[v] == 0) m_kahnQueue.push(v);
+// Repaints only what the last step changed
+void TopoSortVisualizer::paintStep(size_t sortedBefore) {
+    if (m_mode == TopoMode::Kahn) {
+        static const sf::Color palette[] = {
+            {120, 220, 120}, {60, 170, 90}, {150, 230, 180}, {90, 200, 150}
+        };
+        size_t waves = m_sort->getWaveCount();
+        size_t expanded = m_sort->isFinished() ? waves - 1 : waves - 2;
+        paintWave(expanded, palette[expanded % size(palette)]);
+        if (!m_sort->isFinished()) paintWave(waves - 1, sf::Color::Yellow);
+        return;
+    }
+    const vector<int>& order = m_sort->getOrder();
+    if (order.size() > sortedBefore) {
+        // The order is reversed once the last node finishes
+        bool complete = m_sort->isFinished() && m_sort->getStats().acyclic;
+        m_renderer.setNodeColor(complete ? order.front() : order.back(), sf::Color::Green);
+    } else if (m_sort->getStackTop() >= 0) {
+        m_renderer.setNodeColor(m_sort->getStackTop(), sf::Color::Yellow);
+    }
+}
+
+void TopoSortVisualizer::paintCycle() {
+    const vector<int>& cycle = m_sort->getCycle();
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        int from = cycle[i], to = cycle[(i + 1) % cycle.size()];
+        m_renderer.setNodeColor(from, sf::Color::Red);
+        m_renderer.setEdgeColor(m_graph.findEdgeId(from, to), sf::Color::Red);
+    }
+}
+
+bool TopoSortVisualizer::step() {
+    if (!m_isVisualizing || m_isDone) return false;
+
+    size_t sortedBefore = m_sort->getOrder().size();
+    if (!m_sort->step()) {
+        m_isDone = true; m_isVisualizing = false; return true;
+    }
+    paintStep(sortedBefore);
+    if (m_sort->isFinished()) {
+        paintCycle();
+        m_isDone = true; m_isVisualizing = false;
+    }
+    return true;
+}
+
+// Kahn's order with a bar between waves; the DFS order grows from the back
+string TopoSortVisualizer::getOrderText() const {
+    const vector<int>& order = m_sort->getOrder();
+    ostringstream text;
+    if (!m_sort->getCycle().empty()) {
+        text << "Cycle: ";
+        for (int node : m_sort->getCycle()) text << node << " -> ";
+        text << m_sort->getCycle().front();
+        return text.str();
+    }
+    text << "Sorted Order: ";
+    if (m_graph.getNodeCount() > MAX_LISTED_NODES) {
+        text << order.size() << " of " << m_graph.getNodeCount() << " nodes";
+    } else if (m_mode == TopoMode::Kahn) {
+        size_t expanded = m_sort->isFinished() ? m_sort->getWaveCount() : m_sort->getWaveCount() - 1;
+        for (size_t wave = 0; wave < expanded; ++wave) {
+            if (wave > 0) text << "| ";
+            for (size_t i = m_sort->getWaveStart(wave); i < m_sort->getWaveStart(wave + 1); ++i) text << order[i] << " ";
         }
+    } else if (m_sort->isFinished()) {
+        for (int node : order) text << node << " ";
+    } else {
+        text << "... ";
+        for (auto it = order.rbegin(); it != order.rend(); ++it) text << *it << " ";
     }
+    return text.str();
 }
 
 void TopoSortVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
-    for (const auto& edge : m_edges) m_window.draw(edge);
-    for (auto& pair : m_adjList) {
-        if (pair.second.state == Node::State::Visited) pair.second.shape.setFillColor(sf::Color::Green);
-        else if (pair.second.state == Node::State::Visiting) pair.second.shape.setFillColor(sf::Color::Yellow);
-        else pair.second.shape.setFillColor(sf::Color(100, 100, 250));
-        m_window.draw(pair.second.shape);
-        m_window.draw(pair.second.label);
-    }
+    m_window->clear(sf::Color(30, 30, 30));
+    m_renderer.draw(*m_window, m_font);
     sf::Text infoText;
     infoText.setFont(m_font);
     infoText.setCharacterSize(20);
     infoText.setFillColor(sf::Color::White);
-    string status = m_isDone ? "Complete!" : (m_isVisualizing ? "Visualizing..." : "Paused.");
+    string status = m_isDone ? (m_sort->getCycle().empty() ? "Complete!" : "Not a DAG!") : (m_isVisualizing ? "Visualizing..." : "Paused.");
     infoText.setString(m_algoName + " | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
+
+    ostringstream progress;
+    if (m_mode == TopoMode::Kahn) {
+        size_t waves = m_sort->getWaveCount();
+        size_t ready = m_sort->isFinished() || waves == 0 ? 0 : m_sort->getWaveStart(waves) - m_sort->getWaveStart(waves - 1);
+        progress << "Wave " << (m_sort->isFinished() ? waves : waves - 1) << ": " << ready << " ready (yellow), "
+                 << m_sort->getStats().sorted << " expanded";
+    } else {
+        progress << "Stack depth " << m_sort->getStackDepth() << " (yellow), " << m_sort->getStats().sorted << " finished";
+    }
+    if (!getWorkloadGraph()) progress << " | C: " << (m_withCycle ? "remove" : "add") << " the 5 -> 2 arc";
+    sf::Text progressText(progress.str(), m_font, 18);
+    progressText.setFillColor(sf::Color(200, 200, 200));
+    progressText.setPosition(10, 38);
+    m_window->draw(progressText);
+
+    ostringstream run;
+    run << "T threads: " << m_threads << " | full run: " << fixed << setprecision(2) << m_engineMs << " ms, "
+        << m_engineStats.sorted << " sorted";
+    if (m_mode == TopoMode::Kahn) run << ", " << m_engineStats.waves << " waves (widest " << m_engineStats.widestWave << ")";
+    else run << ", deepest stack " << m_engineStats.deepestStack;
+    if (!m_engineStats.acyclic) run << ", cycle found";
+    sf::Text runText(run.str(), m_font, 18);
+    runText.setFillColor(sf::Color(200, 200, 200));
+    runText.setPosition(10, 62);
+    m_window->draw(runText);
 
     sf::Text resultText;
     resultText.setFont(m_font);
     resultText.setCharacterSize(24);
-    resultText.setFillColor(sf::Color::White);
-    string resultStr = "Sorted Order: ";
-    for(int node : m_sortedResult) resultStr += to_string(node) + " ";
-    resultText.setString(resultStr);
-    resultText.setPosition(10, m_window.getSize().y - 40);
-    m_window.draw(resultText);
+    resultText.setFillColor(m_sort->getCycle().empty() ? sf::Color::White : sf::Color::Red);
+    resultText.setString(getOrderText());
+    resultText.setPosition(10, getCanvasSize().y - 40);
+    m_window->draw(resultText);
 }
@@ -0,0 +1,200 @@
+#include "TopologicalSort.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+using namespace std;
+
+TopologicalSort::TopologicalSort(const Graph& graph)
+    : m_graph(graph), m_mode(TopoMode::DepthFirst), m_threads(0), m_nextRoot(0), m_finished(false) {
+    start(m_mode);
+}
+
+unsigned TopologicalSort::getThreads() const {
+    unsigned count = ThreadPool::getInstance().getThreadCount();
+    return m_threads ? min(m_threads, count) : count;
+}
+
+void TopologicalSort::start(TopoMode mode) {
+    int n = m_graph.getNodeCount();
+    m_mode = mode;
+    m_order.clear();
+    m_order.reserve(n);
+    m_cycle.clear();
+    m_stack.clear();
+    m_nextRoot = 0;
+    m_waveStarts.clear();
+    m_finished = false;
+    m_stats = TopoStats();
+    if (mode == TopoMode::DepthFirst) {
+        m_state.assign(n, TopoState::Unvisited);
+        m_finished = n == 0;
+        return;
+    }
+
+    m_inDegree.reset(new atomic<int>[n]);
+    for (int v = 0; v < n; ++v) m_inDegree[v].store(0, memory_order_relaxed);
+    unsigned threads = getThreads();
+    bool shared = threads > 1 && static_cast<size_t>(n) > NODES_GRAIN;
+    ThreadPool::getInstance().parallelFor(n, NODES_GRAIN, [&](size_t begin, size_t end) {
+        const Graph& graph = m_graph;
+        atomic<int>* inDegree = m_inDegree.get();
+        for (size_t arc = graph.arcBegin(static_cast<int>(begin)), arcEnd = graph.arcBegin(static_cast<int>(end)); arc < arcEnd; ++arc) {
+            atomic<int>& degree = inDegree[graph.getTarget(arc)];
+            if (shared) degree.fetch_add(1, memory_order_relaxed);
+            else degree.store(degree.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        }
+    }, threads);
+
+    for (int v = 0; v < n; ++v) {
+        if (m_inDegree[v].load(memory_order_relaxed) == 0) m_order.push_back(v);
+    }
+    m_waveStarts = { 0, m_order.size() };
+    m_finished = m_order.empty();
+    if (m_finished && n > 0) {
+        m_stats.acyclic = false;
+        findCycle();
+    }
+}
+
+bool TopologicalSort::step() {
+    if (m_finished) return false;
+    return m_mode == TopoMode::DepthFirst ? stepDepthFirst() : stepKahn();
+}
+
+bool TopologicalSort::run(TopoMode mode) {
+    start(mode);
+    while (step()) {}
+    return m_stats.acyclic;
+}
+
+void TopologicalSort::push(int node) {
+    m_state[node] = TopoState::Active;
+    m_stack.push_back({ node, m_graph.arcBegin(node) });
+    m_stats.deepestStack = max(m_stats.deepestStack, static_cast<int>(m_stack.size()));
+}
+
+bool TopologicalSort::stepDepthFirst() {
+    if (m_stack.empty()) {
+        while (m_state[m_nextRoot] != TopoState::Unvisited) ++m_nextRoot;
+        push(m_nextRoot);
+        return true;
+    }
+    // Finished targets are skipped in a loop over locals; the frame is
+    // written back only when the step ends there
+    Frame& top = m_stack.back();
+    const Graph& graph = m_graph;
+    for (size_t arc = top.arc, arcEnd = graph.arcEnd(top.node); arc < arcEnd; ++arc) {
+        int v = graph.getTarget(arc);
+        TopoState state = m_state[v];
+        if (state == TopoState::Done) continue;
+        top.arc = arc + 1;
+        if (state == TopoState::Unvisited) {
+            push(v);
+            return true;
+        }
+        collectCycle(v);
+        m_stats.acyclic = false;
+        m_finished = true;
+        return true;
+    }
+    m_state[top.node] = TopoState::Done;
+    m_order.push_back(top.node);
+    m_stack.pop_back();
+    m_stats.sorted++;
+
+    if (m_stack.empty()) {
+        int n = m_graph.getNodeCount();
+        while (m_nextRoot < n && m_state[m_nextRoot] != TopoState::Unvisited) ++m_nextRoot;
+        if (m_nextRoot == n) {
+            reverse(m_order.begin(), m_order.end());
+            m_finished = true;
+        }
+    }
+    return true;
+}
+
+bool TopologicalSort::stepKahn() {
+    size_t begin = m_waveStarts[m_waveStarts.size() - 2], end = m_waveStarts.back();
+    size_t chunks = (end - begin + WAVE_GRAIN - 1) / WAVE_GRAIN;
+    unsigned threads = getThreads();
+    bool shared = chunks > 1 && threads > 1;
+    if (m_partNodes.size() < chunks) m_partNodes.resize(chunks);
+    ThreadPool::getInstance().parallelFor(end - begin, WAVE_GRAIN, [&](size_t first, size_t last) {
+        vector<int>& nodes = m_partNodes[first / WAVE_GRAIN];
+        nodes.clear();
+        const Graph& graph = m_graph;
+        atomic<int>* inDegree = m_inDegree.get();
+        const int* wave = m_order.data() + begin;
+        for (size_t i = first; i < last; ++i) {
+            int u = wave[i];
+            for (size_t arc = graph.arcBegin(u), arcEnd = graph.arcEnd(u); arc < arcEnd; ++arc) {
+                int v = graph.getTarget(arc);
+                atomic<int>& degree = inDegree[v];
+                int left;
+                if (shared) {
+                    left = degree.fetch_sub(1, memory_order_relaxed) - 1;
+                } else {
+                    left = degree.load(memory_order_relaxed) - 1;
+                    degree.store(left, memory_order_relaxed);
+                }
+                if (left == 0) nodes.push_back(v); // Only the task that took v to zero gets here
+            }
+        }
+    }, threads);
+
+    m_stats.waves++;
+    m_stats.widestWave = max(m_stats.widestWave, static_cast<int>(end - begin));
+    m_stats.sorted += static_cast<int>(end - begin);
+    for (size_t c = 0; c < chunks; ++c) m_order.insert(m_order.end(), m_partNodes[c].begin(), m_partNodes[c].end());
+    if (m_order.size() > end) {
+        m_waveStarts.push_back(m_order.size());
+        return true;
+    }
+    m_finished = true;
+    if (m_order.size() < static_cast<size_t>(m_graph.getNodeCount())) {
+        m_stats.acyclic = false;
+        findCycle();
+    }
+    return true;
+}
+
+// The stack from `from` up is a path ending in an arc back to `from`
+void TopologicalSort::collectCycle(int from) {
+    size_t first = m_stack.size();
+    while (m_stack[first - 1].node != from) --first;
+    m_cycle.clear();
+    for (size_t i = first - 1; i < m_stack.size(); ++i) m_cycle.push_back(m_stack[i].node);
+}
+
+// Every node Kahn's left unsorted still waits on another unsorted node, so
+// a DFS restricted to them must run into a cycle
+void TopologicalSort::findCycle() {
+    int n = m_graph.getNodeCount();
+    vector<TopoState> marks(n);
+    for (int v = 0; v < n; ++v)
+        marks[v] = m_inDegree[v].load(memory_order_relaxed) > 0 ? TopoState::Unvisited : TopoState::Done;
+    m_stack.clear();
+    for (int root = 0; root < n; ++root) {
+        if (marks[root] != TopoState::Unvisited) continue;
+        marks[root] = TopoState::Active;
+        m_stack.push_back({ root, m_graph.arcBegin(root) });
+        while (!m_stack.empty()) {
+            Frame& top = m_stack.back();
+            if (top.arc == m_graph.arcEnd(top.node)) {
+                marks[top.node] = TopoState::Done;
+                m_stack.pop_back();
+                continue;
+            }
+            int v = m_graph.getTarget(top.arc++);
+            if (marks[v] == TopoState::Active) {
+                collectCycle(v);
+                m_stack.clear();
+                return;
+            }
+            if (marks[v] == TopoState::Unvisited) {
+                marks[v] = TopoState::Active;
+                m_stack.push_back({ v, m_graph.arcBegin(v) });
+            }
+        }
+    }
+}
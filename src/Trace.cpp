@@ -0,0 +1,402 @@
+#include "Trace.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+using namespace std;
+
+namespace {
+    // Keyframe spacing in events: a snapshot costs about as much as a few
+    // events per state entry, so scale with the state size within sane bounds
+    const uint64_t MIN_KEYFRAME_INTERVAL = 1024;
+    const uint64_t MAX_KEYFRAME_INTERVAL = 1 << 19;
+    const uint64_t EVENTS_PER_STATE_ENTRY = 2;
+
+    uint32_t zigzag(int32_t value) {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    int32_t unzigzag(uint32_t value) {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+    void putVarint(vector<uint8_t>& bytes, int32_t value) {
+        uint32_t v = zigzag(value);
+        while (v >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(v));
+    }
+
+    // Stops at `end` so that a truncated chunk cannot read past its bounds
+    int32_t getVarint(const uint8_t*& p, const uint8_t* end) {
+        uint32_t v = 0;
+        int shift = 0;
+        while (p < end && (*p & 0x80) && shift < 28) {
+            v |= static_cast<uint32_t>(*p++ & 0x7F) << shift;
+            shift += 7;
+        }
+        if (p < end) v |= static_cast<uint32_t>(*p++) << shift;
+        return unzigzag(v);
+    }
+
+    // On-disk layout. Sections follow the header in this order, each starting
+    // at the offset recorded here; all integers are in the writer's byte order.
+    struct TraceFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrderMark;
+        uint64_t valueCount;
+        uint64_t stateCount;
+        uint64_t eventCount;
+        uint64_t keyframeCount;
+        uint64_t keyframeOffset;
+        uint64_t snapshotOffset;
+        uint64_t eventOffset;
+        uint64_t eventBytes;
+        char label[64];
+    };
+
+    const char TRACE_MAGIC[8] = {'A', 'L', 'G', 'O', 'T', 'R', 'C', '\0'};
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    const uint64_t PAGE_SIZE = 4096;
+
+    uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+}
+
+void applyTraceEvent(TraceState& state, TraceEvent& event, bool forward) {
+    switch (event.type) {
+        case TraceEvent::Type::Compare:
+            break; // Only highlights, the state is unchanged
+        case TraceEvent::Type::Swap:
+            std::swap(state.values[event.a], state.values[event.b]);
+            break;
+        case TraceEvent::Type::Write:
+            if (forward) { event.c = state.values[event.a]; state.values[event.a] = event.b; }
+            else state.values[event.a] = event.c;
+            break;
+        case TraceEvent::Type::NodeState:
+            if (forward) { event.c = state.states[event.a]; state.states[event.a] = event.b; }
+            else state.states[event.a] = event.c;
+            break;
+        case TraceEvent::Type::EdgeRelax:
+            if (forward) { event.d = state.values[event.b]; state.values[event.b] = event.c; }
+            else state.values[event.b] = event.d;
+            break;
+    }
+}
+
+// --- Trace ---
+
+Trace::Trace() : Trace(TraceState()) {}
+
+Trace::Trace(TraceState initialState)
+    : m_valueCount(initialState.values.size()), m_stateCount(initialState.states.size()),
+      m_eventCount(0), m_liveState(move(initialState)), m_lastIndex(0),
+      m_fileEvents(nullptr), m_fileKeyframes(nullptr), m_fileSnapshots(nullptr),
+      m_fileKeyframeCount(0), m_fileEventBytes(0) {
+    m_keyframeInterval = clamp<uint64_t>(EVENTS_PER_STATE_ENTRY * (m_valueCount + m_stateCount),
+                                         MIN_KEYFRAME_INTERVAL, MAX_KEYFRAME_INTERVAL);
+    addKeyframe();
+}
+
+void Trace::addKeyframe() {
+    m_keyframes.push_back({m_eventCount, m_bytes.size(), m_snapshots.size()});
+    m_snapshots.insert(m_snapshots.end(), m_liveState.values.begin(), m_liveState.values.end());
+    m_snapshots.insert(m_snapshots.end(), m_liveState.states.begin(), m_liveState.states.end());
+    m_lastIndex = 0; // Each block decodes on its own
+}
+
+void Trace::markKeyframe() {
+    if (m_file || m_keyframes.back().step == m_eventCount) return;
+    addKeyframe();
+}
+
+void Trace::append(TraceEvent event) {
+    if (m_file) return; // Loaded traces are read-only
+    if (m_eventCount - m_keyframes.back().step >= m_keyframeInterval) addKeyframe();
+
+    // Type byte, then the first operand relative to the previous event's and
+    // the second relative to the first (neighbouring indices are common)
+    m_bytes.push_back(static_cast<uint8_t>(event.type));
+    putVarint(m_bytes, event.a - m_lastIndex);
+    switch (event.type) {
+        case TraceEvent::Type::Compare:
+        case TraceEvent::Type::Swap:
+            putVarint(m_bytes, event.b - event.a);
+            break;
+        case TraceEvent::Type::Write:
+        case TraceEvent::Type::NodeState:
+            putVarint(m_bytes, event.b);
+            break;
+        case TraceEvent::Type::EdgeRelax:
+            putVarint(m_bytes, event.b - event.a);
+            putVarint(m_bytes, event.c);
+            break;
+    }
+    m_lastIndex = event.a;
+
+    applyTraceEvent(m_liveState, event, true);
+    ++m_eventCount;
+}
+
+size_t Trace::getMemoryBytes() const {
+    return eventBytes() + getKeyframeCount() * (sizeof(TraceKeyframe) + (m_valueCount + m_stateCount) * sizeof(int32_t));
+}
+
+size_t Trace::findKeyframe(size_t step) const {
+    const TraceKeyframe* begin = keyframeData();
+    const TraceKeyframe* end = begin + getKeyframeCount();
+    auto it = upper_bound(begin, end, static_cast<uint64_t>(step),
+                          [](uint64_t s, const TraceKeyframe& keyframe) { return s < keyframe.step; });
+    return static_cast<size_t>(it - begin) - 1;
+}
+
+void Trace::restoreKeyframe(size_t index, TraceState& state) const {
+    const int32_t* snapshot = snapshotData() + getKeyframe(index).snapshotOffset;
+    state.values.assign(snapshot, snapshot + m_valueCount);
+    state.states.assign(snapshot + m_valueCount, snapshot + m_valueCount + m_stateCount);
+}
+
+void Trace::decodeBlock(size_t index, vector<TraceEvent>& events) const {
+    bool last = index + 1 == getKeyframeCount();
+    const TraceKeyframe& keyframe = getKeyframe(index);
+    uint64_t count = (last ? m_eventCount : getKeyframe(index + 1).step) - keyframe.step;
+    events.resize(count);
+
+    const uint8_t* p = eventData() + keyframe.byteOffset;
+    const uint8_t* end = eventData() + (last ? eventBytes() : getKeyframe(index + 1).byteOffset);
+    int32_t lastIndex = 0;
+    for (TraceEvent& event : events) {
+        event = {static_cast<TraceEvent::Type>(p < end ? *p++ : 0), 0, 0, 0, 0};
+        event.a = lastIndex + getVarint(p, end);
+        int32_t limit = static_cast<int32_t>(m_valueCount);
+        switch (event.type) {
+            case TraceEvent::Type::Compare:
+            case TraceEvent::Type::Swap:
+                event.b = event.a + getVarint(p, end);
+                break;
+            case TraceEvent::Type::Write:
+                event.b = getVarint(p, end);
+                break;
+            case TraceEvent::Type::NodeState:
+                event.b = getVarint(p, end);
+                limit = static_cast<int32_t>(m_stateCount);
+                break;
+            case TraceEvent::Type::EdgeRelax:
+                event.b = event.a + getVarint(p, end);
+                event.c = getVarint(p, end);
+                break;
+            default:
+                limit = -1;
+                break;
+        }
+        lastIndex = event.a;
+
+        // A damaged file must not index outside the state: turn the event
+        // into a compare, which never modifies anything
+        bool usesB = event.type == TraceEvent::Type::Swap || event.type == TraceEvent::Type::EdgeRelax;
+        if (event.a < 0 || event.a >= limit || (usesB && (event.b < 0 || event.b >= limit))) {
+            event = {TraceEvent::Type::Compare, 0, 0, 0, 0};
+        }
+    }
+}
+
+bool Trace::saveToFile(const string& path) const {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        cerr << "Error opening '" << path << "' for writing" << endl;
+        return false;
+    }
+
+    TraceFileHeader header = {};
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.valueCount = m_valueCount;
+    header.stateCount = m_stateCount;
+    header.eventCount = m_eventCount;
+    header.keyframeCount = getKeyframeCount();
+    header.keyframeOffset = alignUp(sizeof(TraceFileHeader), 64);
+    header.snapshotOffset = alignUp(header.keyframeOffset + header.keyframeCount * sizeof(TraceKeyframe), 64);
+    uint64_t snapshotBytes = header.keyframeCount * (m_valueCount + m_stateCount) * sizeof(int32_t);
+    header.eventOffset = alignUp(header.snapshotOffset + snapshotBytes, PAGE_SIZE);
+    m_label.copy(header.label, sizeof(header.label) - 1);
+
+    // Each keyframe's chunk of events starts on a page of its own, so the
+    // player pages in only the chunks it visits; the index saved records
+    // the padded offsets, and decoding never reads into the padding
+    vector<TraceKeyframe> keyframes(keyframeData(), keyframeData() + header.keyframeCount);
+    vector<uint64_t> chunkBytes(header.keyframeCount);
+    uint64_t fileEventBytes = 0;
+    for (size_t k = 0; k < keyframes.size(); ++k) {
+        uint64_t end = k + 1 < keyframes.size() ? keyframes[k + 1].byteOffset : eventBytes();
+        chunkBytes[k] = end - keyframes[k].byteOffset;
+        fileEventBytes = alignUp(fileEventBytes, PAGE_SIZE);
+        keyframes[k].byteOffset = fileEventBytes;
+        fileEventBytes += chunkBytes[k];
+    }
+    header.eventBytes = fileEventBytes;
+
+    auto writeAt = [&](uint64_t offset, const void* data, uint64_t size) {
+        static const char padding[PAGE_SIZE] = {};
+        uint64_t position = static_cast<uint64_t>(out.tellp());
+        out.write(padding, static_cast<streamsize>(offset - position));
+        out.write(static_cast<const char*>(data), static_cast<streamsize>(size));
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeAt(header.keyframeOffset, keyframes.data(), header.keyframeCount * sizeof(TraceKeyframe));
+    writeAt(header.snapshotOffset, snapshotData(), snapshotBytes);
+    for (size_t k = 0; k < keyframes.size(); ++k) {
+        writeAt(header.eventOffset + keyframes[k].byteOffset, eventData() + getKeyframe(k).byteOffset, chunkBytes[k]);
+    }
+
+    if (!out) {
+        cerr << "Error writing trace to '" << path << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Trace::loadFromFile(const string& path) {
+    auto file = make_shared<MappedFile>();
+    if (!file->open(path)) return false;
+
+    auto fail = [&](const char* reason) {
+        cerr << "Error loading trace '" << path << "': " << reason << endl;
+        return false;
+    };
+    if (file->size() < sizeof(TraceFileHeader)) return fail("file too small");
+    TraceFileHeader header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) return fail("not a trace file");
+    if (header.byteOrderMark != BYTE_ORDER_MARK) return fail("written on a machine with a different byte order");
+    if (header.version != FILE_VERSION) return fail("unsupported version");
+
+    // Every section must lie inside the file
+    uint64_t size = file->size();
+    uint64_t stateSize = header.valueCount + header.stateCount;
+    bool valid = header.keyframeCount > 0 && header.valueCount <= INT32_MAX && header.stateCount <= INT32_MAX &&
+                 header.keyframeOffset % alignof(TraceKeyframe) == 0 && header.snapshotOffset % alignof(int32_t) == 0 &&
+                 header.keyframeOffset <= size && header.keyframeCount <= (size - header.keyframeOffset) / sizeof(TraceKeyframe) &&
+                 header.snapshotOffset <= size &&
+                 (stateSize == 0 || header.keyframeCount <= (size - header.snapshotOffset) / sizeof(int32_t) / stateSize) &&
+                 header.eventOffset <= size && header.eventBytes <= size - header.eventOffset;
+    if (!valid) return fail("truncated or corrupt header");
+
+    // The index is small; check it fully so playback can trust it
+    const TraceKeyframe* keyframes = reinterpret_cast<const TraceKeyframe*>(file->data() + header.keyframeOffset);
+    for (uint64_t k = 0; k < header.keyframeCount; ++k) {
+        const TraceKeyframe& keyframe = keyframes[k];
+        bool ordered = k == 0 ? keyframe.step == 0 && keyframe.byteOffset == 0
+                              : keyframe.step > keyframes[k - 1].step && keyframe.byteOffset >= keyframes[k - 1].byteOffset;
+        if (!ordered || keyframe.step > header.eventCount || keyframe.byteOffset > header.eventBytes ||
+            keyframe.snapshotOffset != k * stateSize) {
+            return fail("corrupt keyframe index");
+        }
+    }
+    // Every event takes at least its type byte, so no chunk may hold more
+    // events than bytes; this also bounds eventCount before decodeBlock
+    // sizes its buffer by it
+    for (uint64_t k = 0; k < header.keyframeCount; ++k) {
+        bool last = k + 1 == header.keyframeCount;
+        uint64_t events = (last ? header.eventCount : keyframes[k + 1].step) - keyframes[k].step;
+        uint64_t bytes = (last ? header.eventBytes : keyframes[k + 1].byteOffset) - keyframes[k].byteOffset;
+        if (events > bytes) return fail("more events than event bytes");
+    }
+
+    m_label = string(header.label, strnlen(header.label, sizeof(header.label)));
+    m_valueCount = header.valueCount;
+    m_stateCount = header.stateCount;
+    m_eventCount = header.eventCount;
+    m_fileKeyframes = keyframes;
+    m_fileSnapshots = reinterpret_cast<const int32_t*>(file->data() + header.snapshotOffset);
+    m_fileEvents = file->data() + header.eventOffset;
+    m_fileKeyframeCount = header.keyframeCount;
+    m_fileEventBytes = header.eventBytes;
+    m_file = move(file);
+
+    // Drop any recorded data; the mapped sections replace it
+    m_bytes = {};
+    m_keyframes = {};
+    m_snapshots = {};
+    m_liveState = {};
+    return true;
+}
+
+TraceState Trace::getInitialState() const {
+    TraceState state;
+    restoreKeyframe(0, state);
+    return state;
+}
+
+// --- TracePlayer ---
+
+TracePlayer::TracePlayer() : m_trace(nullptr), m_position(0), m_block(0), m_blockStart(0) {}
+
+void TracePlayer::load(const Trace& trace) {
+    m_trace = &trace;
+    loadBlock(0);
+}
+
+void TracePlayer::loadBlock(size_t keyframe) {
+    m_block = keyframe;
+    m_blockStart = m_trace->getKeyframe(keyframe).step;
+    m_trace->decodeBlock(keyframe, m_blockEvents);
+    m_trace->restoreKeyframe(keyframe, m_state);
+    m_position = m_blockStart;
+}
+
+// Invariant: the event before the current position (if any) lies in the
+// decoded block, so getLastEvent() and stepBackward() never need to decode.
+
+bool TracePlayer::stepForward() {
+    if (!m_trace || atEnd()) return false;
+    if (m_position == blockEnd()) loadBlock(m_block + 1); // Snapshot equals the current state
+    applyTraceEvent(m_state, m_blockEvents[m_position - m_blockStart], true);
+    ++m_position;
+    return true;
+}
+
+bool TracePlayer::stepBackward() {
+    if (!m_trace || m_position == 0) return false;
+    --m_position;
+    applyTraceEvent(m_state, m_blockEvents[m_position - m_blockStart], false);
+    if (m_position > 0 && m_position == m_blockStart) seek(m_position); // Move to the previous block
+    return true;
+}
+
+void TracePlayer::seek(size_t position) {
+    if (!m_trace) return;
+    position = min(position, getLength());
+    size_t block = position == 0 ? 0 : m_trace->findKeyframe(position - 1);
+
+    if (block != m_block || position == m_blockStart) {
+        loadBlock(block);
+    } else if (position < m_position) {
+        // Undo back to the target if that is closer than replaying the block
+        if (m_position - position <= position - m_blockStart) {
+            while (m_position > position) {
+                --m_position;
+                applyTraceEvent(m_state, m_blockEvents[m_position - m_blockStart], false);
+            }
+            return;
+        }
+        loadBlock(block);
+    }
+    while (m_position < position) {
+        applyTraceEvent(m_state, m_blockEvents[m_position - m_blockStart], true);
+        ++m_position;
+    }
+}
+
+const TraceEvent* TracePlayer::getLastEvent() const {
+    if (!m_trace || m_position == 0) return nullptr;
+    return &m_blockEvents[m_position - 1 - m_blockStart];
+}
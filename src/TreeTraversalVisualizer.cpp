@@ -4,11 +4,9 @@
 
 using namespace std;
 
-TreeTraversalVisualizer::TreeTraversalVisualizer(sf::RenderWindow& window, TraversalType type)
+TreeTraversalVisualizer::TreeTraversalVisualizer(sf::RenderWindow* window, TraversalType type)
     : Visualizer(window), m_traversalType(type), m_currentIndex(0), m_isVisualizing(false) {
-    if (!m_font.loadFromFile("assets/arial.ttf")) {
-        cerr << "Error loading font in TreeTraversalVisualizer" << endl;
-    }
+    m_scheduler.setStepsPerSecond(1.0 / 0.7); // One step every 0.7s by default
     switch(m_traversalType) {
         case TraversalType::IN_ORDER: m_traversalName = "In-Order"; break;
         case TraversalType::PRE_ORDER: m_traversalName = "Pre-Order"; break;
@@ -40,8 +38,7 @@ void TreeTraversalVisualizer::setNodePositions(TreeNode* node, int x, int y, int
     node->label.setString(to_string(node->value));
     node->label.setCharacterSize(20);
     node->label.setFillColor(sf::Color::White);
-    sf::FloatRect textRect = node->label.getLocalBounds();
-    node->label.setOrigin(textRect.left + textRect.width/2.0f, textRect.top + textRect.height/2.0f);
+    centerOrigin(node->label);
     node->label.setPosition(node->position);
     if (node->left) setNodePositions(node->left.get(), x - h_spacing, y + 100, h_spacing / 2);
     if (node->right) setNodePositions(node->right.get(), x + h_spacing, y + 100, h_spacing / 2);
@@ -60,7 +57,7 @@ void TreeTraversalVisualizer::reset() {
     for(int& i : data) ptr_data.push_back(&i);
 
     m_root = buildTree(ptr_data, 0, ptr_data.size() - 1);
-    setNodePositions(m_root.get(), m_window.getSize().x / 2, 100, m_window.getSize().x / 4);
+    setNodePositions(m_root.get(), getCanvasSize().x / 2, 100, getCanvasSize().x / 4);
     
     resetNodeStates(m_root.get());
     generateTraversalOrder();
@@ -70,6 +67,13 @@ void TreeTraversalVisualizer::reset() {
     cout << "Tree " << m_traversalName << " Visualizer reset. Press SPACE to start." << endl;
 }
 
+void TreeTraversalVisualizer::start() {
+    if (m_currentIndex >= m_traversalOrder.size()) { // If already finished, reset first
+        reset();
+    }
+    m_isVisualizing = true;
+}
+
 void TreeTraversalVisualizer::generateTraversalOrder() {
     m_traversalOrder.clear();
     switch (m_traversalType) {
@@ -117,11 +121,7 @@ void TreeTraversalVisualizer::generateBfs() {
 void TreeTraversalVisualizer::handleEvent(sf::Event& event) {
     if (event.type == sf::Event::KeyPressed) {
         if (event.key.code == sf::Keyboard::Space && !m_isVisualizing) {
-            if (m_currentIndex >= m_traversalOrder.size()) { // If already finished, reset first
-                reset();
-            }
-            m_isVisualizing = true;
-            m_clock.restart();
+            start();
         }
         if (event.key.code == sf::Keyboard::R) {
             reset();
@@ -129,35 +129,34 @@ void TreeTraversalVisualizer::handleEvent(sf::Event& event) {
     }
 }
 
-void TreeTraversalVisualizer::update() {
-    if (!m_isVisualizing || m_currentIndex >= m_traversalOrder.size() || m_clock.getElapsedTime().asSeconds() < m_delay) {
-        if (m_currentIndex >= m_traversalOrder.size() && m_isVisualizing) {
-            m_isVisualizing = false;
-            if (!m_traversalOrder.empty()) {
-                 m_traversalOrder.back()->state = TreeNode::State::Visited;
-            }
-            cout << m_traversalName << " traversal complete!" << endl;
+bool TreeTraversalVisualizer::step() {
+    if (!m_isVisualizing) return false;
+    if (m_currentIndex >= m_traversalOrder.size()) {
+        m_isVisualizing = false;
+        if (!m_traversalOrder.empty()) {
+             m_traversalOrder.back()->state = TreeNode::State::Visited;
         }
-        return;
+        cout << m_traversalName << " traversal complete!" << endl;
+        return false;
     }
-    m_clock.restart();
 
     if (m_currentIndex > 0) {
         m_traversalOrder[m_currentIndex - 1]->state = TreeNode::State::Visited;
     }
     m_traversalOrder[m_currentIndex]->state = TreeNode::State::Visiting;
     m_currentIndex++;
+    return true;
 }
 
 void TreeTraversalVisualizer::drawTree(TreeNode* node) {
     if (!node) return;
     if (node->left) {
         sf::Vertex line[] = { sf::Vertex(node->position), sf::Vertex(node->left->position) };
-        m_window.draw(line, 2, sf::Lines);
+        m_window->draw(line, 2, sf::Lines);
     }
     if (node->right) {
         sf::Vertex line[] = { sf::Vertex(node->position), sf::Vertex(node->right->position) };
-        m_window.draw(line, 2, sf::Lines);
+        m_window->draw(line, 2, sf::Lines);
     }
     drawTree(node->left.get());
     drawTree(node->right.get());
@@ -167,12 +166,12 @@ void TreeTraversalVisualizer::drawTree(TreeNode* node) {
         case TreeNode::State::Visiting:node->shape.setFillColor(sf::Color::Yellow); break;
         case TreeNode::State::Visited: node->shape.setFillColor(sf::Color::Green); break;
     }
-    m_window.draw(node->shape);
-    m_window.draw(node->label);
+    m_window->draw(node->shape);
+    m_window->draw(node->label);
 }
 
 void TreeTraversalVisualizer::draw() {
-    m_window.clear(sf::Color(30, 30, 30));
+    m_window->clear(sf::Color(30, 30, 30));
     if (m_root) drawTree(m_root.get());
 
     sf::Text infoText;
@@ -185,5 +184,5 @@ void TreeTraversalVisualizer::draw() {
 
     infoText.setString("Tree " + m_traversalName + " | " + status + " | 'R' to reset | ESC for menu");
     infoText.setPosition(10, 10);
-    m_window.draw(infoText);
+    m_window->draw(infoText);
 }
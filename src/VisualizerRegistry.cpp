@@ -0,0 +1,56 @@
+#include "VisualizerRegistry.h"
+#include "BubbleSortVisualizer.h"
+#include "InsertionSortVisualizer.h"
+#include "SelectionSortVisualizer.h"
+#include "QuickSortVisualizer.h"
+#include "MergeSortVisualizer.h"
+#include "HeapSortVisualizer.h"
+#include "SortTraceVisualizer.h"
+#include "TreeTraversalVisualizer.h"
+#include "GraphVisualizer.h"
+#include "TopoSortVisualizer.h"
+#include "DijkstraVisualizer.h"
+#include "DeltaSteppingVisualizer.h"
+#include "BellmanFordVisualizer.h"
+#include "KruskalVisualizer.h"
+#include "PrimsVisualizer.h"
+#include "BoruvkaVisualizer.h"
+#include "ConnectedComponentsVisualizer.h"
+#include "FloydWarshallVisualizer.h"
+
+using namespace std;
+
+vector<VisualizerEntry> createVisualizerRegistry() {
+    vector<VisualizerEntry> registry;
+
+    // --- Register your algorithms here ---
+    registry.push_back({"Sort: Bubble", [](sf::RenderWindow* win){ return make_unique<BubbleSortVisualizer>(win); }});
+    registry.push_back({"Sort: Selection", [](sf::RenderWindow* win){ return make_unique<SelectionSortVisualizer>(win); }});
+    registry.push_back({"Sort: Insertion", [](sf::RenderWindow* win){ return make_unique<InsertionSortVisualizer>(win); }});
+    registry.push_back({"Sort: Merge", [](sf::RenderWindow* win){ return make_unique<MergeSortVisualizer>(win); }});
+    registry.push_back({"Sort: Quick", [](sf::RenderWindow* win){ return make_unique<QuickSortVisualizer>(win); }});
+    registry.push_back({"Sort: Heap", [](sf::RenderWindow* win){ return make_unique<HeapSortVisualizer>(win); }});
+    registry.push_back({"Sort: Trace Player (all sorts)", [](sf::RenderWindow* win){ return make_unique<SortTraceVisualizer>(win); }});
+
+    registry.push_back({"BST: Interactive Operations", nullptr}); // Placeholder for BST
+
+    registry.push_back({"Tree: In-Order", [](sf::RenderWindow* win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::IN_ORDER); }});
+    registry.push_back({"Tree: Pre-Order", [](sf::RenderWindow* win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::PRE_ORDER); }});
+    registry.push_back({"Tree: Post-Order", [](sf::RenderWindow* win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::POST_ORDER); }});
+    registry.push_back({"Tree: BFS", [](sf::RenderWindow* win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::BFS); }});
+
+    registry.push_back({"Graph: DFS", [](sf::RenderWindow* win){ return make_unique<GraphVisualizer>(win, GraphVisualizer::TraversalType::DFS); }});
+    registry.push_back({"Graph: BFS", [](sf::RenderWindow* win){ return make_unique<GraphVisualizer>(win, GraphVisualizer::TraversalType::BFS); }});
+    registry.push_back({"Graph: Topo Sort (DFS)", [](sf::RenderWindow* win){ return make_unique<TopoSortVisualizer>(win, TopoSortVisualizer::AlgoType::DFS_BASED); }});
+    registry.push_back({"Graph: Topo Sort (Kahn's)", [](sf::RenderWindow* win){ return make_unique<TopoSortVisualizer>(win, TopoSortVisualizer::AlgoType::KAHN); }});
+    registry.push_back({"Graph: Connected Components", [](sf::RenderWindow* win){ return make_unique<ConnectedComponentsVisualizer>(win); }});
+    registry.push_back({"Path: Dijkstra's", [](sf::RenderWindow* win){ return make_unique<DijkstraVisualizer>(win); }});
+    registry.push_back({"Path: Delta-Stepping", [](sf::RenderWindow* win){ return make_unique<DeltaSteppingVisualizer>(win); }});
+    registry.push_back({"Path: Bellman-Ford", [](sf::RenderWindow* win){ return make_unique<BellmanFordVisualizer>(win); }});
+    registry.push_back({"Path: Floyd-Warshall", [](sf::RenderWindow* win){ return make_unique<FloydWarshallVisualizer>(win); }});
+    registry.push_back({"MST: Kruskal's", [](sf::RenderWindow* win){ return make_unique<KruskalVisualizer>(win); }});
+    registry.push_back({"MST: Prim's", [](sf::RenderWindow* win){ return make_unique<PrimsVisualizer>(win); }});
+    registry.push_back({"MST: Boruvka's", [](sf::RenderWindow* win){ return make_unique<BoruvkaVisualizer>(win); }});
+
+    return registry;
+}
@@ -1,4 +1,5 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <iostream>
@@ -9,20 +10,13 @@
 using namespace std;
 
 #include "Visualizer.h"
-#include "BubbleSortVisualizer.h"
-#include "InsertionSortVisualizer.h"
-#include "SelectionSortVisualizer.h"
-#include "QuickSortVisualizer.h"
-#include "MergeSortVisualizer.h"
-#include "HeapSortVisualizer.h"
-#include "TreeTraversalVisualizer.h"
-#include "GraphVisualizer.h"
-#include "TopoSortVisualizer.h"
-#include "DijkstraVisualizer.h"
-#include "BellmanFordVisualizer.h"
-#include "KruskalVisualizer.h"
-#include "PrimsVisualizer.h"
-#include "FloydWarshallVisualizer.h"
+#include "ResourceManager.h"
+#include "VisualizerRegistry.h"
+#include "HeadlessRunner.h"
+#include "Benchmark.h"
+#include "DataGenerator.h"
+#include "GraphLoader.h"
+#include "CommandLine.h"
 #include "BSTVisualizer.h"
 
 // --- UI Helper Structs ---
@@ -32,7 +26,7 @@ struct Textbox {
     string inputString;
     bool isSelected = false;
 
-    Textbox(sf::Font& font) {
+    Textbox(const sf::Font& font) {
         box.setSize({200, 50});
         box.setFillColor(sf::Color(80, 80, 80));
         box.setOutlineThickness(2);
@@ -69,7 +63,7 @@ struct Button {
     sf::RectangleShape shape;
     sf::Text text;
 
-    Button(const string& label, sf::Font& font, sf::Vector2f size, sf::Color bgColor) {
+    Button(const string& label, const sf::Font& font, sf::Vector2f size, sf::Color bgColor) {
         shape.setSize(size);
         shape.setFillColor(bgColor);
         text.setString(label);
@@ -102,8 +96,13 @@ const unsigned int WINDOW_WIDTH = 1280;
 const unsigned int WINDOW_HEIGHT = 720;
 const string WINDOW_TITLE = "Algorithm Visualizer";
 
+// Menu entries fill columns top to bottom, as many rows as fit under the title
+const float MENU_TOP = 140.f;
+const float MENU_ROW_HEIGHT = 45.f;
+const size_t MENU_ROWS = static_cast<size_t>((WINDOW_HEIGHT - MENU_TOP - 40.f) / MENU_ROW_HEIGHT);
+
 // --- Helper Function to display the menu ---
-void showMenu(sf::RenderWindow& window, const vector<string>& options, int selectedIndex, sf::Font& font) {
+void showMenu(sf::RenderWindow& window, const vector<string>& options, int selectedIndex, const sf::Font& font) {
     window.clear(sf::Color(20, 20, 40)); 
 
     sf::Text title("Select an Algorithm to Visualize:", font, 40);
@@ -112,15 +111,17 @@ void showMenu(sf::RenderWindow& window, const vector<string>& options, int selec
     title.setPosition(WINDOW_WIDTH / 2.0f - title.getGlobalBounds().width / 2.0f, 20);
     window.draw(title);
     
-    sf::Text instructions("Use UP/DOWN arrow keys. Press ENTER to select.", font, 20);
+    sf::Text instructions("Use the arrow keys. Press ENTER to select.", font, 20);
     instructions.setFillColor(sf::Color(150, 150, 150));
     instructions.setPosition(WINDOW_WIDTH / 2.0f - instructions.getGlobalBounds().width / 2.0f, 80);
     window.draw(instructions);
 
+    size_t columns = max<size_t>(1, (options.size() + MENU_ROWS - 1) / MENU_ROWS);
+    float columnWidth = (WINDOW_WIDTH - 100.f) / columns;
     for (size_t i = 0; i < options.size(); ++i) {
         sf::Text optionText(options[i], font, 22);
-        float xPos = (i < 10) ? 50.f : 700.f;
-        float yPos = (i < 10) ? 140.f + (i * 45.f) : 140.f + ((i-10) * 45.f);
+        float xPos = 50.f + (i / MENU_ROWS) * columnWidth;
+        float yPos = MENU_TOP + (i % MENU_ROWS) * MENU_ROW_HEIGHT;
         optionText.setPosition(xPos, yPos);
         if (i == (size_t)selectedIndex) {
             optionText.setFillColor(sf::Color::Yellow);
@@ -132,15 +133,51 @@ void showMenu(sf::RenderWindow& window, const vector<string>& options, int selec
     }
 }
 
-int main() {
+// --- Helper Function to display the step speed of the running visualizer ---
+void showSpeed(sf::RenderWindow& window, const StepScheduler& scheduler, const sf::Font& font) {
+    sf::Text speedText("Speed: " + scheduler.getSpeedLabel() + " | +/- to change, F for max", font, 18);
+    speedText.setFillColor(sf::Color(200, 200, 200));
+    speedText.setPosition(WINDOW_WIDTH - speedText.getGlobalBounds().width - 10, 12);
+    window.draw(speedText);
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> args(argv + 1, argv + argc);
+    vector<VisualizerEntry> registry = createVisualizerRegistry();
+
+    // Headless mode runs the algorithms without ever opening a window
+    if (!args.empty() && args[0] == "--headless") {
+        return runHeadless(registry, vector<string>(args.begin() + 1, args.end()));
+    }
+    if (!args.empty() && args[0] == "--bench") {
+        return runBenchmark(vector<string>(args.begin() + 1, args.end()));
+    }
+
+    // --seed <n> repeats the inputs of an earlier session; --graph <path>
+    // replaces the graph visualizers' built-in examples
+    for (size_t i = 0; i + 1 < args.size(); i += 2) {
+        if (args[i] == "--seed") {
+            unsigned long long seed = 0;
+            if (!parseOption(args[i], args[i + 1], seed)) return 1;
+            setWorkloadSeed(seed);
+        }
+        else if (args[i] == "--graph") {
+            if (!setWorkloadGraph(args[i + 1])) return 1;
+        }
+    }
+
     sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), WINDOW_TITLE);
     window.setFramerateLimit(60);
 
-    sf::Font font;
-    if (!font.loadFromFile("assets/arial.ttf")) {
+    ResourceManager& resources = ResourceManager::getInstance();
+    if (!resources.loadFont(ResourceManager::DEFAULT_FONT)) {
         cerr << "CRITICAL ERROR: Could not load font 'assets/arial.ttf'." << endl;
         return -1;
     }
+    const sf::Font& font = resources.getFont();
+    // Rasterize the HUD glyphs up front so the first frames don't stall on them
+    resources.prewarmGlyphs(font, {16, 18, 20, 22, 24, 40});
+    resources.prewarmGlyphs(font, {22, 40}, true);
 
     enum class AppState { MainMenu, BSTInput, Visualizing };
     AppState currentState = AppState::MainMenu;
@@ -157,53 +194,8 @@ int main() {
 
 
     unique_ptr<Visualizer> currentVisualizer = nullptr;
-    vector<function<unique_ptr<Visualizer>(sf::RenderWindow&)>> visualizerFactories;
     vector<string> visualizerNames;
-
-    // --- Register your algorithms here ---
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<BubbleSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Bubble");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<SelectionSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Selection");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<InsertionSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Insertion");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<MergeSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Merge");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<QuickSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Quick");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<HeapSortVisualizer>(win); });
-    visualizerNames.push_back("Sort: Heap");
-    
-    visualizerFactories.push_back(nullptr); // Placeholder for BST
-    visualizerNames.push_back("BST: Interactive Operations");
-
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::IN_ORDER); });
-    visualizerNames.push_back("Tree: In-Order");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::PRE_ORDER); });
-    visualizerNames.push_back("Tree: Pre-Order");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::POST_ORDER); });
-    visualizerNames.push_back("Tree: Post-Order");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TreeTraversalVisualizer>(win, TreeTraversalVisualizer::TraversalType::BFS); });
-    visualizerNames.push_back("Tree: BFS");
-    
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<GraphVisualizer>(win, GraphVisualizer::TraversalType::DFS); });
-    visualizerNames.push_back("Graph: DFS");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<GraphVisualizer>(win, GraphVisualizer::TraversalType::BFS); });
-    visualizerNames.push_back("Graph: BFS");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TopoSortVisualizer>(win, TopoSortVisualizer::AlgoType::DFS_BASED); });
-    visualizerNames.push_back("Graph: Topo Sort (DFS)");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<TopoSortVisualizer>(win, TopoSortVisualizer::AlgoType::KAHN); });
-    visualizerNames.push_back("Graph: Topo Sort (Kahn's)");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<DijkstraVisualizer>(win); });
-    visualizerNames.push_back("Path: Dijkstra's");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<BellmanFordVisualizer>(win); });
-    visualizerNames.push_back("Path: Bellman-Ford");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<FloydWarshallVisualizer>(win); });
-    visualizerNames.push_back("Path: Floyd-Warshall");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<KruskalVisualizer>(win); });
-    visualizerNames.push_back("MST: Kruskal's");
-    visualizerFactories.push_back([](sf::RenderWindow& win){ return make_unique<PrimsVisualizer>(win); });
-    visualizerNames.push_back("MST: Prim's");
+    for (const auto& entry : registry) visualizerNames.push_back(entry.name);
 
     int selectedAlgorithmIndex = 0;
 
@@ -213,7 +205,10 @@ int main() {
             if (event.type == sf::Event::Closed) window.close();
 
             if (currentState == AppState::Visualizing) {
-                if (currentVisualizer) currentVisualizer->handleEvent(event);
+                if (currentVisualizer) {
+                    currentVisualizer->getScheduler().handleEvent(event);
+                    currentVisualizer->handleEvent(event);
+                }
                 if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
                     currentState = AppState::MainMenu;
                     currentVisualizer = nullptr;
@@ -231,7 +226,7 @@ int main() {
                     auto startVisualization = [&](BSTVisualizer::Operation op) {
                         if (textbox.inputString.empty()) return;
                         int value = stoi(textbox.inputString);
-                        currentVisualizer = make_unique<BSTVisualizer>(window, op, value);
+                        currentVisualizer = make_unique<BSTVisualizer>(&window, op, value);
                         currentVisualizer->reset();
                         currentState = AppState::Visualizing;
                     };
@@ -250,11 +245,15 @@ int main() {
                         selectedAlgorithmIndex = (selectedAlgorithmIndex + 1) % visualizerNames.size();
                     } else if (event.key.code == sf::Keyboard::Up) {
                         selectedAlgorithmIndex = (selectedAlgorithmIndex - 1 + visualizerNames.size()) % visualizerNames.size();
+                    } else if (event.key.code == sf::Keyboard::Right) {
+                        if (selectedAlgorithmIndex + MENU_ROWS < visualizerNames.size()) selectedAlgorithmIndex += MENU_ROWS;
+                    } else if (event.key.code == sf::Keyboard::Left) {
+                        if (selectedAlgorithmIndex >= (int)MENU_ROWS) selectedAlgorithmIndex -= MENU_ROWS;
                     } else if (event.key.code == sf::Keyboard::Enter) {
-                        if (visualizerFactories[selectedAlgorithmIndex] == nullptr) { // It's the BST option
+                        if (!registry[selectedAlgorithmIndex].factory) { // It's the BST option
                             currentState = AppState::BSTInput;
                         } else {
-                            currentVisualizer = visualizerFactories[selectedAlgorithmIndex](window);
+                            currentVisualizer = registry[selectedAlgorithmIndex].factory(&window);
                             currentVisualizer->reset();
                             currentState = AppState::Visualizing;
                         }
@@ -271,6 +270,7 @@ int main() {
 
         if (currentState == AppState::Visualizing && currentVisualizer) {
             currentVisualizer->draw();
+            showSpeed(window, currentVisualizer->getScheduler(), font);
         } else if (currentState == AppState::BSTInput) {
             window.clear(sf::Color(20, 20, 40));
             sf::Text bstTitle("BST Operations", font, 40);